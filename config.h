@@ -8,6 +8,24 @@
 /******************************************************************/
 //#define PERF
 
+/******************************************************************/
+/*Show each scanline as soon as the emulator has drawn it rather than a frame later*/
+/******************************************************************/
+//#define LINE_QUEUE
+
+/******************************************************************/
+/*Skip rendering (up to this many frames in a row) to keep up when frames run long*/
+/******************************************************************/
+#define FRAMESKIP 4
+
+/******************************************************************/
+/*Rewind history budget in KB, hold F10 to step back through it (0 is off)*/
+/*400 gives NES/SMS about 10 seconds, Atari states are ~156k so it wants PSRAM and a few MB*/
+/******************************************************************/
+#ifndef REWIND_KB
+#define REWIND_KB 0
+#endif
+
 /******************************************************************/
 /*Choose one of the video standards: PAL or NTSC*/
 /******************************************************************/
@@ -55,8 +55,39 @@ Emu* NewEmulator()
 Emu* _emu = 0;            // emulator running on core 0
 uint32_t _frame_time = 0;
 uint32_t _drawn = 1;
+uint32_t _skipped = 0;
 bool _inited = false;
 
+// Adaptive frameskip: _late is how far emulation has fallen behind the display
+// (cycles at 240MHz). Frames run long pay it back by skipping rendering on the next
+// ones, audio and input still get every frame so the game runs at full speed.
+int32_t _late = 0;
+uint32_t _frame_start = 0;
+
+bool frameskip()
+{
+#ifdef FRAMESKIP
+    int32_t budget = _emu->standard ? 4004000 : 4800000;  // 59.94 / 50Hz
+    static int _run = 0;
+
+    uint32_t t = xthal_get_ccount();
+    if (_frame_start)
+        _late += (int32_t)(t - _frame_start) - budget;
+    _frame_start = t;
+    if (_late < 0)
+        _late = 0;
+    if (_late > 4*budget)       // a long stall (file load etc), don't sprint to catch up
+        _late = 4*budget;
+
+    if (_late > budget/2 && _run < FRAMESKIP) {
+        _run++;
+        return true;
+    }
+    _run = 0;
+#endif
+    return false;
+}
+
 void emu_init()
 {
     std::string folder = "/" + _emu->name;
@@ -66,15 +97,28 @@ void emu_init()
 
 void emu_loop()
 {
-    // wait for blanking before drawing to avoid tearing
-    video_sync();
+    if (frameskip()) {
+        gui_update(false);                  // behind, run the frame without drawing it
+        _skipped++;
+        #ifdef PERF
+        prof_frame();                       // skipped frames are the slow ones, keep them in the ring
+        #endif
+        return;
+    }
+
+    // wait for the last frame to flip to the front before drawing the next
+    PROF_ZONE(PROF_IDLE,video_sync());
+    _frame_start = xthal_get_ccount();      // waiting for the display isn't running late
 
     // Draw a frame, update sound, process hid events
     uint32_t t = xthal_get_ccount();
     gui_update();
     _frame_time = xthal_get_ccount() - t;
-    _lines = _emu->video_buffer();
+    video_present(_emu->video_buffer());    // flips at vblank
     _drawn++;
+    #ifdef PERF
+    prof_frame();
+    #endif
 }
 
 // dual core mode runs emulator on comms core
@@ -160,15 +204,9 @@ void perf()
 {
   static int _next = 0;
   if (_drawn >= _next) {
-    float elapsed_us = 120*1000000/(_emu->standard ? 60 : 50);
     _next = _drawn + 120;
-    
-    printf("frame_time:%d drawn:%d displayed:%d blit_ticks:%d->%d, isr time:%2.2f%%\n",
-      _frame_time/240,_drawn,_frame_counter,_blit_ticks_min,_blit_ticks_max,(_isr_us*100)/elapsed_us);
-      
-    _blit_ticks_min = 0xFFFFFFFF;
-    _blit_ticks_max = 0;
-    _isr_us = 0;
+    printf("frame_time:%d drawn:%d skipped:%d displayed:%d\n",_frame_time/240,_drawn,_skipped,_frame_counter);
+    prof_print();
   }
 }
 #else
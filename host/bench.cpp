@@ -0,0 +1,95 @@
+/* Copyright (c) 2020, Peter Barrett
+**
+** Permission to use, copy, modify, and/or distribute this software for
+** any purpose with or without fee is hereby granted, provided that the
+** above copyright notice and this permission notice appear in all copies.
+**
+** THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+** WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+** WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR
+** BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES
+** OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+** WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+** ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+** SOFTWARE.
+*/
+
+#include <algorithm>
+#include "../src/emu.h"
+#include "host.h"
+
+// esp_8_bit_bench
+// Boots every title in data/atari800, data/nofrendo and data/smsplus, runs N frames of
+// Emu::update() + audio_buffer() and reports the distribution of host cycles per frame
+// so numbers can be compared between builds.
+//
+//    esp_8_bit_bench [frames] [data folder]
+
+using namespace std;
+
+static void titles(Emu* emu, const string& path, vector<string>& files)
+{
+    DIR* dirp = opendir(path.c_str());
+    if (!dirp)
+        return;
+    struct dirent* dp;
+    while ((dp = readdir(dirp)) != NULL) {
+        string ext = get_ext(dp->d_name);
+        for (int i = 0; emu->_ext[i]; i++)
+            if (ext == emu->_ext[i])
+                files.push_back(path + "/" + dp->d_name);
+    }
+    closedir(dirp);
+    sort(files.begin(),files.end());
+}
+
+static uint32_t percentile(const vector<uint32_t>& s, int p)
+{
+    return s[(s.size()-1)*p/100];
+}
+
+int main(int argc, char* argv[])
+{
+    int frames = argc > 1 ? atoi(argv[1]) : 600;
+    string data = argc > 2 ? argv[2] : "data";
+    if (frames <= 0) {
+        printf("usage: %s [frames] [data folder]\n",argv[0]);
+        return 1;
+    }
+
+    // cores are chatty, collect the table and print it at the end
+    const char* emus[] = {"atari800","nofrendo","smsplus",0};
+    vector<string> rows;
+    char buf[256];
+    for (int e = 0; emus[e]; e++) {
+        Emu* emu = NewEmulator(emus[e]);
+        vector<string> files;
+        titles(emu,data + "/" + emu->name,files);
+        for (auto& f : files) {
+            if (emu->insert(f,1,0) != 0) {
+                printf("%s failed to insert %s\n",emu->name.c_str(),f.c_str());
+                continue;
+            }
+            host_init(emu);
+
+            vector<uint32_t> ticks(frames);
+            vector<uint32_t> video(frames);
+            for (int i = 0; i < frames; i++)
+                host_frame(emu,&ticks[i],&video[i]);
+            sort(ticks.begin(),ticks.end());
+            sort(video.begin(),video.end());
+
+            string name = f.substr(f.find_last_of("/") + 1);
+            sprintf(buf,"%-9s %-24s %9u %9u %9u %9u %9u",emu->name.c_str(),name.c_str(),
+                ticks[0],percentile(ticks,50),percentile(ticks,99),ticks[frames-1],percentile(video,50));
+            rows.push_back(buf);
+        }
+        delete emu;
+    }
+
+    printf("\n%d frames per title, host cycles per frame\n",frames);
+    printf("%-9s %-24s %9s %9s %9s %9s %9s\n","emu","title","min","median","p99","max","video");
+    for (auto& r : rows)
+        printf("%s\n",r.c_str());
+    return 0;
+}
@@ -0,0 +1,91 @@
+/* Copyright (c) 2020, Peter Barrett
+**
+** Permission to use, copy, modify, and/or distribute this software for
+** any purpose with or without fee is hereby granted, provided that the
+** above copyright notice and this permission notice appear in all copies.
+**
+** THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+** WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+** WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR
+** BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES
+** OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+** WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+** ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+** SOFTWARE.
+*/
+#include <algorithm>
+#include "../src/emu.h"
+#include "host.h"
+
+// esp_8_bit_blit_bench
+// Host cycles per line of the NTSC blit() for each machine, per pixel palette lookups vs
+// the precomputed expansion tables. Lines are random pixels, both paths must produce
+// identical DMA lines.
+//
+//    esp_8_bit_blit_bench [lines]
+
+using namespace std;
+
+// video_out.h, compiled into host.cpp
+void blit(uint8_t* src, uint16_t* dst);
+extern bool _expand_on;
+extern int _line_width;
+extern uint16_t* _dma_line;
+
+static uint32_t median_ticks(uint8_t* src, int lines)
+{
+    vector<uint32_t> t(lines);
+    for (int i = 0; i < lines; i++) {
+        uint32_t t0 = cpu_ticks();
+        blit(src,_dma_line);
+        t[i] = cpu_ticks() - t0;
+    }
+    sort(t.begin(),t.end());
+    return t[lines/2];
+}
+
+int main(int argc, char* argv[])
+{
+    int lines = argc > 1 ? atoi(argv[1]) : 100000;
+    if (lines <= 0) {
+        printf("usage: %s [lines]\n",argv[0]);
+        return 1;
+    }
+
+    const char* emus[] = {"atari800","nofrendo","smsplus",0};
+    vector<string> rows;
+    bool all_same = true;
+    char buf[256];
+    uint32_t src32[384/4];
+    uint8_t* src = (uint8_t*)src32;
+    for (int i = 0; i < 384; i++)
+        src[i] = rand();
+
+    for (int e = 0; emus[e]; e++) {
+        Emu* emu = NewEmulator(emus[e]);
+        host_init(emu);
+        bool tables = _expand_on;
+
+        _expand_on = false;
+        uint32_t lookup = median_ticks(src,lines);
+        vector<uint16_t> ref(_dma_line,_dma_line + _line_width);
+
+        _expand_on = tables;
+        uint32_t expand = median_ticks(src,lines);
+        bool same = equal(ref.begin(),ref.end(),_dma_line);
+        all_same &= same;
+
+        if (tables)
+            sprintf(buf,"%-9s %9u %9u %8.2fx %s",emu->name.c_str(),lookup,expand,(float)lookup/expand,same ? "" : "MISMATCH");
+        else
+            sprintf(buf,"%-9s %9u %9s",emu->name.c_str(),lookup,"-");
+        rows.push_back(buf);
+        delete emu;
+    }
+
+    printf("\nmedian host cycles per line over %d lines\n",lines);
+    printf("%-9s %9s %9s %9s\n","emu","lookup","tables","speedup");
+    for (auto& r : rows)
+        printf("%s\n",r.c_str());
+    return all_same ? 0 : 1;
+}
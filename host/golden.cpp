@@ -0,0 +1,206 @@
+/* Copyright (c) 2020, Peter Barrett
+**
+** Permission to use, copy, modify, and/or distribute this software for
+** any purpose with or without fee is hereby granted, provided that the
+** above copyright notice and this permission notice appear in all copies.
+**
+** THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+** WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+** WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR
+** BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES
+** OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+** WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+** ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+** SOFTWARE.
+*/
+
+#include <algorithm>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "../src/emu.h"
+#include "host.h"
+
+extern "C" {
+#include "../src/atari800/crc32.h"
+}
+
+// esp_8_bit_golden
+// Boots every title each core carries in media.h, runs a fixed number of frames of
+// host_script() joystick input and checks the CRC32 of every video line and audio sample
+// against goldens.txt. Run before and after touching a core's hot paths: a mismatch
+// means the rewrite changed what is seen or heard, not just how fast.
+//
+//    esp_8_bit_golden <goldens> [frames] [-u]
+//
+// -u rewrites the goldens from this build. Cold boots are made repeatable by clearing the
+// boot seed (the Atari seeds POKEY from the clock). The cores keep plenty of state in
+// globals that a new Emu does not reset, so each title runs in its own forked process;
+// otherwise a title's CRCs would depend on the ones run before it.
+
+using namespace std;
+
+struct Golden {
+    int frames;
+    uint32_t video;
+    uint32_t audio;
+    bool silent;            // every audio sample was the same
+};
+
+static void titles(const string& path, const char** ext, vector<string>& files)
+{
+    DIR* dirp = opendir(path.c_str());
+    if (!dirp)
+        return;
+    struct dirent* dp;
+    while ((dp = readdir(dirp)) != NULL) {
+        string e = get_ext(dp->d_name);
+        for (int i = 0; ext[i]; i++)
+            if (e == ext[i])
+                files.push_back(dp->d_name);
+    }
+    closedir(dirp);
+    sort(files.begin(),files.end());
+}
+
+static Golden run(Emu* emu, const string& path, int frames)
+{
+    Golden g = {frames,0xFFFFFFFF,0xFFFFFFFF,true};
+    if (emu->insert(path,1,0) != 0) {
+        g.frames = 0;
+        return g;
+    }
+    emu->set_boot_seed(0);
+    host_init(emu);
+
+    int16_t audio[313*2];
+    int16_t level = 0;
+    int n;
+    for (int f = 0; f < frames; f++) {
+        uint32_t e,v;
+        host_frame(emu,&e,&v,audio,&n);
+        g.audio = CRC32_Update(g.audio,(const UBYTE*)audio,n*sizeof(int16_t));
+        if (!f && n)
+            level = audio[0];
+        for (int i = 0; i < n && g.silent; i++)
+            g.silent = audio[i] == level;
+        uint8_t** lines = emu->video_buffer();
+        for (int y = 0; y < emu->height; y++)
+            g.video = CRC32_Update(g.video,lines[y],emu->width);
+
+        int m = host_script(f);
+        if (m >= 0) {
+            uint8_t r[5] = {0x42,(uint8_t)m,(uint8_t)(m >> 8)};
+            emu->hid(r,sizeof(r));
+        }
+    }
+    g.video ^= 0xFFFFFFFF;
+    g.audio ^= 0xFFFFFFFF;
+    return g;
+}
+
+// boot and run the title in a child so every title starts from the same core state
+static Golden run_forked(const char* name, const string& path, int frames)
+{
+    Golden g = {0,0,0,false};
+    int fd[2];
+    if (pipe(fd))
+        return g;
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid == 0) {
+        close(fd[0]);
+        Emu* emu = NewEmulator(name);
+        Golden r = run(emu,path,frames);
+        delete emu;
+        _exit(write(fd[1],&r,sizeof(r)) == sizeof(r) ? 0 : 1);
+    }
+    close(fd[1]);
+    if (pid > 0) {
+        if (read(fd[0],&g,sizeof(g)) != sizeof(g))
+            g.frames = 0;               // crashed
+        waitpid(pid,0,0);
+    }
+    close(fd[0]);
+    return g;
+}
+
+int main(int argc, char* argv[])
+{
+    bool update = argc > 1 && !strcmp(argv[argc-1],"-u");
+    if (update)
+        argc--;
+    if (argc < 2) {
+        printf("usage: %s <goldens> [frames] [-u]\n",argv[0]);
+        return 1;
+    }
+    int frames = argc > 2 ? atoi(argv[2]) : 600;
+
+    // emu title -> golden
+    map<string,Golden> goldens;
+    FILE* f = fopen(argv[1],"r");
+    if (f) {
+        char key[256];
+        char title[256];
+        Golden g;
+        while (fscanf(f,"%255s %255s %d %x %x",key,title,&g.frames,&g.video,&g.audio) == 5)
+            goldens[string(key) + " " + title] = g;
+        fclose(f);
+    } else if (!update) {
+        printf("no goldens in %s, make them with -u\n",argv[1]);
+        return 1;
+    }
+
+    // cores are chatty, collect the results and print them at the end
+    mkdir("golden_media",0755);
+    const char* emus[] = {"atari800","nofrendo","smsplus",0};
+    vector<string> rows;
+    map<string,Golden> results;
+    int failed = 0;
+    char buf[256];
+    for (int e = 0; emus[e]; e++) {
+        Emu* emu = NewEmulator(emus[e]);
+        string dir = string("golden_media/") + emus[e];
+        emu->make_default_media(dir);
+        vector<string> files;
+        titles(dir,emu->_ext,files);
+        string name = emu->name;
+        delete emu;
+        for (auto& t : files) {
+            string key = name + " " + t;
+            Golden g = run_forked(emus[e],dir + "/" + t,frames);
+            results[key] = g;
+            const char* verdict = "new";
+            auto it = goldens.find(key);
+            if (!g.frames)
+                verdict = "FAILED TO BOOT";
+            else if (it != goldens.end() && it->second.frames == frames) {
+                bool v = it->second.video == g.video;
+                bool a = it->second.audio == g.audio;
+                verdict = v && a ? "ok" : (v ? "AUDIO DIFFERS" : (a ? "VIDEO DIFFERS" : "VIDEO AND AUDIO DIFFER"));
+            }
+            if (strcmp(verdict,"ok") && (!update || !g.frames))
+                failed++;
+            sprintf(buf,"%-9s %-24s %6d %08x %08x %s%s",name.c_str(),t.c_str(),frames,g.video,g.audio,verdict,
+                g.frames && g.silent ? ", WARNING: silent" : "");
+            rows.push_back(buf);
+        }
+    }
+
+    printf("\n%-9s %-24s %6s %8s %8s\n","emu","title","frames","video","audio");
+    for (auto& r : rows)
+        printf("%s\n",r.c_str());
+
+    if (update) {
+        f = mkfile(argv[1]);
+        if (!f)
+            return 1;
+        for (auto& r : results)
+            if (r.second.frames)
+                fprintf(f,"%s %d %08x %08x\n",r.first.c_str(),r.second.frames,r.second.video,r.second.audio);
+        fclose(f);
+        printf("wrote %s\n",argv[1]);
+    } else
+        printf("%d of %d titles differ from %s\n",failed,(int)rows.size(),argv[1]);
+    return failed ? 1 : 0;
+}
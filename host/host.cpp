@@ -0,0 +1,168 @@
+/* Copyright (c) 2020, Peter Barrett
+**
+** Permission to use, copy, modify, and/or distribute this software for
+** any purpose with or without fee is hereby granted, provided that the
+** above copyright notice and this permission notice appear in all copies.
+**
+** THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+** WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+** WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR
+** BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES
+** OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+** WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+** ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+** SOFTWARE.
+*/
+
+#include <math.h>
+#include "../config.h"
+#include "../src/emu.h"
+#include "../src/video_out.h"
+#include "host.h"
+
+// Stands in for the ESP32 side of the sketch. video_out.h is compiled here once,
+// the HW it talks to is stubbed out so emulators run as fast as the host allows.
+
+//====================================================================================================
+// HW stubs
+//====================================================================================================
+uint16_t* _dma_line = 0;
+
+void video_init_hw(int line_width, int samples_per_cc)
+{
+    delete [] _dma_line;
+    _dma_line = new uint16_t[line_width];
+}
+
+void audio_sample(uint8_t s)
+{
+}
+
+void ir_sample()
+{
+}
+
+extern "C"
+void* MALLOC32(int x, const char* label)
+{
+    void* r = malloc(x);
+    if (!r) {
+        printf("MALLOC32 FAILED allocation of %s:%d!!!!####################\n",label,x);
+        exit(1);
+    }
+    return r;
+}
+
+extern "C"
+void* MALLOC32_TRY(int x, const char* label)
+{
+    return malloc(x);
+}
+
+// no bluetooth on the host
+wii_state wii_states[4] = {0};
+
+uint32_t wii_map(int index, const uint32_t* common, const uint32_t* classic)
+{
+    return 0;
+}
+
+int hid_init(const char* local_name)
+{
+    return 0;
+}
+
+int hid_update()
+{
+    return 0;
+}
+
+int hid_close()
+{
+    return 0;
+}
+
+int hid_get(uint8_t* dst, int dst_len)
+{
+    return 0;
+}
+
+// prefs live for the life of the process
+std::map<std::string,std::string> _prefs;
+
+int sys_get_pref(const char* key, char* value, int max_len)
+{
+    value[0] = 0;
+    auto it = _prefs.find(key);
+    if (it == _prefs.end())
+        return 0;
+    strncpy(value,it->second.c_str(),max_len);
+    return (int)strlen(value);
+}
+
+void sys_set_pref(const char* key, const char* value)
+{
+    _prefs[key] = value;
+}
+
+//====================================================================================================
+//
+//====================================================================================================
+Emu* NewEmulator(const std::string& name)
+{
+    if (name == "atari800")
+        return NewAtari800(VIDEO_STANDARD);
+    if (name == "nofrendo")
+        return NewNofrendo(VIDEO_STANDARD);
+    if (name == "smsplus")
+        return NewSMSPlus(VIDEO_STANDARD);
+    printf("Must choose one of the following emulators: atari800,nofrendo,smsplus\n");
+    return NULL;
+}
+
+void host_init(Emu* emu)
+{
+    video_init(emu->cc_width,emu->flavor,emu->composite_palette(),emu->standard);
+}
+
+// one frame of what emu_loop and video_isr do on the ESP32
+// audio (313*2 samples) gets a copy of the frame's samples if asked
+void host_frame(Emu* emu, uint32_t* emu_ticks, uint32_t* video_ticks, int16_t* audio, int* audio_len)
+{
+    int16_t abuffer[313*2];
+    uint32_t t = cpu_ticks();
+    video_queue(true);
+    emu->update();
+    int n;
+    PROF_ZONE(PROF_AUDIO,n = emu->audio_buffer(abuffer,sizeof(abuffer)));
+    if (audio) {
+        *audio_len = n*(emu->audio_format >> 8);
+        memcpy(audio,abuffer,*audio_len*sizeof(int16_t));
+    }
+    audio_write_16(abuffer,n,emu->audio_format >> 8);
+    video_present(emu->video_buffer());
+    uint32_t t1 = cpu_ticks();
+    PROF_ENTER(PROF_IDLE);              // core 1 on the ESP32, emu would be waiting
+    for (int i = 0; i < _line_count; i++)
+        video_isr(_dma_line);           // drains the audio written above, flips at vblank
+    PROF_LEAVE();
+    *video_ticks = cpu_ticks() - t1;
+    *emu_ticks = t1 - t;
+#ifdef PERF
+    prof_frame();
+#endif
+}
+
+// a few seconds of each direction with fire and the odd start, same every time
+// enough to get most titles past their title screens
+int host_script(int frame)
+{
+    if (frame % 20)
+        return -1;
+    if (frame % 600 == 300)
+        return GENERIC_START;
+    uint32_t h = (frame/20 + 1)*0x9E3779B1;
+    h ^= h >> 15;
+    const int dirs[4] = {GENERIC_UP,GENERIC_DOWN,GENERIC_LEFT,GENERIC_RIGHT};
+    return dirs[(h >> 16) & 3] | ((h >> 20) & 1 ? GENERIC_FIRE : 0);
+}
@@ -0,0 +1,29 @@
+/* Copyright (c) 2020, Peter Barrett
+**
+** Permission to use, copy, modify, and/or distribute this software for
+** any purpose with or without fee is hereby granted, provided that the
+** above copyright notice and this permission notice appear in all copies.
+**
+** THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+** WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+** WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR
+** BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES
+** OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+** WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+** ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+** SOFTWARE.
+*/
+
+#ifndef host_h
+#define host_h
+
+#include "../src/emu.h"
+
+// host side of the sketch, see host.cpp
+Emu* NewEmulator(const std::string& name);      // "atari800", "nofrendo" or "smsplus"
+void host_init(Emu* emu);                       // start the (stubbed) A/V pump
+void host_frame(Emu* emu, uint32_t* emu_ticks, uint32_t* video_ticks, int16_t* audio = 0, int* audio_len = 0);
+int host_script(int frame);                     // scripted GENERIC_* joystick mask for this frame, -1 if unchanged
+uint32_t cpu_ticks();
+
+#endif
@@ -0,0 +1,65 @@
+/* Copyright (c) 2020, Peter Barrett
+**
+** Permission to use, copy, modify, and/or distribute this software for
+** any purpose with or without fee is hereby granted, provided that the
+** above copyright notice and this permission notice appear in all copies.
+**
+** THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+** WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+** WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR
+** BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES
+** OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+** WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+** ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+** SOFTWARE.
+*/
+
+#include "../src/emu.h"
+#include "../src/profile.h"
+#include "host.h"
+
+// esp_8_bit_host
+// Runs the emulators headless on a desktop so Emu::update() can be profiled with perf
+// and regression tested without flashing a board. All three cores are linked in and
+// the emulator is picked at runtime from the command line.
+//
+//    esp_8_bit_host <atari800|nofrendo|smsplus> <media> [frames]
+//
+// Every frame runs the emulator, pulls a frame of audio and pushes the video through
+// the same video_isr/blit path used on the ESP32 into a scratch DMA line.
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3) {
+        printf("usage: %s <atari800|nofrendo|smsplus> <media> [frames]\n",argv[0]);
+        return 1;
+    }
+
+    Emu* emu = NewEmulator(argv[1]);
+    if (!emu)
+        return 1;
+    int frames = argc > 3 ? atoi(argv[3]) : 600;
+
+    if (emu->insert(argv[2],1,0) != 0) {
+        printf("%s failed to insert %s\n",emu->name.c_str(),argv[2]);
+        return 1;
+    }
+    host_init(emu);
+
+    uint64_t emu_ticks = 0;
+    uint64_t video_ticks = 0;
+    for (int f = 0; f < frames; f++) {
+        uint32_t e,v;
+        host_frame(emu,&e,&v);
+        emu_ticks += e;
+        video_ticks += v;
+    }
+
+    printf("%s %s: %d frames, emu %llu ticks/frame, video %llu ticks/frame\n",
+        emu->name.c_str(),argv[2],frames,(unsigned long long)(emu_ticks/frames),(unsigned long long)(video_ticks/frames));
+#ifdef PERF
+    prof_print();                       // last PROF_FRAMES frames
+#endif
+    delete emu;
+    return 0;
+}
@@ -0,0 +1,73 @@
+/* Copyright (c) 2020, Peter Barrett
+**
+** Permission to use, copy, modify, and/or distribute this software for
+** any purpose with or without fee is hereby granted, provided that the
+** above copyright notice and this permission notice appear in all copies.
+**
+** THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+** WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+** WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR
+** BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES
+** OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+** WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+** ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+** SOFTWARE.
+*/
+
+// The ESP32 has tinfl in ROM (rom/miniz.h). On the host the same
+// streaming interface is implemented on top of zlib so unpack() works unchanged.
+
+#ifndef host_miniz_h
+#define host_miniz_h
+
+#include <stddef.h>
+#include <string.h>
+#include <zlib.h>
+
+typedef enum {
+    TINFL_STATUS_FAILED = -1,
+    TINFL_STATUS_DONE = 0,
+    TINFL_STATUS_NEEDS_MORE_INPUT = 1,
+    TINFL_STATUS_HAS_MORE_OUTPUT = 2
+} tinfl_status;
+
+#define TINFL_FLAG_PARSE_ZLIB_HEADER 1
+
+typedef struct {
+    z_stream z;
+    int state;      // 0:idle 1:inflating 2:done
+} tinfl_decompressor;
+
+static inline void tinfl_init(tinfl_decompressor* r)
+{
+    memset(r,0,sizeof(tinfl_decompressor));
+}
+
+static inline tinfl_status tinfl_decompress(tinfl_decompressor* r,
+    const unsigned char* in, size_t* in_bytes,
+    unsigned char* out_start, unsigned char* out_next, size_t* out_bytes, int flags)
+{
+    if (r->state == 2) {
+        *in_bytes = *out_bytes = 0;
+        return TINFL_STATUS_DONE;
+    }
+    if (r->state == 0) {
+        if (inflateInit2(&r->z,(flags & TINFL_FLAG_PARSE_ZLIB_HEADER) ? 15 : -15) != Z_OK)
+            return TINFL_STATUS_FAILED;
+        r->state = 1;
+    }
+    r->z.next_in = (Bytef*)in;
+    r->z.avail_in = (uInt)*in_bytes;
+    r->z.next_out = out_next;
+    r->z.avail_out = (uInt)*out_bytes;
+    int e = inflate(&r->z,Z_NO_FLUSH);
+    *in_bytes -= r->z.avail_in;
+    *out_bytes -= r->z.avail_out;
+    if (e == Z_OK || (e == Z_BUF_ERROR && (*in_bytes || *out_bytes)))
+        return r->z.avail_out ? TINFL_STATUS_NEEDS_MORE_INPUT : TINFL_STATUS_HAS_MORE_OUTPUT;
+    inflateEnd(&r->z);
+    r->state = 2;
+    return e == Z_STREAM_END ? TINFL_STATUS_DONE : TINFL_STATUS_FAILED;
+}
+
+#endif
@@ -0,0 +1,129 @@
+/* Copyright (c) 2020, Peter Barrett
+**
+** Permission to use, copy, modify, and/or distribute this software for
+** any purpose with or without fee is hereby granted, provided that the
+** above copyright notice and this permission notice appear in all copies.
+**
+** THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+** WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+** WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR
+** BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES
+** OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+** WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+** ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+** SOFTWARE.
+*/
+
+#include <algorithm>
+#include <sys/stat.h>
+#include "../src/emu.h"
+#include "host.h"
+
+extern "C" {
+#include "../src/smsplus/shared.h"
+}
+
+// esp_8_bit_psg_bench
+// Host cycles per frame of SMS/Game Gear PSG audio, the per sample stereo SN76496Update()
+// followed by the old averaging/lo pass pass vs the block SN76496UpdateMono(). Plays the
+// smsplus titles in media.h with host_script() input; every frame both renderers start
+// from the same chip state and must produce identical samples.
+//
+//    esp_8_bit_psg_bench [frames]
+
+using namespace std;
+
+// what EmuSMSPlus::audio_buffer did with the two SN76496Update buffers
+static void stereo_to_mono(int16_t* b, int16_t* l, int16_t* r, int n, int& lp)
+{
+    for (int i = 0; i < n; i++) {
+        int s = (l[i] + r[i]) >> 1;
+        lp = (lp*31 + s) >> 5;
+        s -= lp;
+        if (s < -32767) s = -32767;
+        if (s > 32767) s = 32767;
+        b[i] = s;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    int frames = argc > 1 ? atoi(argv[1]) : 3600;
+    if (frames <= 0) {
+        printf("usage: %s [frames]\n",argv[0]);
+        return 1;
+    }
+
+    Emu* emu = NewEmulator("smsplus");
+    string path = "psg_media";
+    mkdir(path.c_str(),0755);
+    emu->make_default_media(path);
+
+    vector<string> files;
+    DIR* dirp = opendir(path.c_str());
+    struct dirent* dp;
+    while (dirp && (dp = readdir(dirp)) != NULL)
+        if (dp->d_name[0] != '.' && get_ext(dp->d_name) != "cfg")
+            files.push_back(dp->d_name);
+    if (dirp)
+        closedir(dirp);
+    sort(files.begin(),files.end());
+    delete emu;
+
+    vector<string> rows;
+    char buf[256];
+    int mismatches = 0;
+    for (auto& f : files) {
+        emu = NewEmulator("smsplus");
+        if (emu->insert(path + "/" + f,1,0) != 0) {
+            delete emu;
+            continue;
+        }
+        host_init(emu);
+
+        int16_t l[313], r[313], ref[313], out[313];
+        int16_t* lr[2] = {l,r};
+        vector<uint32_t> t_ref, t_out;
+        int first = -1;
+        for (int i = 0; i < frames; i++) {
+            int m = host_script(i);
+            if (m >= 0) {
+                uint8_t report[5] = {0x42,(uint8_t)m,(uint8_t)(m >> 8),0,0};
+                emu->hid(report,sizeof(report));
+            }
+            emu->update();
+            int n = emu->frame_sample_count();
+
+            t_SN76496 chip = sn[0];
+            int lp = chip.Dc;
+            uint32_t t0 = cpu_ticks();
+            SN76496Update(0,lr,n,sms.psg_mask);
+            stereo_to_mono(ref,l,r,n,lp);
+            t_ref.push_back(cpu_ticks() - t0);
+
+            sn[0] = chip;
+            t0 = cpu_ticks();
+            SN76496UpdateMono(0,out,n,sms.psg_mask);
+            t_out.push_back(cpu_ticks() - t0);
+
+            if (first < 0 && !equal(ref,ref + n,out))
+                first = i;
+        }
+        sort(t_ref.begin(),t_ref.end());
+        sort(t_out.begin(),t_out.end());
+        uint32_t a = t_ref[frames/2], b = t_out[frames/2];
+        if (first >= 0) {
+            sprintf(buf,"%-24s %9u %9u %8.2fx MISMATCH at frame %d",f.c_str(),a,b,(float)a/b,first);
+            mismatches++;
+        } else
+            sprintf(buf,"%-24s %9u %9u %8.2fx",f.c_str(),a,b,(float)a/b);
+        rows.push_back(buf);
+        delete emu;
+    }
+
+    printf("\nmedian host cycles per frame of PSG audio over %d frames\n",frames);
+    printf("%-24s %9s %9s %9s\n","title","stereo","mono","speedup");
+    for (auto& r : rows)
+        printf("%s\n",r.c_str());
+    return mismatches ? 1 : 0;
+}
@@ -0,0 +1,137 @@
+/* Copyright (c) 2020, Peter Barrett
+**
+** Permission to use, copy, modify, and/or distribute this software for
+** any purpose with or without fee is hereby granted, provided that the
+** above copyright notice and this permission notice appear in all copies.
+**
+** THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+** WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+** WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR
+** BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES
+** OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+** WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+** ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+** SOFTWARE.
+*/
+
+#include <algorithm>
+#include <zlib.h>
+#include "../src/emu.h"
+#include "../src/movie.h"
+#include "host.h"
+
+// esp_8_bit_replay
+// Replays an input movie headless, hashes every frame and reports host cycles per frame.
+// The first run writes the hashes, later runs compare against them and report the first
+// frame that differs so a change to a core can be checked against a long session.
+//
+//    esp_8_bit_replay <movie> <hashes> [media]
+//    esp_8_bit_replay -r <atari800|nofrendo|smsplus> <media> <frames> <movie>
+//
+// media overrides the path stored in the movie (recorded on the device as /nofrendo/...).
+// -r records a cold boot movie of scripted joystick input, a stand in for a real session.
+
+using namespace std;
+
+static uint32_t frame_hash(Emu* emu)
+{
+    uint8_t** lines = emu->video_buffer();
+    uLong h = 0;
+    for (int y = 0; y < emu->height; y++)
+        h = crc32(h,lines[y],emu->width);
+    return h;
+}
+
+// cold boot movie of host_script()
+static int record(const char* core, const char* media, int frames, const char* path)
+{
+    Emu* emu = NewEmulator(core);
+    if (!emu || emu->insert(media,1,0) != 0)
+        return 1;
+    host_init(emu);
+    Movie movie;
+    movie.record(emu,media,1,false);
+
+    for (int f = 0; f < frames; f++) {
+        movie.frame(emu);
+        uint32_t e,v;
+        host_frame(emu,&e,&v);
+        int m = host_script(f);
+        if (m < 0)
+            continue;
+        uint8_t r[5] = {0x42,(uint8_t)m,(uint8_t)(m >> 8)};
+        movie.pad(r,sizeof(r));
+        emu->hid(r,sizeof(r));
+    }
+    movie.stop();
+    int err = movie.save(path);
+    printf("%s %s: %d frames recorded to %s\n",core,media,frames,path);
+    delete emu;
+    return err ? 1 : 0;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc == 6 && !strcmp(argv[1],"-r"))
+        return record(argv[2],argv[3],atoi(argv[4]),argv[5]);
+    if (argc < 3) {
+        printf("usage: %s <movie> <hashes> [media]\n",argv[0]);
+        printf("       %s -r <atari800|nofrendo|smsplus> <media> <frames> <movie>\n",argv[0]);
+        return 1;
+    }
+
+    Movie movie;
+    if (movie.load(argv[1]) != 0) {
+        printf("%s is not a movie\n",argv[1]);
+        return 1;
+    }
+    Emu* emu = NewEmulator(movie.name);
+    if (!emu)
+        return 1;
+    string media = argc > 3 ? argv[3] : movie.media;
+    if (emu->insert(media,movie.flags,0) != 0 || movie.play(emu) != 0) {
+        printf("%s failed to start %s\n",emu->name.c_str(),media.c_str());
+        return 1;
+    }
+    host_init(emu);
+
+    vector<uint32_t> hashes;
+    vector<uint32_t> ticks;
+    while (movie.frame(emu)) {
+        uint32_t e,v;
+        host_frame(emu,&e,&v);
+        hashes.push_back(frame_hash(emu));
+        ticks.push_back(e);
+    }
+    int frames = hashes.size();
+    if (!frames)
+        return 1;
+
+    // compare against a previous run or become the one to compare against
+    int bad = -1;
+    FILE* f = fopen(argv[2],"r");
+    bool compared = f != NULL;
+    if (compared) {
+        int i = 0;
+        unsigned int h;
+        while (i < frames && fscanf(f,"%*d %x",&h) == 1 && h == hashes[i])
+            i++;
+        fclose(f);
+        if (i < frames)
+            bad = i;
+    } else if ((f = mkfile(argv[2]))) {
+        for (int i = 0; i < frames; i++)
+            fprintf(f,"%d %08x\n",i,hashes[i]);
+        fclose(f);
+    }
+
+    sort(ticks.begin(),ticks.end());
+    printf("%s %s: %d frames, host cycles per frame min %u median %u p99 %u max %u\n",
+        emu->name.c_str(),media.c_str(),frames,ticks[0],ticks[frames/2],ticks[(frames-1)*99/100],ticks[frames-1]);
+    if (bad >= 0)
+        printf("frame %d differs from %s\n",bad,argv[2]);
+    else
+        printf("%s %s\n",compared ? "matches" : "wrote",argv[2]);
+    delete emu;
+    return bad >= 0;
+}
@@ -47,6 +47,7 @@
 #ifdef NEW_CYCLE_EXACT
 #include "cycle_map.h"
 #endif
+#include "../video_line.h"
 
 #define LCHOP 3			/* do not build leftmost 0..3 characters in wide mode */
 #define RCHOP 3			/* do not build rightmost 0..3 characters in wide mode */
@@ -3231,6 +3232,8 @@ void ANTIC_Frame(int draw_display)
 #endif
 	need_dl = TRUE;
 	do {
+		if (draw_display && ANTIC_ypos > 8)	/* last line is done */
+			VIDEO_LINE(ANTIC_ypos - 9, (UBYTE *) scrn_ptr - Screen_WIDTH);
 		if ((INPUT_mouse_mode == INPUT_MOUSE_PEN || INPUT_mouse_mode == INPUT_MOUSE_GUN) && (ANTIC_ypos >> 1 == ANTIC_PENV_input)) {
 			PENH = ANTIC_PENH_input;
 			PENV = ANTIC_PENV_input;
@@ -3498,6 +3501,8 @@ void ANTIC_Frame(int draw_display)
 		dctr++;
 		dctr &= 0xf;
 	} while (ANTIC_ypos < (Screen_HEIGHT + 8));
+	if (draw_display)
+		VIDEO_LINE(ANTIC_ypos - 9, (UBYTE *) scrn_ptr - Screen_WIDTH);
 
 #ifndef NO_SIMPLE_PAL_BLENDING
 	/* Simple PAL blending, using only the base 256 color palette. */
@@ -28,6 +28,7 @@
 #define UWORD unsigned short
 #ifndef HAVE_WINDOWS_H
 /* Windows headers typedef ULONG */
+#undef ULONG	/* libatari800.h may have got here first */
 #define ULONG unsigned int
 #endif
 /* Note: in various parts of the emulator we assume that char is 1 byte
@@ -148,8 +148,8 @@ static int CartIsPassthrough(int type)
 	       type == CARTRIDGE_ATRAX_SDX_64 || type == CARTRIDGE_ATRAX_SDX_128;
 }
 
-CARTRIDGE_image_t CARTRIDGE_main = { CARTRIDGE_NONE, 0, 0, NULL, "" }; /* Left/Right cartridge */
-CARTRIDGE_image_t CARTRIDGE_piggyback = { CARTRIDGE_NONE, 0, 0, NULL, "" }; /* Pass through cartridge for SpartaDOSX */
+CARTRIDGE_image_t CARTRIDGE_main = { CARTRIDGE_NONE, 0, 0, NULL, NULL, "" }; /* Left/Right cartridge */
+CARTRIDGE_image_t CARTRIDGE_piggyback = { CARTRIDGE_NONE, 0, 0, NULL, NULL, "" }; /* Pass through cartridge for SpartaDOSX */
 
 /* The currently active cartridge in the left slot - normally points to
    CARTRIDGE_main but can be switched to CARTRIDGE_piggyback if the main
@@ -1759,7 +1759,11 @@ void CARTRIDGE_StateRead(UBYTE version)
 	StateSav_ReadINT(&saved_type, 1);
 	if (saved_type != CARTRIDGE_NONE) {
 		StateSav_ReadFNAME(filename);
-		if (filename[0]) {
+		if (filename[0] && CARTRIDGE_main.type == (saved_type < 0 ? -saved_type : saved_type)
+		 && StateSav_SameFNAME(CARTRIDGE_main.filename, filename)) {
+			/* Same cartridge is still inserted, skip reloading it */
+		}
+		else if (filename[0]) {
 			/* Insert the cartridge... */
 			if (CARTRIDGE_Insert(filename) >= 0) {
 				/* And set the type to the saved type, in case it was a raw cartridge image */
@@ -1779,7 +1783,11 @@ void CARTRIDGE_StateRead(UBYTE version)
 	
 		StateSav_ReadINT(&saved_type, 1);
 		StateSav_ReadFNAME(filename);
-		if (filename[0]) {
+		if (filename[0] && CARTRIDGE_piggyback.type == saved_type
+		 && StateSav_SameFNAME(CARTRIDGE_piggyback.filename, filename)) {
+			/* Same cartridge is still inserted, skip reloading it */
+		}
+		else if (filename[0]) {
 			/* Insert the cartridge... */
 			if (CARTRIDGE_Insert_Second(filename) >= 0) {
 				/* And set the type to the saved type, in case it was a raw cartridge image */
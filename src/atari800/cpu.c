@@ -80,6 +80,8 @@
 #include "libatari800_main.h"
 #endif
 
+#include "../profile.h"
+
 /* For Atari Basic loader */
 void (*CPU_rts_handler)(void) = NULL;
 
@@ -377,6 +379,18 @@ static const int cycles[256] =
 	2, 5, 2, 8, 4, 4, 6, 6, 2, 4, 2, 7, 4, 4, 7, 7		/* Fx */
 };
 
+#ifdef PERF
+/* charge the 6502 to the cpu zone, CPU_GO has too many exits to wrap inline */
+static void cpu_go(int limit);
+void CPU_GO(int limit)
+{
+	PROF_ENTER(PROF_CPU);
+	cpu_go(limit);
+	PROF_LEAVE();
+}
+#define CPU_GO cpu_go
+#endif
+
 /* 6502 emulation routine */
 #ifndef NO_GOTO
 __extension__ /* suppress -ansi -pedantic warnings */
@@ -181,6 +181,7 @@ typedef struct {
 } pokey_state_t;
 
 extern int libatari800_error_code;
+extern int libatari800_draw_display;   /* FALSE skips rendering the next frame */
 #define LIBATARI800_UNIDENTIFIED_CART_TYPE 1
 #define LIBATARI800_CPU_CRASH 2
 #define LIBATARI800_BRK_INSTRUCTION 3
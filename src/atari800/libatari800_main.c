@@ -51,6 +51,7 @@
 #include "libatari800_input.h"
 #include "libatari800_video.h"
 #include "libatari800_statesav.h"
+#include "../profile.h"
 
 /* mainloop includes */
 #include "antic.h"
@@ -114,6 +115,8 @@ int PLATFORM_Initialise(int *argc, char *argv[])
 }
 
 
+int libatari800_draw_display = TRUE;
+
 void LIBATARI800_Frame(void)
 {
 	switch (INPUT_key_code) {
@@ -139,14 +142,14 @@ void LIBATARI800_Frame(void)
 	Devices_Frame();
 	INPUT_Frame();
 	GTIA_Frame();
-	ANTIC_Frame(TRUE);
+	PROF_ZONE(PROF_VIDEO,ANTIC_Frame(libatari800_draw_display || Atari800_collisions_in_skipped_frames));
 	INPUT_DrawMousePointer();
 	Screen_DrawAtariSpeed(Util_time());
 	Screen_DrawDiskLED();
 	Screen_Draw1200LED();
-	POKEY_Frame();
+	PROF_ZONE(PROF_AUDIO,POKEY_Frame());
 #ifdef SOUND
-	Sound_Update();
+	PROF_ZONE(PROF_AUDIO,Sound_Update());
 #endif
 	Atari800_nframes++;
 }
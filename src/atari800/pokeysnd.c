@@ -45,35 +45,6 @@
 #include "gtia.h"
 #include "util.h"
 
-#ifdef WORDS_UNALIGNED_OK
-#  define READ_U32(x)     (*(ULONG *) (x))
-#  define WRITE_U32(x, d) (*(ULONG *) (x) = (d))
-#else
-#  ifdef WORDS_BIGENDIAN
-#    define READ_U32(x) (((*(unsigned char *)(x)) << 24) | ((*((unsigned char *)(x) + 1)) << 16) | \
-                        ((*((unsigned char *)(x) + 2)) << 8) | ((*((unsigned char *)(x) + 3))))
-#    define WRITE_U32(x, d) \
-  { \
-  ULONG i = d; \
-  (*(unsigned char *) (x)) = (((i) >> 24) & 255); \
-  (*((unsigned char *) (x) + 1)) = (((i) >> 16) & 255); \
-  (*((unsigned char *) (x) + 2)) = (((i) >> 8) & 255); \
-  (*((unsigned char *) (x) + 3)) = ((i) & 255); \
-  }
-#  else
-#    define READ_U32(x) ((*(unsigned char *) (x)) | ((*((unsigned char *) (x) + 1)) << 8) | \
-                        ((*((unsigned char *) (x) + 2)) << 16) | ((*((unsigned char *) (x) + 3)) << 24))
-#    define WRITE_U32(x, d) \
-  { \
-  ULONG i = d; \
-  (*(unsigned char *)(x)) = ((i) & 255); \
-  (*((unsigned char *)(x) + 1)) = (((i) >> 8) & 255); \
-  (*((unsigned char *)(x) + 2)) = (((i) >> 16) & 255); \
-  (*((unsigned char *)(x) + 3)) = (((i) >> 24) & 255); \
-  }
-#  endif
-#endif
-
 /* GLOBAL VARIABLE DEFINITIONS */
 
 /* number of pokey chips currently emulated */
@@ -115,20 +86,19 @@ static ULONG Div_n_cnt[4 * POKEY_MAXPOKEYS],		/* Divide by n counter. one for ea
  Div_n_max[4 * POKEY_MAXPOKEYS];		/* Divide by n maximum, one for each channel */
 
 static ULONG Samp_n_max,		/* Sample max.  For accuracy, it is *256 */
- Samp_n_cnt[2];					/* Sample cnt. */
+ Samp_n_cnt;					/* Sample cnt, also *256 */
 
-#ifdef INTERPOLATE_SOUND
-#ifdef CLIP_SOUND
-static SWORD last_val = 0;		/* last output value */
-#else
-static UWORD last_val = 0;
-#endif
+static UBYTE Ev_queue[4 * POKEY_MAXPOKEYS];	/* channels, soonest Div_n_cnt first */
+
+static int Dc_lp = 0;			/* DC level of the output, *256 */
 #ifdef STEREO_SOUND
-#ifdef CLIP_SOUND
-static SWORD last_val2 = 0;	/* last output value */
-#else
-static UWORD last_val2 = 0;
+static int Dc_lp2 = 0;
 #endif
+
+#ifdef INTERPOLATE_SOUND
+static int last_val = 0;		/* last output value */
+#ifdef STEREO_SOUND
+static int last_val2 = 0;
 #endif
 #endif
 
@@ -200,6 +170,11 @@ int POKEYSND_serio_sound_enabled = 1;
 #ifdef CONSOLE_SOUND
 static void Update_consol_sound_rf(int set);
 static void null_consol_sound(int set) {}
+#if !defined(SYNCHRONIZED_SOUND) && defined(VOL_ONLY_SOUND)
+/* console speaker state, reset by init_vol_only() for every new machine */
+static int prev_atari_speaker = 0;
+static unsigned int prev_cpu_clock = 0;
+#endif
 void (*POKEYSND_UpdateConsol_ptr)(int set) = null_consol_sound;
 int POKEYSND_console_sound_enabled = 1;
 #endif
@@ -228,28 +203,9 @@ static int const CONSOLE_VOL = 32;
 
 /*****************************************************************************/
 /* In my routines, I treat the sample output as another divide by N counter  */
-/* For better accuracy, the Samp_n_cnt has a fixed binary decimal point      */
-/* which has 8 binary digits to the right of the decimal point.  I use a two */
-/* byte array to give me a minimum of 40 bits, and then use pointer math to  */
-/* reference either the 24.8 whole/fraction combination or the 32-bit whole  */
-/* only number.  This is mainly used to keep the math simple for             */
-/* optimization. See below:                                                  */
-/*                                                                           */
-/* Representation on little-endian machines:                                 */
-/* xxxxxxxx xxxxxxxx xxxxxxxx xxxxxxxx | xxxxxxxx xxxxxxxx xxxxxxxx xxxxxxxx */
-/* fraction   whole    whole    whole      whole   unused   unused   unused  */
-/*                                                                           */
-/* Samp_n_cnt[0] gives me a 32-bit int 24 whole bits with 8 fractional bits, */
-/* while (ULONG *)((UBYTE *)(&Samp_n_cnt[0])+1) gives me the 32-bit whole   */
-/* number only.                                                              */
-/*                                                                           */
-/* Representation on big-endian machines:                                    */
-/* xxxxxxxx xxxxxxxx xxxxxxxx xxxxxxxx | xxxxxxxx xxxxxxxx xxxxxxxx.xxxxxxxx */
-/*  unused   unused   unused    whole      whole    whole    whole  fraction */
-/*                                                                           */
-/* Samp_n_cnt[1] gives me a 32-bit int 24 whole bits with 8 fractional bits, */
-/* while (ULONG *)((UBYTE *)(&Samp_n_cnt[0])+3) gives me the 32-bit whole   */
-/* number only.                                                              */
+/* For better accuracy, Samp_n_cnt and Samp_n_max have a fixed binary        */
+/* decimal point which has 8 binary digits to the right of the decimal       */
+/* point: Samp_n_cnt >> 8 is the whole number of clocks to the next sample.  */
 /*****************************************************************************/
 
 
@@ -279,11 +235,17 @@ static void init_vol_only(void)
 	POKEYSND_sampbuf_rptr = POKEYSND_sampbuf_ptr;
 	POKEYSND_sampbuf_last = ANTIC_CPU_CLOCK;
 	POKEYSND_sampbuf_lastval = 0;
+	POKEYSND_sampout = 0;
 	POKEYSND_samp_consol_val = 0;
+#if defined(CONSOLE_SOUND) && !defined(SYNCHRONIZED_SOUND)
+	prev_atari_speaker = 0;
+	prev_cpu_clock = ANTIC_CPU_CLOCK;
+#endif
 #ifdef STEREO_SOUND
 	sampbuf_rptr2 = sampbuf_ptr2;
 	sampbuf_last2 = ANTIC_CPU_CLOCK;
 	sampbuf_lastval2 = 0;
+	sampout2 = 0;
 #endif /* STEREO_SOUND */
 }
 #endif /* VOL_ONLY_SOUND */
@@ -430,8 +392,18 @@ static int pokeysnd_init_rf(ULONG freq17, int playback_freq,
 	/* calculate the sample 'divide by N' value based on the playback freq. */
 	Samp_n_max = ((ULONG) freq17 << 8) / playback_freq;
 
-	Samp_n_cnt[0] = 0;			/* initialize all bits of the sample */
-	Samp_n_cnt[1] = 0;			/* 'divide by N' counter */
+	Samp_n_cnt = 0;				/* initialize the sample 'divide by N' counter */
+
+	Dc_lp = 0;
+#ifdef STEREO_SOUND
+	Dc_lp2 = 0;
+#endif
+#ifdef INTERPOLATE_SOUND
+	last_val = 0;
+#ifdef STEREO_SOUND
+	last_val2 = 0;
+#endif
+#endif
 
 	for (chan = 0; chan < (POKEY_MAXPOKEYS * 4); chan++) {
 		Outvol[chan] = 0;
@@ -723,8 +695,62 @@ static void Update_pokey_sound_rf(UWORD addr, UBYTE val, UBYTE chip,
 }
 
 
+/* Turn the sum of the channel outputs into a signed 16-bit sample. */
+/* stuck volume only sound can push iout to 276 in robot demo etc, */
+/* so it is halved and a highpass removes those funny dc biases. */
+/* The DC level keeps 8 fractional bits, which become the low byte. */
+static SWORD pokeysnd_out(int iout, int *lp)
+{
+	int s;
+
+	iout >>= 1;
+	*lp = (((*lp + iout) << 8) - *lp) >> 8;	/* 255*lp + iout*1 */
+	s = (iout << 8) - *lp;					/* hipass to center on 0 */
+	if (s < -32768) s = -32768;
+	if (s > 32767) s = 32767;
+	return (s * POKEYSND_volume) >> 8;
+}
+
+/*****************************************************************************/
+/* Module:  ev_sort() / ev_requeue()                                         */
+/* Purpose: To keep the channels in the order of their next divider event.   */
+/*          Ev_queue[0] is always the next channel to change, so the         */
+/*          renderer never has to scan all of the channels to find it.       */
+/*          Equal counts go highest channel first, the order the original    */
+/*          four channel scan handled them in (channel 3 clocks the channel  */
+/*          1 filter before channel 1 itself is toggled, and so on).         */
+/*                                                                           */
+/*          The queue is only reordered by the renderer. The AUDF, AUDC and  */
+/*          AUDCTL writes that move Div_n_cnt happen between calls, so it is */
+/*          sorted again at the start of each one.                           */
+/*****************************************************************************/
+
+#define EV_BEFORE(a, b) (Div_n_cnt[a] < Div_n_cnt[b] || (Div_n_cnt[a] == Div_n_cnt[b] && (a) > (b)))
+
+static void ev_sort(int num)
+{
+	int i, j;
+
+	for (i = 0; i < num; i++) {
+		for (j = i; j > 0 && EV_BEFORE(i, Ev_queue[j - 1]); j--)
+			Ev_queue[j] = Ev_queue[j - 1];
+		Ev_queue[j] = i;
+	}
+}
+
+/* the head channel has a new count, move it back to its place */
+static void ev_requeue(int num)
+{
+	UBYTE chan = Ev_queue[0];
+	int i;
+
+	for (i = 1; i < num && EV_BEFORE(Ev_queue[i], chan); i++)
+		Ev_queue[i - 1] = Ev_queue[i];
+	Ev_queue[i - 1] = chan;
+}
+
 /*****************************************************************************/
-/* Module:  pokeysnd_process()                                                  */
+/* Module:  pokeysnd_process_16()                                            */
 /* Purpose: To fill the output buffer with the sound output based on the     */
 /*          pokey chip parameters.                                           */
 /*                                                                           */
@@ -736,197 +762,78 @@ static void Update_pokey_sound_rf(UWORD addr, UBYTE val, UBYTE chip,
 /*          sndn - for mono, size of the playback buffer in samples          */
 /*                 for stereo, size of the playback buffer in left samples   */
 /*                    plus right samples.                                    */
-/*          num_pokeys - number of currently active pokeys to process        */
 /*                                                                           */
-/* Outputs: the buffer will be filled with n bytes of audio - no return val  */
-/*          Also the buffer will be written to disk if Sound recording is ON */
+/* Outputs: the buffer will be filled with n signed 16-bit samples           */
 /*                                                                           */
+/* Within a call the divider counts are times from the start of the call.    */
+/* A channel is only touched when it reaches the head of Ev_queue, and the   */
+/* others no longer have to be counted down on every event. The elapsed time */
+/* is taken off all of them once, at the end, so Update_pokey_sound_rf()     */
+/* still sees counts relative to now. The polynomials are handled the same   */
+/* way: a position is only worked out from the event time when a channel     */
+/* needs its bit. Each chip's channels are just more entries in the queue,   */
+/* so a second pokey costs its own events and not another scan per sample.   */
 /*****************************************************************************/
 
-static void pokeysnd_process_8(void *sndbuffer, int sndn)
+static void pokeysnd_process_16(void *sndbuffer, int sndn)
 {
-	register UBYTE *buffer = (UBYTE *) sndbuffer;
-	register int n = sndn;
-
-	register ULONG *div_n_ptr;
-	register UBYTE *samp_cnt_w_ptr;
-	register ULONG event_min;
-	register UBYTE next_event;
-#ifdef CLIP_SOUND
-	register SWORD cur_val;		/* then we have to count as 16-bit signed */
+	SWORD *buffer = (SWORD *) sndbuffer;
+	int n = sndn;
+	int num = Num_pokeys << 2;
+	ULONG now = 0;				/* time of the last channel event, in clocks */
+	ULONG samp = Samp_n_cnt;	/* time of the next sample, 24.8 */
+	int cur_val = 0;
 #ifdef STEREO_SOUND
-	register SWORD cur_val2;
+	int cur_val2 = 0;
+	int split = POKEYSND_stereo_enabled ? 4 : num;	/* first channel on the right */
 #endif
-#else /* CLIP_SOUND */
-	register UBYTE cur_val;		/* otherwise we'll simplify as 8-bit unsigned */
-#ifdef STEREO_SOUND
-	register UBYTE cur_val2;
-#endif
-#endif /* CLIP_SOUND */
-	register UBYTE *out_ptr;
-	register UBYTE audc;
-	register UBYTE toggle;
-	register UBYTE count;
-	register UBYTE *vol_ptr;
-
-	/* set a pointer to the whole portion of the samp_n_cnt */
-#ifdef WORDS_BIGENDIAN
-	samp_cnt_w_ptr = ((UBYTE *) (&Samp_n_cnt[0]) + 3);
-#else
-	samp_cnt_w_ptr = ((UBYTE *) (&Samp_n_cnt[0]) + 1);
-#endif
-
-	/* set a pointer for optimization */
-	out_ptr = Outvol;
-	vol_ptr = pokeysnd_AUDV;
+	int chan;
 
 	/* The current output is pre-determined and then adjusted based on each */
 	/* output change for increased performance (less over-all math). */
-	/* add the output values of all 4 channels */
-	cur_val = POKEYSND_SAMP_MIN;
+	for (chan = 0; chan < num; chan++) {
+		if (Outvol[chan]) {
 #ifdef STEREO_SOUND
-#ifdef __PLUS
-	if (POKEYSND_stereo_enabled)
-#endif
-	cur_val2 = POKEYSND_SAMP_MIN;
-#endif /* STEREO_SOUND */
-
-	count = Num_pokeys;
-	do {
-		if (*out_ptr++)
-			cur_val += *vol_ptr;
-		vol_ptr++;
-
-		if (*out_ptr++)
-			cur_val += *vol_ptr;
-		vol_ptr++;
-
-		if (*out_ptr++)
-			cur_val += *vol_ptr;
-		vol_ptr++;
-
-		if (*out_ptr++)
-			cur_val += *vol_ptr;
-		vol_ptr++;
-#ifdef STEREO_SOUND
-#ifdef __PLUS
-		if (POKEYSND_stereo_enabled)
-#endif
-		{
-			count--;
-			if (count) {
-				if (*out_ptr++)
-					cur_val2 += *vol_ptr;
-				vol_ptr++;
-
-				if (*out_ptr++)
-					cur_val2 += *vol_ptr;
-				vol_ptr++;
-
-				if (*out_ptr++)
-					cur_val2 += *vol_ptr;
-				vol_ptr++;
-
-				if (*out_ptr++)
-					cur_val2 += *vol_ptr;
-				vol_ptr++;
-			}
+			if (chan >= split)
+				cur_val2 += pokeysnd_AUDV[chan];
 			else
-				break;
+#endif
+				cur_val += pokeysnd_AUDV[chan];
 		}
-#endif /* STEREO_SOUND */
-		count--;
-	} while (count);
+	}
 
 #ifdef SYNCHRONIZED_SOUND
 	cur_val += speaker;
 #endif
 
+	ev_sort(num);
+
 	/* loop until the buffer is filled */
 	while (n) {
-		/* Normally the routine would simply decrement the 'div by N' */
-		/* counters and react when they reach zero.  Since we normally */
-		/* won't be processing except once every 80 or so counts, */
-		/* I've optimized by finding the smallest count and then */
-		/* 'accelerated' time by adjusting all pointers by that amount. */
-
-		/* find next smallest event (either sample or chan 1-4) */
-		next_event = POKEY_SAMPLE;
-		event_min = READ_U32(samp_cnt_w_ptr);
-
-		div_n_ptr = Div_n_cnt;
-
-		count = 0;
-		do {
-			/* Though I could have used a loop here, this is faster */
-			if (*div_n_ptr <= event_min) {
-				event_min = *div_n_ptr;
-				next_event = POKEY_CHAN1 + (count << 2);
-			}
-			div_n_ptr++;
-			if (*div_n_ptr <= event_min) {
-				event_min = *div_n_ptr;
-				next_event = POKEY_CHAN2 + (count << 2);
-			}
-			div_n_ptr++;
-			if (*div_n_ptr <= event_min) {
-				event_min = *div_n_ptr;
-				next_event = POKEY_CHAN3 + (count << 2);
-			}
-			div_n_ptr++;
-			if (*div_n_ptr <= event_min) {
-				event_min = *div_n_ptr;
-				next_event = POKEY_CHAN4 + (count << 2);
-			}
-			div_n_ptr++;
-
-			count++;
-		} while (count < Num_pokeys);
-
-		/* if the next event is a channel change */
-		if (next_event != POKEY_SAMPLE) {
-			/* shift the polynomial counters */
-
-			count = Num_pokeys;
-			do {
-				/* decrement all counters by the smallest count found */
-				/* again, no loop for efficiency */
-				div_n_ptr--;
-				*div_n_ptr -= event_min;
-				div_n_ptr--;
-				*div_n_ptr -= event_min;
-				div_n_ptr--;
-				*div_n_ptr -= event_min;
-				div_n_ptr--;
-				*div_n_ptr -= event_min;
-
-				count--;
-			} while (count);
-
-
-			WRITE_U32(samp_cnt_w_ptr, READ_U32(samp_cnt_w_ptr) - event_min);
+		ULONG samp_w = samp >> 8;
+		int iout;
+#ifdef STEREO_SOUND
+		int iout2;
+#endif
 
-			/* since the polynomials require a mod (%) function which is
-			   division, I don't adjust the polynomials on the SAMPLE events,
-			   only the CHAN events.  I have to keep track of the change,
-			   though. */
+		/* every channel change up to and including this sample's clock */
+		while (Div_n_cnt[chan = Ev_queue[0]] <= samp_w) {
+			ULONG t = Div_n_cnt[chan];
+			UBYTE *out_ptr = &Outvol[chan];
+			UBYTE audc = POKEY_AUDC[chan];
+			UBYTE audctl = POKEY_AUDCTL[chan >> 2];
+			UBYTE toggle = FALSE;
+			int *val = &cur_val;
 
-			P4 = (P4 + event_min) % POKEY_POLY4_SIZE;
-			P5 = (P5 + event_min) % POKEY_POLY5_SIZE;
-			P9 = (P9 + event_min) % POKEY_POLY9_SIZE;
-			P17 = (P17 + event_min) % POKEY_POLY17_SIZE;
+#ifdef STEREO_SOUND
+			if (chan >= split)
+				val = &cur_val2;
+#endif
+			now = t;
 
 			/* adjust channel counter */
-			Div_n_cnt[next_event] += Div_n_max[next_event];
-
-			/* get the current AUDC into a register (for optimization) */
-			audc = POKEY_AUDC[next_event];
-
-			/* set a pointer to the current output (for opt...) */
-			out_ptr = &Outvol[next_event];
-
-			/* assume no changes to the output */
-			toggle = FALSE;
+			Div_n_cnt[chan] = t + Div_n_max[chan];
+			ev_requeue(num);
 
 			/* From here, a good understanding of the hardware is required */
 			/* to understand what is happening.  I won't be able to provide */
@@ -936,7 +843,7 @@ static void pokeysnd_process_8(void *sndbuffer, int sndn)
 			if (!(audc & POKEY_VOL_ONLY)) {
 				/* if the output is pure or the output is poly5 and the poly5 bit */
 				/* is set */
-				if ((audc & POKEY_NOTPOLY5) || bit5[P5]) {
+				if ((audc & POKEY_NOTPOLY5) || bit5[(P5 + t) % POKEY_POLY5_SIZE]) {
 					/* if the PURETONE bit is set */
 					if (audc & POKEY_PURETONE) {
 						/* then simply toggle the output */
@@ -945,281 +852,148 @@ static void pokeysnd_process_8(void *sndbuffer, int sndn)
 					/* otherwise if POLY4 is selected */
 					else if (audc & POKEY_POLY4) {
 						/* then compare to the poly4 bit */
-						toggle = (bit4[P4] == !(*out_ptr));
+						toggle = (bit4[(P4 + t) % POKEY_POLY4_SIZE] == !(*out_ptr));
 					}
 					else {
 						/* if 9-bit poly is selected on this chip */
-						if (POKEY_AUDCTL[next_event >> 2] & POKEY_POLY9) {
+						if (audctl & POKEY_POLY9) {
 							/* compare to the poly9 bit */
-							toggle = ((POKEY_poly9_lookup[P9] & 1) == !(*out_ptr));
+							toggle = ((POKEY_poly9_lookup[(P9 + t) % POKEY_POLY9_SIZE] & 1) == !(*out_ptr));
 						}
 						else {
 							/* otherwise compare to the poly17 bit */
-							toggle = (((POKEY_poly17_lookup[P17 >> 3] >> (P17 & 7)) & 1) == !(*out_ptr));
+							ULONG p17 = (P17 + t) % POKEY_POLY17_SIZE;
+							toggle = (((POKEY_poly17_lookup[p17 >> 3] >> (p17 & 7)) & 1) == !(*out_ptr));
 						}
 					}
 				}
 			}
 
-			/* check channel 1 filter (clocked by channel 3) */
-			if ( POKEY_AUDCTL[next_event >> 2] & POKEY_CH1_FILTER) {
-				/* if we're processing channel 3 */
-				if ((next_event & 0x03) == POKEY_CHAN3) {
-					/* check output of channel 1 on same chip */
-					if (Outvol[next_event & 0xfd]) {
-						/* if on, turn it off */
-						Outvol[next_event & 0xfd] = 0;
-#ifdef STEREO_SOUND
-#ifdef __PLUS
-						if (POKEYSND_stereo_enabled && (next_event & 0x04))
-#else
-						if ((next_event & 0x04))
-#endif
-							cur_val2 -= pokeysnd_AUDV[next_event & 0xfd];
-						else
-#endif /* STEREO_SOUND */
-							cur_val -= pokeysnd_AUDV[next_event & 0xfd];
-					}
-				}
-			}
-
-			/* check channel 2 filter (clocked by channel 4) */
-			if ( POKEY_AUDCTL[next_event >> 2] & POKEY_CH2_FILTER) {
-				/* if we're processing channel 4 */
-				if ((next_event & 0x03) == POKEY_CHAN4) {
-					/* check output of channel 2 on same chip */
-					if (Outvol[next_event & 0xfd]) {
-						/* if on, turn it off */
-						Outvol[next_event & 0xfd] = 0;
-#ifdef STEREO_SOUND
-#ifdef __PLUS
-						if (POKEYSND_stereo_enabled && (next_event & 0x04))
-#else
-						if ((next_event & 0x04))
-#endif
-							cur_val2 -= pokeysnd_AUDV[next_event & 0xfd];
-						else
-#endif /* STEREO_SOUND */
-							cur_val -= pokeysnd_AUDV[next_event & 0xfd];
-					}
+			/* check channel 1 filter (clocked by channel 3) and */
+			/* channel 2 filter (clocked by channel 4) on the same chip */
+			if (((chan & 0x03) == POKEY_CHAN3 && (audctl & POKEY_CH1_FILTER)) ||
+				((chan & 0x03) == POKEY_CHAN4 && (audctl & POKEY_CH2_FILTER))) {
+				/* if the filtered channel is on, turn it off */
+				if (Outvol[chan & 0xfd]) {
+					Outvol[chan & 0xfd] = 0;
+					*val -= pokeysnd_AUDV[chan & 0xfd];
 				}
 			}
 
 			/* if the current output bit has changed */
 			if (toggle) {
 				if (*out_ptr) {
-					/* remove this channel from the signal */
-#ifdef STEREO_SOUND
-#ifdef __PLUS
-					if (POKEYSND_stereo_enabled && (next_event & 0x04))
-#else
-					if ((next_event & 0x04))
-#endif
-						cur_val2 -= pokeysnd_AUDV[next_event];
-					else
-#endif /* STEREO_SOUND */
-						cur_val -= pokeysnd_AUDV[next_event];
-
-					/* and turn the output off */
+					/* remove this channel from the signal and turn it off */
+					*val -= pokeysnd_AUDV[chan];
 					*out_ptr = 0;
 				}
 				else {
-					/* turn the output on */
+					/* turn the output on and add it to the signal */
 					*out_ptr = 1;
-
-					/* and add it to the output signal */
-#ifdef STEREO_SOUND
-#ifdef __PLUS
-					if (POKEYSND_stereo_enabled && (next_event & 0x04))
-#else
-					if ((next_event & 0x04))
-#endif
-						cur_val2 += pokeysnd_AUDV[next_event];
-					else
-#endif /* STEREO_SOUND */
-						cur_val += pokeysnd_AUDV[next_event];
+					*val += pokeysnd_AUDV[chan];
 				}
 			}
 		}
-		else {					/* otherwise we're processing a sample */
-			/* adjust the sample counter - note we're using the 24.8 integer
-			   which includes an 8 bit fraction for accuracy */
 
-			int iout;
-#ifdef STEREO_SOUND
-			int iout2;
-#endif
+		/* otherwise we're processing a sample */
 #ifdef INTERPOLATE_SOUND
+		{
+			/* 24.8 clocks from the last channel change to this sample */
+			SLONG since = (SLONG) (samp - (now << 8));
+
+			iout = cur_val;
 			if (cur_val != last_val) {
-				if (*Samp_n_cnt < Samp_n_max) {		/* need interpolation */
-#ifdef CLIP_SOUND
-					iout = (cur_val * (SLONG)(*Samp_n_cnt) +
-							last_val * (SLONG)(Samp_n_max - *Samp_n_cnt))
-						/ (SLONG)Samp_n_max;
-#else
-					iout = (cur_val * (*Samp_n_cnt) +
-							last_val * (Samp_n_max - *Samp_n_cnt))
-						/ Samp_n_max;
-#endif
-				}
-				else
-					iout = cur_val;
+				if (since < (SLONG) Samp_n_max)		/* need interpolation */
+					iout = (cur_val * since + last_val * ((SLONG) Samp_n_max - since)) / (SLONG) Samp_n_max;
 				last_val = cur_val;
 			}
-			else
-				iout = cur_val;
 #ifdef STEREO_SOUND
-#ifdef __PLUS
-		if (POKEYSND_stereo_enabled)
-#endif
+			iout2 = cur_val2;
 			if (cur_val2 != last_val2) {
-				if (*Samp_n_cnt < Samp_n_max) {		/* need interpolation */
-#ifdef CLIP_SOUND
-					iout2 = (cur_val2 * (SLONG)(*Samp_n_cnt) +
-							last_val2 * (SLONG)(Samp_n_max - *Samp_n_cnt))
-						/ (SLONG)Samp_n_max;
-#else
-					iout2 = (cur_val2 * (*Samp_n_cnt) +
-							last_val2 * (Samp_n_max - *Samp_n_cnt))
-						/ Samp_n_max;
-#endif
-				}
-				else
-					iout2 = cur_val2;
+				if (since < (SLONG) Samp_n_max)
+					iout2 = (cur_val2 * since + last_val2 * ((SLONG) Samp_n_max - since)) / (SLONG) Samp_n_max;
 				last_val2 = cur_val2;
 			}
-			else
-				iout2 = cur_val2;
 #endif  /* STEREO_SOUND */
+		}
 #else   /* INTERPOLATE_SOUND */
-			iout = cur_val;
+		iout = cur_val;
 #ifdef STEREO_SOUND
-#ifdef __PLUS
-		if (POKEYSND_stereo_enabled)
-#endif
-			iout2 = cur_val2;
+		iout2 = cur_val2;
 #endif  /* STEREO_SOUND */
 #endif  /* INTERPOLATE_SOUND */
 
 #ifdef VOL_ONLY_SOUND
 #ifdef __PLUS
-			if (g_Sound.nDigitized)
+		if (g_Sound.nDigitized)
 #endif
-			{
-				if (POKEYSND_sampbuf_rptr != POKEYSND_sampbuf_ptr) {
+		{
+			if (POKEYSND_sampbuf_rptr != POKEYSND_sampbuf_ptr) {
+				int l;
+				if (POKEYSND_sampbuf_cnt[POKEYSND_sampbuf_rptr] > 0)
+					POKEYSND_sampbuf_cnt[POKEYSND_sampbuf_rptr] -= 1280;
+				while ((l = POKEYSND_sampbuf_cnt[POKEYSND_sampbuf_rptr]) <= 0) {
+					POKEYSND_sampout = POKEYSND_sampbuf_val[POKEYSND_sampbuf_rptr];
+					POKEYSND_sampbuf_rptr++;
+					if (POKEYSND_sampbuf_rptr >= POKEYSND_SAMPBUF_MAX)
+						POKEYSND_sampbuf_rptr = 0;
+					if (POKEYSND_sampbuf_rptr != POKEYSND_sampbuf_ptr)
+						POKEYSND_sampbuf_cnt[POKEYSND_sampbuf_rptr] += l;
+					else
+						break;
+				}
+			}
+			iout += POKEYSND_sampout;       // TODO!
+#ifdef STEREO_SOUND
+			if (POKEYSND_stereo_enabled) {
+				if (sampbuf_rptr2 != sampbuf_ptr2) {
 					int l;
-					if (POKEYSND_sampbuf_cnt[POKEYSND_sampbuf_rptr] > 0)
-						POKEYSND_sampbuf_cnt[POKEYSND_sampbuf_rptr] -= 1280;
-					while ((l = POKEYSND_sampbuf_cnt[POKEYSND_sampbuf_rptr]) <= 0) {
-						POKEYSND_sampout = POKEYSND_sampbuf_val[POKEYSND_sampbuf_rptr];
-						POKEYSND_sampbuf_rptr++;
-						if (POKEYSND_sampbuf_rptr >= POKEYSND_SAMPBUF_MAX)
-							POKEYSND_sampbuf_rptr = 0;
-						if (POKEYSND_sampbuf_rptr != POKEYSND_sampbuf_ptr)
-							POKEYSND_sampbuf_cnt[POKEYSND_sampbuf_rptr] += l;
+					if (sampbuf_cnt2[sampbuf_rptr2] > 0)
+						sampbuf_cnt2[sampbuf_rptr2] -= 1280;
+					while ((l = sampbuf_cnt2[sampbuf_rptr2]) <= 0) {
+						sampout2 = sampbuf_val2[sampbuf_rptr2];
+						sampbuf_rptr2++;
+						if (sampbuf_rptr2 >= POKEYSND_SAMPBUF_MAX)
+							sampbuf_rptr2 = 0;
+						if (sampbuf_rptr2 != sampbuf_ptr2)
+							sampbuf_cnt2[sampbuf_rptr2] += l;
 						else
 							break;
 					}
 				}
-				iout += POKEYSND_sampout;       // TODO!
-#ifdef STEREO_SOUND
-#ifdef __PLUS
-				if (POKEYSND_stereo_enabled)
-#endif
-				{
-					if (sampbuf_rptr2 != sampbuf_ptr2) {
-						int l;
-						if (sampbuf_cnt2[sampbuf_rptr2] > 0)
-							sampbuf_cnt2[sampbuf_rptr2] -= 1280;
-						while ((l = sampbuf_cnt2[sampbuf_rptr2]) <= 0) {
-							sampout2 = sampbuf_val2[sampbuf_rptr2];
-							sampbuf_rptr2++;
-							if (sampbuf_rptr2 >= POKEYSND_SAMPBUF_MAX)
-								sampbuf_rptr2 = 0;
-							if (sampbuf_rptr2 != sampbuf_ptr2)
-								sampbuf_cnt2[sampbuf_rptr2] += l;
-							else
-								break;
-						}
-					}
-					iout2 += sampout2;
-				}
-#endif  /* STEREO_SOUND */
+				iout2 += sampout2;
 			}
+			else
+				iout2 += POKEYSND_sampout;
+#endif  /* STEREO_SOUND */
+		}
 #endif  /* VOL_ONLY_SOUND */
 
-#ifdef CLIP_SOUND
-			if (iout > POKEYSND_SAMP_MAX) {	/* then check high limit */
-				*buffer++ = (UBYTE) POKEYSND_SAMP_MAX;	/* and limit if greater */
-			}
-			else if (iout < POKEYSND_SAMP_MIN) {		/* else check low limit */
-				*buffer++ = (UBYTE) POKEYSND_SAMP_MIN;	/* and limit if less */
-			}
-			else {				/* otherwise use raw value */
-				*buffer++ = (UBYTE) iout;
-			}
+		iout = pokeysnd_out(iout, &Dc_lp);
+		*buffer++ = iout;
 #ifdef STEREO_SOUND
-#ifdef __PLUS
-			if (POKEYSND_stereo_enabled) {
-				if (iout2 > POKEYSND_SAMP_MAX)
-					*buffer++ = (UBYTE) POKEYSND_SAMP_MAX;
-				else if (iout2 < POKEYSND_SAMP_MIN)
-					*buffer++ = (UBYTE) POKEYSND_SAMP_MIN;
-				else
-					*buffer++ = (UBYTE) iout2;
-			}
-#else /* __PLUS */
-			if (Num_pokeys > 1) {
-				if ((POKEYSND_stereo_enabled ? iout2 : iout) > POKEYSND_SAMP_MAX) {	/* then check high limit */
-					*buffer++ = (UBYTE) POKEYSND_SAMP_MAX;	/* and limit if greater */
-				}
-				else if ((POKEYSND_stereo_enabled ? iout2 : iout) < POKEYSND_SAMP_MIN) {		/* else check low limit */
-					*buffer++ = (UBYTE) POKEYSND_SAMP_MIN;	/* and limit if less */
-				}
-				else {				/* otherwise use raw value */
-					*buffer++ = (UBYTE) (POKEYSND_stereo_enabled ? iout2 : iout);
-				}
-			}
-#endif /* __PLUS */
+		if (Num_pokeys > 1)
+			*buffer++ = POKEYSND_stereo_enabled ? pokeysnd_out(iout2, &Dc_lp2) : iout;
 #endif /* STEREO_SOUND */
-#else /* CLIP_SOUND */
-
-            // stuck volume only sound can push iout to 276 in robot demo etc
-            // highpass to remove those funny dc biases
-            iout >>= 1;
-            static int _lp = 0;
-            _lp = (((_lp+iout) << 8) - _lp) >> 8;   // 255*_lp + iout*1
-            int s = iout - (_lp >> 8) + 128;        // hipass to center on 128
-            if (s < 0) s = 0;
-            if (s > 255) s = 255;
-            *buffer++ = s;                          // 8 bit unsigned
 
+		samp += Samp_n_max;
+		/* and indicate one less sample in the buffer */
+		n--;
 #ifdef STEREO_SOUND
-			if (Num_pokeys > 1)
-#ifdef ASAP
-				*buffer++ = (UBYTE) iout2;
-#else
-				*buffer++ = (UBYTE) (POKEYSND_stereo_enabled ? iout2 : iout);
-#endif
-#endif /* STEREO_SOUND */
-#endif /* CLIP_SOUND */
-
-#ifdef WORDS_BIGENDIAN
-			*(Samp_n_cnt + 1) += Samp_n_max;
-#else
-			*Samp_n_cnt += Samp_n_max;
-#endif
-			/* and indicate one less byte in the buffer */
+		if (Num_pokeys > 1)
 			n--;
-#ifdef STEREO_SOUND
-#ifdef __PLUS
-			if (POKEYSND_stereo_enabled)
-#endif
-			if (Num_pokeys > 1)
-				n--;
 #endif
-		}
 	}
+
+	/* make the counts and the polynomials relative to now again */
+	for (chan = 0; chan < num; chan++)
+		Div_n_cnt[chan] -= now;
+	Samp_n_cnt = samp - (now << 8);
+	P4 = (P4 + now) % POKEY_POLY4_SIZE;
+	P5 = (P5 + now) % POKEY_POLY5_SIZE;
+	P9 = (P9 + now) % POKEY_POLY9_SIZE;
+	P17 = (P17 + now) % POKEY_POLY17_SIZE;
+
 #ifdef VOL_ONLY_SOUND
 #ifdef __PLUS
 	if (g_Sound.nDigitized)
@@ -1228,16 +1002,28 @@ static void pokeysnd_process_8(void *sndbuffer, int sndn)
 		if (POKEYSND_sampbuf_rptr == POKEYSND_sampbuf_ptr)
 			POKEYSND_sampbuf_last = ANTIC_CPU_CLOCK;
 #ifdef STEREO_SOUND
-#ifdef __PLUS
-	if (POKEYSND_stereo_enabled)
-#endif
-		if (sampbuf_rptr2 == sampbuf_ptr2)
+		if (POKEYSND_stereo_enabled && sampbuf_rptr2 == sampbuf_ptr2)
 			sampbuf_last2 = ANTIC_CPU_CLOCK;
 #endif /* STEREO_SOUND */
 	}
 #endif  /* VOL_ONLY_SOUND */
 }
 
+/* the 8-bit output narrows blocks of the 16-bit one */
+static void pokeysnd_process_8(void *sndbuffer, int sndn)
+{
+	UBYTE *buffer = (UBYTE *) sndbuffer;
+	SWORD block[256];
+
+	while (sndn > 0) {
+		int i, n = sndn < 256 ? sndn : 256;
+		pokeysnd_process_16(block, n);
+		for (i = 0; i < n; i++)
+			*buffer++ = (UBYTE) ((block[i] >> 8) + POKEYSND_SAMP_MID);
+		sndn -= n;
+	}
+}
+
 #ifdef SERIO_SOUND
 static void Update_serio_sound_rf(int out, UBYTE data)
 {
@@ -1291,18 +1077,6 @@ void POKEYSND_SetVolume(int vol)
     POKEYSND_volume = vol * 0x100 / 100;
 }
 
-static void pokeysnd_process_16(void *sndbuffer, int sndn)
-{
-	UWORD *buffer = (UWORD *) sndbuffer;
-	pokeysnd_process_8(buffer, sndn);
-	for (int i = sndn - 1; i >= 0; i--) {
-        int n = (((UBYTE*)buffer)[i]) * POKEYSND_volume;
-        if (n > 32767)
-            n = 32767;
-		buffer[i] = n;    // 16 bit signed
-	}
-}
-
 #ifdef SYNCHRONIZED_SOUND
 static void Generate_sync_rf(unsigned int num_ticks)
 {
@@ -1359,8 +1133,6 @@ static void Update_consol_sound_rf(int set)
 	if (set)
 		speaker = CONSOLE_VOL * GTIA_speaker;
 #elif defined(VOL_ONLY_SOUND)
-	static int prev_atari_speaker = 0;
-	static unsigned int prev_cpu_clock = 0;
 	int d;
 #ifdef __PLUS
 	if (!g_Sound.nDigitized)
@@ -71,7 +71,7 @@ static int image_type[SIO_MAX_DRIVES];
 #define IMAGE_TYPE_ATR  1
 #define IMAGE_TYPE_PRO  2
 #define IMAGE_TYPE_VAPI 3
-static FILE *disk[SIO_MAX_DRIVES] = { NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL };
+static FILE *disk[SIO_MAX_DRIVES] = { NULL };
 static int sectorcount[SIO_MAX_DRIVES];
 static int sectorsize[SIO_MAX_DRIVES];
 /* these two are used by the 1450XLD parallel disk device */
@@ -1700,11 +1700,19 @@ void SIO_StateRead(void)
 		char filename[FILENAME_MAX];
 
 		StateSav_ReadINT(&saved_drive_status, 1);
-		SIO_drive_status[i] = (SIO_UnitStatus)saved_drive_status;
 
 		StateSav_ReadFNAME(filename);
-		if (filename[0] == 0)
+		if (filename[0] == 0) {
+			SIO_drive_status[i] = (SIO_UnitStatus)saved_drive_status;
 			continue;
+		}
+
+		/* Same disk still mounted the same way, keep it (in memory states
+		   are loaded every frame when rewinding) */
+		if (SIO_drive_status[i] == (SIO_UnitStatus)saved_drive_status
+		 && StateSav_SameFNAME(SIO_filename[i], filename))
+			continue;
+		SIO_drive_status[i] = (SIO_UnitStatus)saved_drive_status;
 
 		/* If the disk drive wasn't empty or off when saved,
 		   mount the disk */
@@ -321,6 +321,21 @@ void StateSav_SaveFNAME(const char *filename)
 	StateSav_SaveUBYTE((const UBYTE *) filename, namelen);
 }
 
+/* TRUE if current names the same file as a name read back by StateSav_ReadFNAME,
+   so loading a state can keep media that is already mounted */
+int StateSav_SameFNAME(const char *current, const char *saved)
+{
+#ifdef HAVE_GETCWD
+	char dirname[FILENAME_MAX]="";
+
+	if (getcwd(dirname, FILENAME_MAX) != NULL) {
+		if (strncmp(current, dirname, strlen(dirname)) == 0)
+			current += strlen(dirname) + 1;
+	}
+#endif
+	return strcmp(current, saved) == 0;
+}
+
 void StateSav_ReadFNAME(char *filename)
 {
 	UWORD namelen = 0;
@@ -496,7 +511,7 @@ int StateSav_ReadAtariState(const char *filename, const char *mode)
 		PBI_MIO_StateRead();
 #else
 		{
-			int local_mio_enabled;
+			int local_mio_enabled = FALSE;
 			StateSav_ReadINT(&local_mio_enabled,1);
 			if (local_mio_enabled) {
 				Log_print("Cannot read this state file because this version does not support MIO.");
@@ -510,7 +525,7 @@ int StateSav_ReadAtariState(const char *filename, const char *mode)
 		PBI_BB_StateRead();
 #else
 		{
-			int local_bb_enabled;
+			int local_bb_enabled = FALSE;
 			StateSav_ReadINT(&local_bb_enabled,1);
 			if (local_bb_enabled) {
 				Log_print("Cannot read this state file because this version does not support the Black Box.");
@@ -524,7 +539,7 @@ int StateSav_ReadAtariState(const char *filename, const char *mode)
 		PBI_XLD_StateRead();
 #else
 		{
-			int local_xld_enabled;
+			int local_xld_enabled = FALSE;
 			StateSav_ReadINT(&local_xld_enabled,1);
 			if (local_xld_enabled) {
 				Log_print("Cannot read this state file because this version does not support the 1400XL/1450XLD.");
@@ -660,7 +675,7 @@ static gzFile mem_open(const char *name, const char *mode)
 	plainmembuf = (char *)LIBATARI800_StateSav_buffer;
 	plainmemoff = 0; /*HDR_LEN;*/
 	unclen = STATESAV_MAX_SIZE;
-	return (gzFile) plainmembuf;
+	return (gzFile) &plainmembuf;  /* never dereferenced, just not NULL when measuring */
 }
 
 /* replacement for GZCLOSE */
@@ -689,7 +704,8 @@ static size_t mem_read(void *buf, size_t len, gzFile stream)
 static size_t mem_write(const void *buf, size_t len, gzFile stream)
 {
 	if (plainmemoff + len > unclen) return 0;  /* shouldn't happen */
-	memcpy(plainmembuf + plainmemoff, buf, len);
+	if (plainmembuf != NULL)  /* NULL buffer just measures the state */
+		memcpy(plainmembuf + plainmemoff, buf, len);
 	plainmemoff += len;
 	return len;
 }
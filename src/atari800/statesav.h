@@ -16,6 +16,7 @@ void StateSav_ReadUBYTE(UBYTE *data, int num);
 void StateSav_ReadUWORD(UWORD *data, int num);
 void StateSav_ReadINT(int *data, int num);
 void StateSav_ReadFNAME(char *filename);
+int StateSav_SameFNAME(const char *current, const char *saved);
 
 #ifdef LIBATARI800
 ULONG StateSav_Tell(void);
@@ -223,7 +223,7 @@ FILE* mkfile(const char* path)
 
 #else
 #include <sys/stat.h>
-#include "../miniz.h"
+#include "miniz.h"     // tinfl shim, see host/miniz.h
 
 uint8_t* map_file(const char* path, int len)
 {
@@ -240,8 +240,9 @@ void unmap_file(uint8_t* ptr)
 FILE* mkfile(const char* path)
 {
     std::string v = path;
-    std::string dir = v.substr(0,v.find_last_of("/"));
-    mkdir(dir.c_str(), 0755);
+    size_t slash = v.find_last_of("/");
+    if (slash != std::string::npos)    // bare file names go in the current directory
+        mkdir(v.substr(0,slash).c_str(), 0755);
     return fopen(path,"wb");
 }
 
@@ -277,7 +278,7 @@ int unpack(const char* dst, const uint8_t* d, int len)
 
     tinfl_decompressor* dec = new tinfl_decompressor;   // largist
     size_t in_bytes, out_bytes;
-    tinfl_status status;
+    tinfl_status status = TINFL_STATUS_DONE;
     int i = 0;
 
     tinfl_init(dec);
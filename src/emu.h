@@ -38,6 +38,8 @@
 
 extern "C"
 void* MALLOC32(int size, const char* name);
+extern "C"
+void* MALLOC32_TRY(int size, const char* name);     // 0 rather than a restart if there is no room
 
 class Emu {
 public:
@@ -111,10 +113,20 @@ public:
     virtual void hid(const uint8_t* d, int len) {};
     virtual void key(int keycode, int pressed, int mod) {};
 
-    virtual int update() = 0;
+    virtual int update(bool draw = true) = 0;    // draw false runs a frame without rendering it
     virtual uint8_t** video_buffer() = 0;
     virtual int audio_buffer(int16_t* b, int max_len) = 0;
 
+    // machine state snapshot in a caller owned (4 byte aligned) buffer, no file i/o
+    // only valid for this run of this emulator; returns bytes used or -1
+    virtual int state_size() { return 0; };     // buffer size needed by save_state, 0 if unsupported
+    virtual int save_state(uint8_t* buf) { return -1; };
+    virtual int load_state(const uint8_t* buf) { return -1; };
+
+    // anything a cold boot took from the outside world, read straight after insert()
+    virtual uint32_t boot_seed() { return 0; };
+    virtual void set_boot_seed(uint32_t seed) {};
+
     virtual const uint32_t* ntsc_palette() { return NULL; };
     virtual const uint32_t* pal_palette() { return NULL; };
     virtual const uint32_t* rgb_palette() { return NULL; };
@@ -123,7 +135,7 @@ public:
 
 void gui_start(Emu* emu, const char* path);
 void gui_hid(const uint8_t* hid, int len);  // Parse HID event
-void gui_update();
+void gui_update(bool draw = true);     // draw false runs the emulator and audio without rendering
 void gui_key(int keycode, int pressed, int mod);
 
 extern "C"
@@ -137,6 +149,9 @@ extern "C" FILE* mkfile(const char* path);
 extern "C" int unpack(const char* dst_path, const uint8_t* d, int len);
 
 void audio_write_16(const int16_t* s, int len, int channels);
+void video_queue(bool on);             // start of a frame, see LINE_QUEUE
+void video_hashes(int i, uint8_t** lines, uint32_t* hashes);  // per line ids of frame buffer i, equal ids are equal pixels
+void video_dirty();                     // something drew over the frame buffers
 int get_hid_ir(uint8_t* dst);
 uint32_t generic_map(uint32_t m, const uint32_t* target);
 
@@ -21,6 +21,8 @@
 
 extern "C" {
 #include "atari800/libatari800.h"
+#include "atari800/libatari800_statesav.h"
+#include "atari800/pokey.h"
 #include "atari800/sound.h"
 #include "atari800/akey.h"
 #include "atari800/memory.h"
@@ -153,18 +155,6 @@ static void make_atari_4_phase_pal(const uint16_t* lum, const float* angle)
     printf("};\n");
 }
 
-static int PIN(int x)
-{
-    if (x < 0) return 0;
-    if (x > 255) return 255;
-    return x;
-}
-
-static uint32_t rgb(int r, int g, int b)
-{
-    return (PIN(r) << 16) | (PIN(g) << 8) | PIN(b);
-}
-
 // lifted from atari800
 static void make_atari_rgb_palette(uint32_t* palette)
 {
@@ -182,7 +172,6 @@ static void make_atari_rgb_palette(uint32_t* palette)
         0.8260, 0.8470, 0.8700, 0.8930,
         0.9160, 0.9420, 0.9690, 1.0000};
 
-    uint32_t linear[256];
     uint16_t _lum[16];
     float _angle[16];
 
@@ -206,7 +195,6 @@ static void make_atari_rgb_palette(uint32_t* palette)
             float r = (y +  0.946882*i +  0.623557*q);
             float g = (y + -0.274788*i + -0.635691*q);
             float b = (y + -1.108545*i +  1.709007*q);
-            linear[(cr << 4) | lm] = rgb(r*255,g*255,b*255);
             palette[(cr << 4) | lm] = (gamma_(r,gmma) << 16) | (gamma_(g,gmma) << 8) | (gamma_(b,gmma) << 0);
         }
     }
@@ -229,12 +217,6 @@ static void atari_palette(float start_angle = 0)
 {
     float color_diff = 28.6 * M_PI / 180.0;
     int cr, lm;
-    float luma_mult[16]={
-        0.6941, 0.7091, 0.7241, 0.7401,
-        0.7560, 0.7741, 0.7931, 0.8121,
-        0.8260, 0.8470, 0.8700, 0.8930,
-        0.9160, 0.9420, 0.9690, 1.0000};
-
     int i = 0;
     uint32_t pal[256];
     printf("const uint32_t atari_4_phase_ntsc[256] = {\n");
@@ -242,7 +224,6 @@ static void atari_palette(float start_angle = 0)
         float angle = start_angle + ((15-cr) - 1) * color_diff;
 
         for (lm = 0; lm < 16; lm ++) {
-            //double y = luma_mult[lm]*lm*(WHITE_LEVEL-BLACK_LEVEL)/15 + BLACK_LEVEL;
             double y = lm*(WHITE_LEVEL-BLACK_LEVEL)/15 + BLACK_LEVEL;
             int p[4];
             for (int j = 0; j < 4; j++)
@@ -761,7 +742,7 @@ public:
     {
         _type = 1;
         _secsize = 128;
-        while (trackoffset > 0 && trackoffset < _len) {
+        while (trackoffset > 0 && trackoffset < (int)_len) {
             uint8_t t[32+8];
             if (read(t,trackoffset,sizeof(t)) != sizeof(t))
                 return -1;
@@ -810,7 +791,7 @@ public:
 
         if (_type == 1) {
             int track = n/18;
-            for (int i = 0; i < _tracks.size(); i++) {
+            for (int i = 0; i < (int)_tracks.size(); i++) {
                 if (_tracks[i].tracknum == track) {
                     auto& t = _tracks[i];
                     int dat = t.toff[n % 18];
@@ -934,7 +915,7 @@ extern uint8_t* under_cartA0BF;
 
 Sound_setup_t Sound_desired = {
     15720,
-    1,  // 8 bit
+    2,  // 16 bit
     1,  // 1 channel
     0,
     0
@@ -942,10 +923,15 @@ Sound_setup_t Sound_desired = {
 
 class EmuAtari800 : public Emu {
     uint8_t** _lines;
+    ULONG* _frames[2];      // front and back, _frames[1] is null if there was no room
+    uint8_t** _frame_lines[2];
+    int _back;
 public:
     EmuAtari800(int ntsc) : Emu("atari800",384,240,ntsc,(16 | (1 << 8)),4,EMU_ATARI)
     {
         _lines = 0;
+        _frames[0] = _frames[1] = 0;
+        _back = 0;
         _ext = _atari_ext;
         _help = _atari_help;
         Sound_desired.freq = audio_frequency;
@@ -1158,12 +1144,20 @@ public:
     {
         Screen_atari = (ULONG*)MALLOC32(Screen_WIDTH*Screen_HEIGHT,"Screen_atari");    // 32 bit access plz
         MEMORY_mem = (uint8_t*)MALLOC32(64*1024 + 4,"MEMORY_mem");
-        _lines = (uint8_t**)MALLOC32(height*sizeof(uint8_t*),"_lines");
-        const uint8_t* s = (uint8_t*)Screen_atari;
-        for (int y = 0; y < height; y++) {
-            _lines[y] = (uint8_t*)s;
-            s += width;
+        _frames[0] = Screen_atari;
+        _frames[1] = (ULONG*)MALLOC32_TRY(Screen_WIDTH*Screen_HEIGHT,"Screen_back");   // back buffer if there is room
+        for (int i = 0; i < 2; i++) {
+            _frame_lines[i] = 0;
+            if (!_frames[i])
+                continue;
+            _frame_lines[i] = (uint8_t**)MALLOC32(height*sizeof(uint8_t*),"_lines");
+            const uint8_t* s = (uint8_t*)_frames[i];
+            for (int y = 0; y < height; y++) {
+                _frame_lines[i][y] = (uint8_t*)s;
+                s += width;
+            }
         }
+        _lines = _frame_lines[0];
         under_atarixl_os = (uint8_t*)MALLOC32(16*1024,"under_atarixl_os");
         under_cart809F = (uint8_t*)MALLOC32(8*1024,"under_cart809F");
         under_cartA0BF = (uint8_t*)MALLOC32(8*1024,"under_cartA0BF");
@@ -1172,9 +1166,13 @@ public:
 
     void clear_screen()
     {
-        int i = Screen_WIDTH*Screen_HEIGHT/4;
-        while (i--)
-            Screen_atari[i] = 0;
+        for (int f = 0; f < 2; f++) {
+            if (!_frames[f])
+                continue;
+            int i = Screen_WIDTH*Screen_HEIGHT/4;
+            while (i--)
+                _frames[f][i] = 0;
+        }
     }
 
     int parse_cfg(const string& str, vector<string>& s, vector<char*>& argv)
@@ -1217,9 +1215,9 @@ public:
     string patch_cfg(const string& cfg, int mods)
     {
         string c = cfg;
-        if (c.find("-ntsc") == -1 && c.find("-pal") == -1)
+        if (c.find("-ntsc") == string::npos && c.find("-pal") == string::npos)
             c += tv_standard();
-        if (c.find("-basic") == -1 && c.find("-nobasic") == -1)
+        if (c.find("-basic") == string::npos && c.find("-nobasic") == string::npos)
             c += (mods & 2) ? " -basic" : " -nobasic"; // insert on shift key
         return c;
     }
@@ -1282,7 +1280,7 @@ public:
         unpack((path + "/gtia_blast.xex").c_str(),gtia_blast_xex,sizeof(gtia_blast_xex));
         unpack((path + "/runner_bear.xex").c_str(),runner_bear_xex,sizeof(runner_bear_xex));
         unpack((path + "/yoomp_nt.xex").c_str(),yoomp_nt_xex,sizeof(yoomp_nt_xex));
-        unpack((path + "/raymaze_2000_ntsc.xex").c_str(),yoomp_nt_xex,sizeof(yoomp_nt_xex));
+        unpack((path + "/raymaze_2000_ntsc.xex").c_str(),raymaze_2000_ntsc_xex,sizeof(raymaze_2000_ntsc_xex));
         unpack((path + "/gravity_worms.atr").c_str(),gravity_worms_atr,sizeof(gravity_worms_atr));
         unpack((path + "/wasteland.atr").c_str(),wasteland_atr,sizeof(wasteland_atr));
         unpack((path + "/star_raiders_II.atr").c_str(),star_raiders_II_atr,sizeof(star_raiders_II_atr));
@@ -1315,9 +1313,58 @@ public:
         return 0;
     }
 
-    virtual int update()
+    virtual int update(bool draw)
     {
-        return libatari800_next_frame(NULL);
+        libatari800_draw_display = draw;
+        int r = libatari800_next_frame(NULL);
+        if (!draw)
+            return r;                       // still showing the last frame drawn
+        _lines = _frame_lines[_back];   // done, ANTIC draws the next one into the other buffer
+        if (_frames[1]) {
+            _back ^= 1;
+            Screen_atari = _frames[_back];
+        }
+        return r;
+    }
+
+    // libatari800 states are written through the statesav mem_ hooks, a NULL buffer just measures
+    // the POKEY random counter is not part of that format so it rides along at the end
+    virtual int state_size()
+    {
+        statesav_tags_t tags;
+        LIBATARI800_StateSave(NULL,&tags);
+        return ((tags.size + 3) & ~3) + 4;
+    }
+
+    virtual int save_state(uint8_t* buf)
+    {
+        statesav_tags_t tags;
+        LIBATARI800_StateSave(buf,&tags);
+        int n = (tags.size + 3) & ~3;
+        ULONG r = POKEY_GetRandomCounter();
+        memcpy(buf + n,&r,4);
+        return n + 4;
+    }
+
+    virtual int load_state(const uint8_t* buf)
+    {
+        LIBATARI800_StateLoad((UBYTE*)buf);    // only reads
+        int n = (StateSav_Tell() + 3) & ~3;
+        ULONG r;
+        memcpy(&r,buf + n,4);
+        POKEY_SetRandomCounter(r);
+        return n + 4;
+    }
+
+    // POKEY seeds RANDOM from the clock at power on
+    virtual uint32_t boot_seed()
+    {
+        return POKEY_GetRandomCounter();
+    }
+
+    virtual void set_boot_seed(uint32_t seed)
+    {
+        POKEY_SetRandomCounter(seed);
     }
 
     virtual uint8_t** video_buffer()
@@ -1328,12 +1375,7 @@ public:
     virtual int audio_buffer(int16_t* b, int len)
     {
         int n = frame_sample_count();
-        Sound_Callback((uint8_t*)b,n);      // in bytes
-        uint8_t* b8 = (uint8_t*)b;
-        for (int i = n-1; i >= 0; i--) {
-            int s16 = (b8[i] ^ 0x80) << 8;
-            b[i] = s16;
-        }
+        Sound_Callback((uint8_t*)b,n*2);    // in bytes, POKEY renders signed 16 bit mono
         return n;
     }
 
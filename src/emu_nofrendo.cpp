@@ -195,6 +195,10 @@ int nes_emulate_init(const char* path, int width, int height);
 extern "C"
 uint8_t** nes_emulate_frame(bool draw_flag);
 
+extern "C" int state_size(void);
+extern "C" int state_save_mem(uint8_t* buf);
+extern "C" int state_load_mem(const uint8_t* buf);
+
 static void (*nes_sound_cb)(void *buffer, int length) = 0;
 
 extern uint32_t nes_pal[256];
@@ -226,7 +230,7 @@ extern "C"
 void osd_getsoundinfo(sndinfo_t *info)
 {
     info->sample_rate = _audio_frequency;
-    info->bps = 8;
+    info->bps = 16;
 }
 
 extern "C"
@@ -477,13 +481,28 @@ public:
         return 0;
     }
 
-    virtual int update()
+    virtual int update(bool draw)
     {
         if (_nofrendo_rom)
-            _lines = nes_emulate_frame(true);
+            _lines = nes_emulate_frame(draw);
         return 0;
     }
 
+    virtual int state_size()
+    {
+        return _nofrendo_rom ? ::state_size() : 0;
+    }
+
+    virtual int save_state(uint8_t* buf)
+    {
+        return _nofrendo_rom ? state_save_mem(buf) : -1;
+    }
+
+    virtual int load_state(const uint8_t* buf)
+    {
+        return _nofrendo_rom ? state_load_mem(buf) : -1;
+    }
+
     virtual uint8_t** video_buffer()
     {
         return _lines;
@@ -492,12 +511,8 @@ public:
     virtual int audio_buffer(int16_t* b, int len)
     {
         int n = frame_sample_count();
-        if (nes_sound_cb) {
-            nes_sound_cb(b,n);  // 8 bit unsigned
-            uint8_t* b8 = (uint8_t*)b;
-            for (int i = n-1; i >= 0; i--)
-                b[i] = (b8[i] ^ 0x80) << 8;  // turn it back into signed 16
-        }
+        if (nes_sound_cb)
+            nes_sound_cb(b,n);  // signed 16 bit, mixed by the apu
         else
             memset(b,0,2*n);
         return n;
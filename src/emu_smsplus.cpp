@@ -200,7 +200,6 @@ void make_yuv_palette(const char* name, const uint32_t* pal, int len);
 static void gen_ntsc_pal_tables()
 {
     uint32_t rgb[256];
-    float yuv_rotation = 2*M_PI*33/360; // 33 degree rotation
 
     printf("uint32_t sms_4_phase[256] = {\n");
     int cc_width = 4;
@@ -217,12 +216,12 @@ static void gen_ntsc_pal_tables()
 
         float y, ii, q = RGB_TO_YIQ( r, g, b, y, ii );
         float phase = atan2(ii,q);
-        float phase_yuv = phase + yuv_rotation;
         float saturation = sqrt(ii*ii + q*q)/127;    // <== this is somewhat ad hoc TODO
         float offset = 2*M_PI*2/3;  // 270 deg
 
         /*
         // yuv 2 ways: rotation of YIQ or derived from RGB
+        float phase_yuv = phase + 2*M_PI*33/360;    // 33 degree rotation
         uint8_t u = 0.493*(b - y)*63;
         uint8_t v = 0.877*(r - y)*63;
         float uu = cos(phase_yuv)*saturation*63;
@@ -310,15 +309,35 @@ const char* _sms_help[] = {
 std::string to_string(int i);
 class EmuSMSPlus : public Emu {
     uint8_t** _lines;
+    uint8_t* _frames[2];    // front and back, _frames[1] is null if there was no room
+    uint8_t** _frame_lines[2];
+    uint32_t* _frame_hash[2];   // per line ids, lets the blit skip lines it already has
+    int _back;
+
+    // the 24 lines above and below the bitmap are always black, odd id so it never meets one from render_line
+    void border_hashes(uint32_t* h)
+    {
+        for (int y = 0; y < 24; y++)
+            h[y] = h[216+y] = 0xB1AC0001;
+    }
 public:
     EmuSMSPlus(int ntsc) : Emu("smsplus",256,240,ntsc,(16 | (1 << 8)),4,EMU_SMS)    // audio is 16bit
     {
         _lines = 0;
+        _frames[0] = _frames[1] = 0;
+        _frame_hash[0] = _frame_hash[1] = 0;
+        _back = 0;
         cart.rom = 0;
         _ext = _sms_ext;
         _help = _sms_help;
     }
 
+    virtual ~EmuSMSPlus()
+    {
+        video_hashes(0,0,0);
+        video_hashes(1,0,0);
+    }
+
     virtual void gen_palettes()
     {
         gen_rgb_palette();
@@ -346,6 +365,8 @@ public:
     {
         printf("init_screen\n");
         sms_videodata = new uint8_t[256*240];
+        _frames[0] = sms_videodata;
+        _frames[1] = new (std::nothrow) uint8_t[256*240];  // back buffer
         bitmap.data = sms_videodata + 24*256;
         bitmap.width = 256;
         bitmap.height = 192;
@@ -355,19 +376,32 @@ public:
         sms.sram = sms_sram;
 
         // center on 240?
-        _lines = new uint8_t*[240];
-        const uint8_t* s = sms_videodata;
-        for (int y = 0; y < 240; y++) {
-            _lines[y] = (uint8_t*)s;
-            s += 256;
+        for (int i = 0; i < 2; i++) {
+            _frame_lines[i] = 0;
+            if (!_frames[i])
+                continue;
+            _frame_lines[i] = new uint8_t*[240];
+            const uint8_t* s = _frames[i];
+            for (int y = 0; y < 240; y++) {
+                _frame_lines[i][y] = (uint8_t*)s;
+                s += 256;
+            }
+            _frame_hash[i] = new uint32_t[240];
+            video_hashes(i,_frame_lines[i],_frame_hash[i]);
         }
+        _lines = _frame_lines[0];
+        bitmap.hash = _frame_hash[0] + 24;
         clear_screen();
     }
 
     void clear_screen()
     {
-        if (sms_videodata)
-            memset(sms_videodata,0,256*240);
+        for (int i = 0; i < 2; i++) {
+            if (_frames[i]) {
+                memset(_frames[i],0,256*240);
+                memset(_frame_hash[i],0,240*sizeof(uint32_t));
+            }
+        }
     }
 
     virtual int insert(const std::string& path, int flags, int disk_index)
@@ -388,6 +422,7 @@ public:
         cart.rom = _smsplus_rom;
         cart.type = get_ext(path) == "sms" ? TYPE_SMS : TYPE_GG;
 
+        memset(sms_sram,0,sizeof(sms_sram));   // not kept between carts, so a cold boot is the same every time
         emu_system_init(audio_frequency);
         sms_init();
         return 0;
@@ -516,39 +551,50 @@ public:
         }
     }
             
-    virtual int update()
+    virtual int update(bool draw)
     {
-        if (_smsplus_rom)
-            sms_frame(0);
+        if (_smsplus_rom) {
+            sms_frame(!draw);
+            if (!draw)
+                return 0;                   // still showing the last frame drawn
+            _lines = _frame_lines[_back];   // done, draw the next one into the other buffer
+            border_hashes(_frame_hash[_back]);
+            if (_frames[1]) {
+                _back ^= 1;
+                bitmap.data = _frames[_back] + 24*256;
+                bitmap.hash = _frame_hash[_back] + 24;
+            }
+        }
         return 0;
     }
 
-    virtual uint8_t** video_buffer()
+    virtual int state_size()
     {
-        return _lines;
+        return _smsplus_rom ? system_state_size() : 0;
+    }
+
+    virtual int save_state(uint8_t* buf)
+    {
+        return _smsplus_rom ? system_save_state_mem(buf) : -1;
+    }
+
+    virtual int load_state(const uint8_t* buf)
+    {
+        return _smsplus_rom ? system_load_state_mem(buf) : -1;
     }
 
-    static int16_t S16(int i)
+    virtual uint8_t** video_buffer()
     {
-        return (i << 1) ^ 0x8000;
+        return _lines;
     }
 
-    int _lp;
     virtual int audio_buffer(int16_t* b, int len)
     {
         int n = frame_sample_count();
-        for (int i = 0; i < n; i++) {
-            /*
-            *b++ = S16(snd.buffer[0][i]);        // produces +ve only samples 0..32767
-            *b++ = S16(snd.buffer[1][i]);
-            */
-            int s = (snd.buffer[0][i] + snd.buffer[1][i]) >> 1;
-            _lp = (_lp*31 + s) >> 5;    // lo pass
-            s -= _lp;                   // signed
-            if (s < -32767) s = -32767; // clip
-            if (s > 32767) s = 32767;
-            *b++ = s;                   // centered signed 1 channel
-        }
+        if (snd.enabled)
+            SN76496UpdateMono(0,b,n,sms.psg_mask);  // centered signed 1 channel
+        else
+            memset(b,0,2*n);
         return n;
     }
 
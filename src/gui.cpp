@@ -16,6 +16,9 @@
 */
 
 #include "emu.h"
+#include "profile.h"
+#include "rewind.h"
+#include "movie.h"
 
 using namespace std;
 
@@ -326,7 +329,7 @@ public:
     int OVERLAY_WIDTH;
     int OVERLAY_HEIGHT;
 
-    Overlay() : _hilite(0),_buf(0)
+    Overlay() : _buf(0),_hilite(0)
     {
     }
 
@@ -405,6 +408,27 @@ public:
         }
     }
 
+    // PERF zones top left, average and worst us over the last PROF_FRAMES frames
+    void draw_perf()
+    {
+        char buf[32];
+        int x = (_width-256)/16 + 1;
+        for (int z = 0; z < PROF_ZONES; z++) {
+            uint32_t avg,m;
+            prof_stats(z,&avg,&m);
+            sprintf(buf,"%-5s%6d%6d",prof_name(z),avg,m);
+            for (int i = 0; buf[i]; i++)
+                draw_char(buf[i],x+i,z+1);
+        }
+        for (int c = 0; c < PROF_COUNTERS; c++) {
+            uint32_t avg,m;
+            prof_count_stats(c,&avg,&m);
+            sprintf(buf,"%-5s%6d%6d",prof_count_name(c),avg,m);
+            for (int i = 0; buf[i]; i++)
+                draw_char(buf[i],x+i,PROF_ZONES+c+1);
+        }
+    }
+
     void erase_msg()
     {
         for (int i = _height-16; i < _height-8; i++)
@@ -552,9 +576,21 @@ public:
 
     string _msg;
     uint32_t _msg_ticks;
-
-    GUI() : _active(0),_hilited(0),_tab(0),_visible(0),_dirty(true),_click(0),_emu(0)
+    bool _perf;
+    int _ff;                // fast forward, index into _ff_frames
+    Rewind _rewind;
+    bool _rewinding;        // F10 held
+    Movie _movie;
+    string _media;          // what a cold boot movie reinserts
+    int _media_flags;
+
+    GUI() : _active(0),_hilited(0),_tab(0),_visible(0),_dirty(true),_click(0),_emu(0),_ff(0),_rewinding(false),_media_flags(1)
     {
+#ifdef PERF
+        _perf = true;
+#else
+        _perf = false;
+#endif
         _disks[0] = _disks[1] = -1;
         _tab_hilited[0] = _tab_hilited[1] = _tab_hilited[2] = 0;
         _tab_scroll[0] = _tab_scroll[1] = _tab_scroll[2] = 0;
@@ -664,6 +700,9 @@ public:
     {
         set_pref("recent",path);
         _emu->insert(_path + "/" + path,flags);
+        _rewind.reset();
+        _media = path;
+        _media_flags = flags;
     }
 
     void insert_disk(int dindex, int findex, int reboot = 0)
@@ -675,6 +714,11 @@ public:
         if (dindex == 0)
             set_pref("recent",file);
         _emu->insert(_path + "/" + file,reboot,dindex);
+        _rewind.reset();
+        if (dindex == 0 && (reboot & 1)) {
+            _media = file;
+            _media_flags = reboot;
+        }
     }
 
     void enter(int mods)
@@ -710,7 +754,7 @@ public:
 
     int find_file(const string& file)
     {
-        for (auto i = 0; i < _files.size(); i++) {
+        for (int i = 0; i < (int)_files.size(); i++) {
             if (_files[i] == file)
                 return i;
         }
@@ -753,6 +797,25 @@ public:
             _click = 1;
             return true;
         }
+        if (pressed && keycode == 66) { // F9 - movies
+            movie(mods);
+            return true;
+        }
+        if (keycode == 67) {            // F10 - rewind while held, not while a movie runs
+            _rewinding = pressed && !_movie.recording() && !_movie.playing();
+            return true;
+        }
+        if (pressed && keycode == 68) { // F11 - fast forward
+            _ff = (_ff + 1) % 4;
+            msg(_ff_names[_ff]);
+            return true;
+        }
+#ifdef PERF
+        if (pressed && keycode == 69) { // F12 - PERF hud
+            _perf = !_perf;
+            return true;
+        }
+#endif
         if (!_visible)
             return false;
 
@@ -867,7 +930,7 @@ public:
         for (i = 0; i < (int)_files.size(); i++) {
             string c = _files[i];
             int w = _overlay->OVERLAY_WIDTH-2;
-            if (c.length() > w)
+            if ((int)c.length() > w)
                 c.resize(w);
             draw_item(i,c.c_str(),i == _hilited);
             draw_disk(i);
@@ -940,9 +1003,55 @@ public:
         }
     }
 
-    void update_video()
+    // F9 records from a cold boot of the current media, shift+F9 from the current frame
+    // and alt+F9 plays back what was recorded. F9 again stops. Movies sit next to the media
+    void movie(int mods)
     {
+        string path = _path + "/" + _media + ".e8m";
+        if (_movie.recording()) {
+            _movie.stop();
+            msg(_movie.save(path) == 0 ? "Movie saved" : "Movie not saved");
+        } else if (_movie.playing()) {
+            _movie.stop();
+            msg("Movie stopped");
+        } else if (mods & KEY_MOD_ALT) {
+            bool ok = _movie.load(path) == 0;
+            if (ok && _movie.cold_boot())
+                _emu->insert(_movie.media,_movie.flags);
+            ok = ok && _movie.play(_emu) == 0;
+            _rewind.reset();
+            msg(ok ? "Playing movie" : "No movie to play");
+        } else if (!_media.empty()) {
+            bool here = mods & KEY_MOD_SHIFT;
+            if (!here)
+                _emu->insert(_path + "/" + _media,_media_flags);
+            _movie.record(_emu,_path + "/" + _media,_media_flags,here);
+            _rewind.reset();
+            _rewinding = false;
+            msg("Recording movie");
+        }
+    }
+
+    // every emulated frame goes through here so movies can count them
+    void run(bool draw = true)
+    {
+        if (!_movie.frame(_emu))
+            msg("Movie ended");
+        _emu->update(draw);
+    }
+
+    void update_video(bool draw)
+    {
+        if (!draw && !_visible) {
+            if (!(_rewinding && _rewind.pop(_emu)))
+                _rewind.push(_emu);
+            run(false);             // frameskip, what is on screen stays there
+            return;
+        }
+
+        bool overlay = _visible || _perf || _msg.size();
         if (_visible) {
+            PROF_ENTER(PROF_GUI);
             menu();
             scrollbar();
             switch (_tab) {
@@ -951,20 +1060,44 @@ public:
                 case 2: draw_help(); break;
             }
             _overlay->update();
+            PROF_LEAVE();
         } else {
-            _emu->update();
+            video_queue(!_perf && _msg.empty() && !_ff);    // lines go out before the overlay is drawn
+            if (_rewinding && _rewind.pop(_emu)) {
+                run();                              // show the frame we backed up to
+            } else {
+                _rewind.push(_emu);
+                for (int i = 1; i < _ff_frames[_ff]; i++) {
+                    run(false);                     // fast forward, only the last frame is drawn
+                    int16_t abuffer[313*2];         // and only its audio is heard
+                    PROF_ZONE(PROF_AUDIO,_emu->audio_buffer(abuffer,sizeof(abuffer)));
+                }
+                run();
+            }
+            _overlay->_lines = _emu->video_buffer();   // frame just drawn, not yet on the front
+            if (_perf)
+                PROF_ZONE(PROF_GUI,_overlay->draw_perf());
         }
 
         // message goes over both
         if (_msg.size()) {
-            if (--_msg_ticks == 0) {
-                _overlay->erase_msg();
-                _msg.clear();
+            PROF_ENTER(PROF_GUI);
+            if (--_msg_ticks <= 1) {
+                _overlay->erase_msg();          // from both front and back buffers
+                if (_msg_ticks == 0)
+                    _msg.clear();
             } else
                 _overlay->draw_msg(_msg);
+            PROF_LEAVE();
         }
+        if (overlay)
+            video_dirty();          // frame buffers no longer match the cores' line ids
     }
 
+    // emulated frames per displayed frame, 16 is more than any core can run in one so max is flat out
+    const int _ff_frames[4] = { 1, 2, 4, 16 };
+    const char* _ff_names[4] = { "Normal speed", "Fast forward 2x", "Fast forward 4x", "Fast forward max" };
+
     // soft click wave soundy thing
     const uint16_t _wav[16] =  {
         0x0000,0x187D,0x2D41,0x3B20,0x3FFF,0x3B20,0x2D41,0x187D,
@@ -986,6 +1119,8 @@ public:
               memset(abuffer,0,sizeof(abuffer));
         } else {
             sample_count = _emu->audio_buffer(abuffer,sizeof(abuffer));
+            if (_rewinding)
+                memset(abuffer,0,sizeof(abuffer));  // backwards frames played forwards are just noise
         }
         audio_write_16(abuffer,sample_count,format);
     }
@@ -1001,11 +1136,12 @@ void gui_start(Emu* emu, const char* path)
     _overlay.init(emu->video_buffer(),emu->width,emu->height,emu->flavor);
 }
 
-void gui_update()
+void gui_update(bool draw)
 {
-    _gui.update_audio();
-    _gui.update_video();
+    PROF_ZONE(PROF_AUDIO,_gui.update_audio());
+    _gui.update_video(draw);
 
+    PROF_ENTER(PROF_HID);
     uint8_t buf[64];
     int n = hid_get(buf,sizeof(buf));    // called from emulation loop
     if (n > 0)
@@ -1014,12 +1150,15 @@ void gui_update()
     n = get_hid_ir(buf);
     if (n > 0)
         gui_hid(buf,n);
+    PROF_LEAVE();
 }
 
 void gui_key(int keycode, int pressed, int mods)
 {
-    if (!_gui.key(keycode,pressed,mods))
-        _gui._emu->key(keycode,pressed,mods);
+    if (_gui.key(keycode,pressed,mods) || _gui._movie.playing())
+        return;
+    _gui._movie.key(keycode,pressed,mods);
+    _gui._emu->key(keycode,pressed,mods);
 }
 
 //==================================================================
@@ -1097,6 +1236,9 @@ void gui_hid(const uint8_t* hid, int len)  // Parse HID event
         case 0x32: wii();                   break;   // parse wii stuff: generic?
         case 0x42: ir(hid+2,len);           break;   // ir joy
     }
+    if (_gui._movie.playing())
+        return;                     // the movie is driving
+    _gui._movie.pad(hid+1,len-1);
     _gui._emu->hid(hid+1,len-1);    // send raw events
 }
 
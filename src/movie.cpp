@@ -0,0 +1,219 @@
+/* Copyright (c) 2020, Peter Barrett
+**
+** Permission to use, copy, modify, and/or distribute this software for
+** any purpose with or without fee is hereby granted, provided that the
+** above copyright notice and this permission notice appear in all copies.
+**
+** THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+** WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+** WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR
+** BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES
+** OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+** WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+** ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+** SOFTWARE.
+*/
+
+#include <algorithm>
+#include "movie.h"
+
+#define MOVIE_VERSION   1
+#define MOVIE_STATE     1       // flags: starts from an embedded save state
+
+static void put32(std::vector<uint8_t>& v, uint32_t n)
+{
+    for (int i = 0; i < 4; i++)
+        v.push_back(n >> (i*8));
+}
+
+static void put_str(std::vector<uint8_t>& v, const std::string& s)
+{
+    v.push_back(s.size());
+    v.insert(v.end(),s.begin(),s.begin() + (s.size() & 0xFF));
+}
+
+static uint32_t get32(const uint8_t* d)
+{
+    return d[0] | (d[1] << 8) | (d[2] << 16) | (d[3] << 24);
+}
+
+Movie::Movie() : flags(0),frames(0),seed(0),_mode(IDLE),_frame(0),_last(0),_pos(0)
+{
+}
+
+void Movie::record(Emu* emu, const std::string& m, int f, bool from_state)
+{
+    name = emu->name;
+    media = m;
+    flags = f;
+    frames = _frame = _last = 0;
+    seed = from_state ? 0 : emu->boot_seed();
+    _log.clear();
+    _state.clear();
+    int size = from_state ? emu->state_size() : 0;
+    if (size > 0) {
+        _state.resize((size + 3) & ~3);
+        if (emu->save_state(&_state[0]) < 0)
+            _state.clear();
+    }
+    _mode = RECORDING;
+
+    // cores keep the last pad they saw outside their state, start the log from idle
+    uint8_t idle[5] = {0x42};
+    emu->hid(idle,sizeof(idle));
+    pad(idle,sizeof(idle));
+}
+
+// varint of frames since the previous event then the event
+void Movie::event(int type, const uint8_t* d, int len)
+{
+    uint32_t delta = _frame - _last;
+    _last = _frame;
+    while (delta >= 0x80) {
+        _log.push_back(delta | 0x80);
+        delta >>= 7;
+    }
+    _log.push_back(delta);
+    _log.push_back(type);
+    _log.insert(_log.end(),d,d + len);
+}
+
+void Movie::key(int keycode, int pressed, int mods)
+{
+    if (!recording())
+        return;
+    uint8_t d[3] = {(uint8_t)keycode,(uint8_t)pressed,(uint8_t)mods};
+    event('K',d,3);
+}
+
+void Movie::pad(const uint8_t* d, int len)
+{
+    if (!recording() || d[0] != 0x42)
+        return;
+    uint8_t p[4] = {0};
+    memcpy(p,d + 1,std::min(len - 1,4));      // two players of GENERIC_* masks
+    event('P',p,4);
+}
+
+void Movie::stop()
+{
+    _mode = IDLE;
+}
+
+int Movie::save(const std::string& path)
+{
+    std::vector<uint8_t> h = {'E','8','M','V',MOVIE_VERSION,(uint8_t)(_state.empty() ? 0 : MOVIE_STATE),(uint8_t)flags,0};
+    put32(h,frames);
+    put32(h,seed);
+    put_str(h,name);
+    put_str(h,media);
+    if (!_state.empty())
+        put32(h,_state.size());
+
+    FILE* f = mkfile(path.c_str());
+    if (!f)
+        return -1;
+    bool ok = fwrite(&h[0],1,h.size(),f) == h.size();
+    if (!_state.empty())
+        ok &= fwrite(&_state[0],1,_state.size(),f) == _state.size();
+    if (!_log.empty())
+        ok &= fwrite(&_log[0],1,_log.size(),f) == _log.size();
+    fclose(f);
+    return ok ? 0 : -1;
+}
+
+int Movie::load(const std::string& path)
+{
+    _mode = IDLE;
+    FILE* f = fopen(path.c_str(),"rb");
+    if (!f)
+        return -1;
+    std::vector<uint8_t> d;
+    uint8_t buf[1024];
+    int n;
+    while ((n = fread(buf,1,sizeof(buf),f)) > 0)
+        d.insert(d.end(),buf,buf + n);
+    fclose(f);
+
+    // fixed part, then the name and media strings
+    size_t i = 16;
+    if (d.size() < i + 2 || memcmp(&d[0],"E8MV",4) || d[4] != MOVIE_VERSION)
+        return -1;
+    flags = d[6];
+    frames = get32(&d[8]);
+    seed = get32(&d[12]);
+    name.assign((const char*)&d[i + 1],std::min<size_t>(d[i],d.size() - i - 1));
+    i += 1 + d[i];
+    if (i >= d.size())
+        return -1;
+    media.assign((const char*)&d[i + 1],std::min<size_t>(d[i],d.size() - i - 1));
+    i += 1 + d[i];
+
+    _state.clear();
+    if (d[5] & MOVIE_STATE) {
+        if (i + 4 > d.size() || get32(&d[i]) > d.size() - i - 4)
+            return -1;
+        _state.assign(d.begin() + i + 4,d.begin() + i + 4 + get32(&d[i]));
+        i += 4 + _state.size();
+    }
+    if (i > d.size())
+        return -1;
+    _log.assign(d.begin() + i,d.end());
+    return 0;
+}
+
+int Movie::play(Emu* emu)
+{
+    if (emu->name != name) {
+        printf("movie: recorded on %s not %s\n",name.c_str(),emu->name.c_str());
+        return -1;
+    }
+    if (_state.empty())
+        emu->set_boot_seed(seed);
+    else if (emu->load_state(&_state[0]) < 0)
+        return -1;
+    _frame = _last = 0;
+    _pos = 0;
+    _mode = PLAYING;
+    return 0;
+}
+
+// feed the core everything logged after the frame before this one
+bool Movie::frame(Emu* emu)
+{
+    if (!playing()) {
+        if (recording())
+            frames = ++_frame;
+        return true;
+    }
+    if (_frame >= frames) {
+        stop();
+        return false;
+    }
+    while (_pos < _log.size()) {
+        uint32_t delta = 0;
+        size_t p = _pos;
+        for (int shift = 0; p < _log.size(); shift += 7) {
+            delta |= (_log[p] & 0x7F) << shift;
+            if (!(_log[p++] & 0x80))
+                break;
+        }
+        if (_last + delta != (uint32_t)_frame || p + 1 > _log.size())
+            break;
+        int type = _log[p++];
+        int len = type == 'K' ? 3 : 4;
+        if (p + len > _log.size())
+            break;
+        const uint8_t* d = &_log[p];
+        if (type == 'K')
+            emu->key(d[0],d[1],d[2]);
+        else {
+            uint8_t r[5] = {0x42,d[0],d[1],d[2],d[3]};
+            emu->hid(r,sizeof(r));
+        }
+        _last = _frame;
+        _pos = p + len;
+    }
+    _frame++;
+    return true;
+}
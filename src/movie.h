@@ -0,0 +1,71 @@
+/* Copyright (c) 2020, Peter Barrett
+**
+** Permission to use, copy, modify, and/or distribute this software for
+** any purpose with or without fee is hereby granted, provided that the
+** above copyright notice and this permission notice appear in all copies.
+**
+** THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+** WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+** WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR
+** BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES
+** OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+** WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+** ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+** SOFTWARE.
+*/
+
+#ifndef movie_h
+#define movie_h
+
+#include "emu.h"
+
+// Input movies: everything the core was told, frame by frame, so a session can be
+// replayed bit exactly. Only input that is complete in itself is logged: keyboard
+// scancodes as Emu::key() gets them and the GENERIC_* pad masks of the 0x42 reports
+// Emu::hid() gets. Wii reports read wii_states behind the core's back and are not kept.
+//
+// A movie starts from a cold boot of its media or from a save_state embedded in it.
+// Save states hold pointers into this run's memory so those only replay in the run that
+// recorded them; cold boot movies replay anywhere, esp_8_bit_replay uses them on the host.
+//
+//  "E8MV" version flags insert_flags frames boot_seed name media [state_len state]
+//  then events to EOF: varint frames since the last event, 'K' keycode pressed mods | 'P' pad0 pad1
+
+class Movie {
+public:
+    Movie();
+
+    // cold boot: media was just inserted with flags; otherwise starts from the current frame
+    void record(Emu* emu, const std::string& media, int flags, bool from_state);
+    void key(int keycode, int pressed, int mods);
+    void pad(const uint8_t* d, int len);            // raw report as passed to Emu::hid()
+    void stop();
+
+    int save(const std::string& path);
+    int load(const std::string& path);              // -1 if not a movie
+    int play(Emu* emu);                             // straight after the caller inserts cold boot media, restores the start
+    bool frame(Emu* emu);                           // before each Emu::update(), false when playback is over
+
+    bool recording() const { return _mode == RECORDING; }
+    bool playing() const { return _mode == PLAYING; }
+    bool cold_boot() const { return _state.empty(); }
+
+    std::string name;                               // core that recorded it
+    std::string media;
+    int flags;                                      // for Emu::insert()
+    int frames;
+    uint32_t seed;                                  // Emu::boot_seed() of a cold boot
+
+private:
+    enum { IDLE, RECORDING, PLAYING };
+    void event(int type, const uint8_t* d, int len);
+
+    int _mode;
+    int _frame;                                     // frames run since the start
+    int _last;                                      // frame of the previous event
+    size_t _pos;                                    // playback position in _log
+    std::vector<uint8_t> _state;
+    std::vector<uint8_t> _log;
+};
+
+#endif /* movie_h */
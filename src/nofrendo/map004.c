@@ -183,6 +183,8 @@ static void map4_setstate(SnssMapperBlock *state)
    irq.latch = state->extraData.mapper4.irqLatchCounter;
    irq.enabled = state->extraData.mapper4.irqCounterEnabled;
    command = state->extraData.mapper4.last8000Write;
+   vrombase = (command & 0x80) ? 0x1000 : 0x0000;
+   reg = command & 0x40;
 }
 
 static void map4_init(void)
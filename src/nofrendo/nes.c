@@ -38,6 +38,8 @@
 #include "nes_mmc.h"
 #include "vid_drv.h"
 #include "nofrendo.h"
+#include "../profile.h"
+#include "../video_line.h"
 
 
 #define  NES_CLOCK_DIVIDER    12
@@ -303,12 +305,14 @@ void nes_renderframe(bool draw_flag)
    while (262 != nes.scanline)
    {
 //      ppu_scanline(nes.vidbuf, nes.scanline, draw_flag);
-		ppu_scanline(vid_getbuffer(), nes.scanline, draw_flag);
+		PROF_ZONE(PROF_VIDEO,ppu_scanline(vid_getbuffer(), nes.scanline, draw_flag));
+      if (draw_flag && nes.scanline < 240)
+         VIDEO_LINE(nes.scanline, vid_getbuffer()->line[nes.scanline]);
 
       if (241 == nes.scanline)
       {
          /* 7-9 cycle delay between when VINT flag goes up and NMI is taken */
-         elapsed_cycles = nes6502_execute(7);
+         PROF_ZONE(PROF_CPU,elapsed_cycles = nes6502_execute(7));
          nes.scanline_cycles -= elapsed_cycles;
          nes_checkfiq(elapsed_cycles);
 
@@ -323,11 +327,11 @@ void nes_renderframe(bool draw_flag)
          mapintf->hblank(in_vblank);
 
       nes.scanline_cycles += (float) NES_SCANLINE_CYCLES;
-      elapsed_cycles = nes6502_execute((int) nes.scanline_cycles);
+      PROF_ZONE(PROF_CPU,elapsed_cycles = nes6502_execute((int) nes.scanline_cycles));
       nes.scanline_cycles -= (float) elapsed_cycles;
       nes_checkfiq(elapsed_cycles);
 
-      ppu_endscanline(nes.scanline);
+      PROF_ZONE(PROF_VIDEO,ppu_endscanline(nes.scanline));
       nes.scanline++;
    }
 
@@ -405,12 +409,17 @@ void nes_emulate(void)
 }
 
 
+/* power on garbage, the same every time so input movies replay */
 static void mem_trash(uint8 *buffer, int length)
 {
    int i;
+   uint32 seed = 1;
 
    for (i = 0; i < length; i++)
-      buffer[i] = (uint8) rand();
+   {
+      seed = seed * 1103515245 + 12345;
+      buffer[i] = (uint8) (seed >> 16);
+   }
 }
 
 /* Reset NES hardware */
@@ -493,6 +502,7 @@ int nes_insertcart(const char *filename, nes_t *machine)
    apu_setext(machine->apu, machine->mmc->intf->sound_ext);
    
    build_address_handlers(machine);
+   nes6502_sethandlers();
 
    nes_setcontext(machine);
 
@@ -542,6 +552,9 @@ nes_t *nes_create(void)
    for (i = 1; i < NES6502_NUMBANKS; i++)
       machine->cpu->mem_page[i] = NULL;
 
+   /* empty until build_address_handlers, the dispatch tables are built from these */
+   machine->readhandler[0].min_range = machine->readhandler[0].max_range = -1;
+   machine->writehandler[0].min_range = machine->writehandler[0].max_range = -1;
    machine->cpu->read_handler = machine->readhandler;
    machine->cpu->write_handler = machine->writehandler;
 
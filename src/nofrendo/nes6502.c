@@ -24,6 +24,7 @@
 */
 #pragma GCC optimize ("O3")
 
+#include "string.h"
 #include "noftypes.h"
 #include "nes6502.h"
 //#include "dis6502.h"
@@ -1137,6 +1138,20 @@ static int remaining_cycles = 0; /* so we can release timeslice */
 static uint8 *ram = NULL, *stack = NULL;
 static uint8 null_page[NES6502_BANKSIZE];
 
+/* Memory handler dispatch, built from the handler lists whenever they change.
+** One entry per 32 byte block: the index of the handler that owns the whole
+** block, HANDLER_NONE for paged memory or HANDLER_SCAN if a handler boundary
+** falls inside the block and the list has to be walked.
+*/
+#define  HANDLER_SHIFT  5
+#define  HANDLER_NONE   0xFF
+#define  HANDLER_SCAN   0xFE
+
+static uint8 read_dispatch[0x8000 >> HANDLER_SHIFT];
+static uint8 write_dispatch[0x10000 >> HANDLER_SHIFT];
+static nes6502_memread *dispatch_read_handler = NULL;
+static nes6502_memwrite *dispatch_write_handler = NULL;
+
 
 /*
 ** Zero-page helper macros
@@ -1199,10 +1214,88 @@ INLINE void bank_writebyte(register uint32 address, register uint8 value)
    cpu.mem_page[address >> NES6502_BANKSHIFT][address & NES6502_BANKMASK] = value;
 }
 
+/* first handler in the list covering address, in list order like the old scan */
+static int read_owner(uint32 address)
+{
+   int i;
+
+   for (i = 0; cpu.read_handler[i].min_range != 0xFFFFFFFF; i++)
+   {
+      if (address >= cpu.read_handler[i].min_range && address <= cpu.read_handler[i].max_range)
+         return i;
+   }
+   return HANDLER_NONE;
+}
+
+static int write_owner(uint32 address)
+{
+   int i;
+
+   for (i = 0; cpu.write_handler[i].min_range != 0xFFFFFFFF; i++)
+   {
+      if (address >= cpu.write_handler[i].min_range && address <= cpu.write_handler[i].max_range)
+         return i;
+   }
+   return HANDLER_NONE;
+}
+
+static void build_dispatch(void)
+{
+   uint32 block, address;
+   int owner;
+
+   memset(read_dispatch, HANDLER_NONE, sizeof(read_dispatch));
+   memset(write_dispatch, HANDLER_NONE, sizeof(write_dispatch));
+
+   for (block = 0; block < sizeof(read_dispatch); block++)
+   {
+      if (NULL == cpu.read_handler)
+         break;
+      address = block << HANDLER_SHIFT;
+      owner = read_owner(address);
+      for (address++; address < ((block + 1) << HANDLER_SHIFT); address++)
+      {
+         if (read_owner(address) != owner)
+         {
+            owner = HANDLER_SCAN;
+            break;
+         }
+      }
+      read_dispatch[block] = owner;
+   }
+
+   for (block = 0; block < sizeof(write_dispatch); block++)
+   {
+      if (NULL == cpu.write_handler)
+         break;
+      address = block << HANDLER_SHIFT;
+      owner = write_owner(address);
+      for (address++; address < ((block + 1) << HANDLER_SHIFT); address++)
+      {
+         if (write_owner(address) != owner)
+         {
+            owner = HANDLER_SCAN;
+            break;
+         }
+      }
+      write_dispatch[block] = owner;
+   }
+
+   dispatch_read_handler = cpu.read_handler;
+   dispatch_write_handler = cpu.write_handler;
+}
+
+/* handler lists were (re)filled in place, rebuild on the next setcontext */
+void nes6502_sethandlers(void)
+{
+   dispatch_read_handler = NULL;
+   dispatch_write_handler = NULL;
+}
+
 /* read a byte of 6502 memory */
 static uint8 mem_readbyte(uint32 address)
 {
-   nes6502_memread *mr;
+   int owner;
 
    /* TODO: following 2 cases are N2A03-specific */
    if (address < 0x800)
@@ -1218,11 +1311,11 @@ static uint8 mem_readbyte(uint32 address)
    /* check memory range handlers */
    else
    {
-      for (mr = cpu.read_handler; mr->min_range != 0xFFFFFFFF; mr++)
-      {
-         if (address >= mr->min_range && address <= mr->max_range)
-            return mr->read_func(address);
-      }
+      owner = read_dispatch[address >> HANDLER_SHIFT];
+      if (HANDLER_SCAN == owner)
+         owner = read_owner(address);
+      if (HANDLER_NONE != owner)
+         return cpu.read_handler[owner].read_func(address);
    }
 
    /* return paged memory */
@@ -1232,7 +1325,7 @@ static uint8 mem_readbyte(uint32 address)
 /* write a byte of data to 6502 memory */
 static void mem_writebyte(uint32 address, uint8 value)
 {
-   nes6502_memwrite *mw;
+   int owner;
 
    /* RAM */
    if (address < 0x800)
@@ -1243,13 +1336,13 @@ static void mem_writebyte(uint32 address, uint8 value)
    /* check memory range handlers */
    else
    {
-      for (mw = cpu.write_handler; mw->min_range != 0xFFFFFFFF; mw++)
+      owner = write_dispatch[address >> HANDLER_SHIFT];
+      if (HANDLER_SCAN == owner)
+         owner = write_owner(address);
+      if (HANDLER_NONE != owner)
       {
-         if (address >= mw->min_range && address <= mw->max_range)
-         {
-            mw->write_func(address, value);
-            return;
-         }
+         cpu.write_handler[owner].write_func(address, value);
+         return;
       }
    }
 
@@ -1275,6 +1368,10 @@ void nes6502_setcontext(nes6502_context *context)
 
    ram = cpu.mem_page[0];  /* quick zero-page/RAM references */
    stack = ram + STACK_OFFSET;
+
+   /* bank switches come through here too, only rebuild for new handlers */
+   if (cpu.read_handler != dispatch_read_handler || cpu.write_handler != dispatch_write_handler)
+      build_dispatch();
 }
 
 /* get the current context */
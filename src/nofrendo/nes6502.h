@@ -112,6 +112,7 @@ extern void nes6502_release(void);
 /* Context get/set */
 extern void nes6502_setcontext(nes6502_context *cpu);
 extern void nes6502_getcontext(nes6502_context *cpu);
+extern void nes6502_sethandlers(void);
 
 #ifdef __cplusplus
 }
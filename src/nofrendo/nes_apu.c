@@ -33,13 +33,9 @@
 #define  APU_OVERSAMPLE
 #define  APU_VOLUME_DECAY(x)  ((x) -= ((x) >> 7))
 
-/* the following seem to be the correct (empirically determined)
-** relative volumes between the sound channels
+/* raw channel levels, the relative volumes between the sound
+** channels come from the non-linear dac tables in the mixer
 */
-#define  APU_RECTANGLE_OUTPUT(channel) (apu.rectangle[channel].output_vol)
-#define  APU_TRIANGLE_OUTPUT           (apu.triangle.output_vol + (apu.triangle.output_vol >> 2))
-#define  APU_NOISE_OUTPUT              ((apu.noise.output_vol + apu.noise.output_vol + apu.noise.output_vol) >> 2)
-#define  APU_DMC_OUTPUT                ((apu.dmc.output_vol + apu.dmc.output_vol + apu.dmc.output_vol) >> 2)
 
 /* active APU */
 static apu_t apu;
@@ -124,18 +120,46 @@ void apu_setchan(int chan, bool enabled)
 ** for the white noise channel
 */
 #ifdef REALTIME_NOISE
-INLINE int8 shift_register15(uint8 xor_tap)
+INLINE int8 shift_register15(int *sreg, uint8 xor_tap)
 {
-   static int sreg = 0x4000;
    int bit0, tap, bit14;
 
-   bit0 = sreg & 1;
-   tap = (sreg & xor_tap) ? 1 : 0;
+   bit0 = *sreg & 1;
+   tap = (*sreg & xor_tap) ? 1 : 0;
    bit14 = (bit0 ^ tap);
-   sreg >>= 1;
-   sreg |= (bit14 << 14);
+   *sreg >>= 1;
+   *sreg |= (bit14 << 14);
    return (bit0 ^ 1);
 }
+
+/* count calls of shift_register15(), returning how many gave a 1.  The
+** bits fed back in only reach the tap after 15 - tap steps, so up to 8
+** steps at a time can be worked out from the register as it stands
+*/
+INLINE int shift_register15_ones(int *sreg, uint8 xor_tap, int count)
+{
+   int s = *sreg, ones = count, tap = (0x40 == xor_tap) ? 6 : 1;
+   int k, mask, low, feed;
+
+   while (count > 0)
+   {
+      k = (count > 8) ? 8 : count;
+      mask = (1 << k) - 1;
+      low = s & mask;
+      feed = (s ^ (s >> tap)) & mask;
+
+      /* each step gives its bit 0 inverted, so take off the set ones */
+      low = low - ((low >> 1) & 0x55);
+      low = (low & 0x33) + ((low >> 2) & 0x33);
+      ones -= (low + (low >> 4)) & 0x0F;
+
+      s = (s >> k) | (feed << (15 - k));
+      count -= k;
+   }
+
+   *sreg = s;
+   return ones;
+}
 #else /* !REALTIME_NOISE */
 static void shift_register15(int8 *buf, int count)
 {
@@ -179,77 +203,77 @@ static void shift_register15(int8 *buf, int count)
 #ifdef APU_OVERSAMPLE
 
 #define  APU_MAKE_RECTANGLE(ch) \
-static int32 apu_rectangle_##ch(void) \
+INLINE int32 apu_rectangle_##ch(rectangle_t *rect, float cycle_rate) \
 { \
    int32 output, total; \
    int num_times; \
 \
-   APU_VOLUME_DECAY(apu.rectangle[ch].output_vol); \
+   APU_VOLUME_DECAY(rect->output_vol); \
 \
-   if (false == apu.rectangle[ch].enabled || 0 == apu.rectangle[ch].vbl_length) \
-      return APU_RECTANGLE_OUTPUT(ch); \
+   if (false == rect->enabled || 0 == rect->vbl_length) \
+      return rect->output_vol; \
 \
    /* vbl length counter */ \
-   if (false == apu.rectangle[ch].holdnote) \
-      apu.rectangle[ch].vbl_length--; \
+   if (false == rect->holdnote) \
+      rect->vbl_length--; \
 \
    /* envelope decay at a rate of (env_delay + 1) / 240 secs */ \
-   apu.rectangle[ch].env_phase -= 4; /* 240/60 */ \
-   while (apu.rectangle[ch].env_phase < 0) \
+   rect->env_phase -= 4; /* 240/60 */ \
+   while (rect->env_phase < 0) \
    { \
-      apu.rectangle[ch].env_phase += apu.rectangle[ch].env_delay; \
+      rect->env_phase += rect->env_delay; \
 \
-      if (apu.rectangle[ch].holdnote) \
-         apu.rectangle[ch].env_vol = (apu.rectangle[ch].env_vol + 1) & 0x0F; \
-      else if (apu.rectangle[ch].env_vol < 0x0F) \
-         apu.rectangle[ch].env_vol++; \
+      if (rect->holdnote) \
+         rect->env_vol = (rect->env_vol + 1) & 0x0F; \
+      else if (rect->env_vol < 0x0F) \
+         rect->env_vol++; \
    } \
 \
    /* TODO: find true relation of freq_limit to register values */ \
-   if (apu.rectangle[ch].freq < 8 \
-       || (false == apu.rectangle[ch].sweep_inc \
-           && apu.rectangle[ch].freq > apu.rectangle[ch].freq_limit)) \
-      return APU_RECTANGLE_OUTPUT(ch); \
+   if (rect->freq < 8 \
+       || (false == rect->sweep_inc \
+           && rect->freq > rect->freq_limit)) \
+      return rect->output_vol; \
 \
    /* frequency sweeping at a rate of (sweep_delay + 1) / 120 secs */ \
-   if (apu.rectangle[ch].sweep_on && apu.rectangle[ch].sweep_shifts) \
+   if (rect->sweep_on && rect->sweep_shifts) \
    { \
-      apu.rectangle[ch].sweep_phase -= 2; /* 120/60 */ \
-      while (apu.rectangle[ch].sweep_phase < 0) \
+      rect->sweep_phase -= 2; /* 120/60 */ \
+      while (rect->sweep_phase < 0) \
       { \
-         apu.rectangle[ch].sweep_phase += apu.rectangle[ch].sweep_delay; \
+         rect->sweep_phase += rect->sweep_delay; \
 \
-         if (apu.rectangle[ch].sweep_inc) /* ramp up */ \
+         if (rect->sweep_inc) /* ramp up */ \
          { \
             if (0 == ch) \
-               apu.rectangle[ch].freq += ~(apu.rectangle[ch].freq >> apu.rectangle[ch].sweep_shifts); \
+               rect->freq += ~(rect->freq >> rect->sweep_shifts); \
             else \
-               apu.rectangle[ch].freq -= (apu.rectangle[ch].freq >> apu.rectangle[ch].sweep_shifts); \
+               rect->freq -= (rect->freq >> rect->sweep_shifts); \
          } \
          else /* ramp down */ \
          { \
-            apu.rectangle[ch].freq += (apu.rectangle[ch].freq >> apu.rectangle[ch].sweep_shifts); \
+            rect->freq += (rect->freq >> rect->sweep_shifts); \
          } \
       } \
    } \
 \
-   apu.rectangle[ch].accum -= apu.cycle_rate; \
-   if (apu.rectangle[ch].accum >= 0) \
-      return APU_RECTANGLE_OUTPUT(ch); \
+   rect->accum -= cycle_rate; \
+   if (rect->accum >= 0) \
+      return rect->output_vol; \
 \
-   if (apu.rectangle[ch].fixed_envelope) \
-      output = apu.rectangle[ch].volume << 8; /* fixed volume */ \
+   if (rect->fixed_envelope) \
+      output = rect->volume << 8; /* fixed volume */ \
    else \
-      output = (apu.rectangle[ch].env_vol ^ 0x0F) << 8; \
+      output = (rect->env_vol ^ 0x0F) << 8; \
 \
    num_times = total = 0; \
 \
-   while (apu.rectangle[ch].accum < 0) \
+   while (rect->accum < 0) \
    { \
-      apu.rectangle[ch].accum += apu.rectangle[ch].freq + 1; \
-      apu.rectangle[ch].adder = (apu.rectangle[ch].adder + 1) & 0x0F; \
+      rect->accum += rect->freq + 1; \
+      rect->adder = (rect->adder + 1) & 0x0F; \
 \
-      if (apu.rectangle[ch].adder < apu.rectangle[ch].duty_flip) \
+      if (rect->adder < rect->duty_flip) \
          total += output; \
       else \
          total -= output; \
@@ -257,84 +281,85 @@ static int32 apu_rectangle_##ch(void) \
       num_times++; \
    } \
 \
-   apu.rectangle[ch].output_vol = total / num_times; \
-   return APU_RECTANGLE_OUTPUT(ch); \
+   /* one step is the usual case and needs no divide */ \
+   rect->output_vol = (1 == num_times) ? total : total / num_times; \
+   return rect->output_vol; \
 } 
 
 #else /* !APU_OVERSAMPLE */
 #define  APU_MAKE_RECTANGLE(ch) \
-static int32 apu_rectangle_##ch(void) \
+INLINE int32 apu_rectangle_##ch(rectangle_t *rect, float cycle_rate) \
 { \
    int32 output; \
 \
-   APU_VOLUME_DECAY(apu.rectangle[ch].output_vol); \
+   APU_VOLUME_DECAY(rect->output_vol); \
 \
-   if (false == apu.rectangle[ch].enabled || 0 == apu.rectangle[ch].vbl_length) \
-      return APU_RECTANGLE_OUTPUT(ch); \
+   if (false == rect->enabled || 0 == rect->vbl_length) \
+      return rect->output_vol; \
 \
    /* vbl length counter */ \
-   if (false == apu.rectangle[ch].holdnote) \
-      apu.rectangle[ch].vbl_length--; \
+   if (false == rect->holdnote) \
+      rect->vbl_length--; \
 \
    /* envelope decay at a rate of (env_delay + 1) / 240 secs */ \
-   apu.rectangle[ch].env_phase -= 4; /* 240/60 */ \
-   while (apu.rectangle[ch].env_phase < 0) \
+   rect->env_phase -= 4; /* 240/60 */ \
+   while (rect->env_phase < 0) \
    { \
-      apu.rectangle[ch].env_phase += apu.rectangle[ch].env_delay; \
+      rect->env_phase += rect->env_delay; \
 \
-      if (apu.rectangle[ch].holdnote) \
-         apu.rectangle[ch].env_vol = (apu.rectangle[ch].env_vol + 1) & 0x0F; \
-      else if (apu.rectangle[ch].env_vol < 0x0F) \
-         apu.rectangle[ch].env_vol++; \
+      if (rect->holdnote) \
+         rect->env_vol = (rect->env_vol + 1) & 0x0F; \
+      else if (rect->env_vol < 0x0F) \
+         rect->env_vol++; \
    } \
 \
    /* TODO: find true relation of freq_limit to register values */ \
-   if (apu.rectangle[ch].freq < 8 || (false == apu.rectangle[ch].sweep_inc && apu.rectangle[ch].freq > apu.rectangle[ch].freq_limit)) \
-      return APU_RECTANGLE_OUTPUT(ch); \
+   if (rect->freq < 8 || (false == rect->sweep_inc && rect->freq > rect->freq_limit)) \
+      return rect->output_vol; \
 \
    /* frequency sweeping at a rate of (sweep_delay + 1) / 120 secs */ \
-   if (apu.rectangle[ch].sweep_on && apu.rectangle[ch].sweep_shifts) \
+   if (rect->sweep_on && rect->sweep_shifts) \
    { \
-      apu.rectangle[ch].sweep_phase -= 2; /* 120/60 */ \
-      while (apu.rectangle[ch].sweep_phase < 0) \
+      rect->sweep_phase -= 2; /* 120/60 */ \
+      while (rect->sweep_phase < 0) \
       { \
-         apu.rectangle[ch].sweep_phase += apu.rectangle[ch].sweep_delay; \
+         rect->sweep_phase += rect->sweep_delay; \
 \
-         if (apu.rectangle[ch].sweep_inc) /* ramp up */ \
+         if (rect->sweep_inc) /* ramp up */ \
          { \
             if (0 == ch) \
-               apu.rectangle[ch].freq += ~(apu.rectangle[ch].freq >> apu.rectangle[ch].sweep_shifts); \
+               rect->freq += ~(rect->freq >> rect->sweep_shifts); \
             else \
-               apu.rectangle[ch].freq -= (apu.rectangle[ch].freq >> apu.rectangle[ch].sweep_shifts); \
+               rect->freq -= (rect->freq >> rect->sweep_shifts); \
          } \
          else /* ramp down */ \
          { \
-            apu.rectangle[ch].freq += (apu.rectangle[ch].freq >> apu.rectangle[ch].sweep_shifts); \
+            rect->freq += (rect->freq >> rect->sweep_shifts); \
          } \
       } \
    } \
 \
-   apu.rectangle[ch].accum -= apu.cycle_rate; \
-   if (apu.rectangle[ch].accum >= 0) \
-      return APU_RECTANGLE_OUTPUT(ch); \
+   rect->accum -= cycle_rate; \
+   if (rect->accum >= 0) \
+      return rect->output_vol; \
 \
-   while (apu.rectangle[ch].accum < 0) \
+   while (rect->accum < 0) \
    { \
-      apu.rectangle[ch].accum += (apu.rectangle[ch].freq + 1); \
-      apu.rectangle[ch].adder = (apu.rectangle[ch].adder + 1) & 0x0F; \
+      rect->accum += (rect->freq + 1); \
+      rect->adder = (rect->adder + 1) & 0x0F; \
    } \
 \
-   if (apu.rectangle[ch].fixed_envelope) \
-      output = apu.rectangle[ch].volume << 8; /* fixed volume */ \
+   if (rect->fixed_envelope) \
+      output = rect->volume << 8; /* fixed volume */ \
    else \
-      output = (apu.rectangle[ch].env_vol ^ 0x0F) << 8; \
+      output = (rect->env_vol ^ 0x0F) << 8; \
 \
-   if (0 == apu.rectangle[ch].adder) \
-      apu.rectangle[ch].output_vol = output; \
-   else if (apu.rectangle[ch].adder == apu.rectangle[ch].duty_flip) \
-      apu.rectangle[ch].output_vol = -output; \
+   if (0 == rect->adder) \
+      rect->output_vol = output; \
+   else if (rect->adder == rect->duty_flip) \
+      rect->output_vol = -output; \
 \
-   return APU_RECTANGLE_OUTPUT(ch); \
+   return rect->output_vol; \
 }
 
 #endif /* !APU_OVERSAMPLE */
@@ -350,42 +375,42 @@ APU_MAKE_RECTANGLE(1)
 ** reg2: low 8 bits of frequency
 ** reg3: 7-3=length counter, 2-0=high 3 bits of frequency
 */
-static int32 apu_triangle(void)
+INLINE int32 apu_triangle(triangle_t *tri, float cycle_rate)
 {
-   APU_VOLUME_DECAY(apu.triangle.output_vol);
+   APU_VOLUME_DECAY(tri->output_vol);
 
-   if (false == apu.triangle.enabled || 0 == apu.triangle.vbl_length)
-      return APU_TRIANGLE_OUTPUT;
+   if (false == tri->enabled || 0 == tri->vbl_length)
+      return tri->output_vol;
 
-   if (apu.triangle.counter_started)
+   if (tri->counter_started)
    {
-      if (apu.triangle.linear_length > 0)
-         apu.triangle.linear_length--;
-      if (apu.triangle.vbl_length && false == apu.triangle.holdnote)
-         apu.triangle.vbl_length--;
+      if (tri->linear_length > 0)
+         tri->linear_length--;
+      if (tri->vbl_length && false == tri->holdnote)
+         tri->vbl_length--;
    }
-   else if (false == apu.triangle.holdnote && apu.triangle.write_latency)
+   else if (false == tri->holdnote && tri->write_latency)
    {
-      if (--apu.triangle.write_latency == 0)
-         apu.triangle.counter_started = true;
+      if (--tri->write_latency == 0)
+         tri->counter_started = true;
    }
 
-   if (0 == apu.triangle.linear_length || apu.triangle.freq < 4) /* inaudible */
-      return APU_TRIANGLE_OUTPUT;
+   if (0 == tri->linear_length || tri->freq < 4) /* inaudible */
+      return tri->output_vol;
 
-   apu.triangle.accum -= apu.cycle_rate; \
-   while (apu.triangle.accum < 0)
+   tri->accum -= cycle_rate; \
+   while (tri->accum < 0)
    {
-      apu.triangle.accum += apu.triangle.freq;
-      apu.triangle.adder = (apu.triangle.adder + 1) & 0x1F;
+      tri->accum += tri->freq;
+      tri->adder = (tri->adder + 1) & 0x1F;
 
-      if (apu.triangle.adder & 0x10)
-         apu.triangle.output_vol -= (2 << 8);
+      if (tri->adder & 0x10)
+         tri->output_vol -= (2 << 8);
       else
-         apu.triangle.output_vol += (2 << 8);
+         tri->output_vol += (2 << 8);
    }
 
-   return APU_TRIANGLE_OUTPUT;
+   return tri->output_vol;
 }
 
 
@@ -396,7 +421,7 @@ static int32 apu_triangle(void)
 ** reg3: 7-4=vbl length counter
 */
 /* TODO: AAAAAAAAAAAAAAAAAAAAAAAA!  #ifdef MADNESS! */
-static int32 apu_noise(void)
+INLINE int32 apu_noise(noise_t *noise, float cycle_rate)
 {
    int32 outvol;
 
@@ -409,76 +434,82 @@ static int32 apu_noise(void)
    int32 total;
 #endif /* APU_OVERSAMPLE */
 
-   APU_VOLUME_DECAY(apu.noise.output_vol);
+   APU_VOLUME_DECAY(noise->output_vol);
 
-   if (false == apu.noise.enabled || 0 == apu.noise.vbl_length)
-      return APU_NOISE_OUTPUT;
+   if (false == noise->enabled || 0 == noise->vbl_length)
+      return noise->output_vol;
 
    /* vbl length counter */
-   if (false == apu.noise.holdnote)
-      apu.noise.vbl_length--;
+   if (false == noise->holdnote)
+      noise->vbl_length--;
 
    /* envelope decay at a rate of (env_delay + 1) / 240 secs */
-   apu.noise.env_phase -= 4; /* 240/60 */
-   while (apu.noise.env_phase < 0)
+   noise->env_phase -= 4; /* 240/60 */
+   while (noise->env_phase < 0)
    {
-      apu.noise.env_phase += apu.noise.env_delay;
+      noise->env_phase += noise->env_delay;
 
-      if (apu.noise.holdnote)
-         apu.noise.env_vol = (apu.noise.env_vol + 1) & 0x0F;
-      else if (apu.noise.env_vol < 0x0F)
-         apu.noise.env_vol++;
+      if (noise->holdnote)
+         noise->env_vol = (noise->env_vol + 1) & 0x0F;
+      else if (noise->env_vol < 0x0F)
+         noise->env_vol++;
    }
 
-   apu.noise.accum -= apu.cycle_rate;
-   if (apu.noise.accum >= 0)
-      return APU_NOISE_OUTPUT;
+   noise->accum -= cycle_rate;
+   if (noise->accum >= 0)
+      return noise->output_vol;
    
 #ifdef APU_OVERSAMPLE
-   if (apu.noise.fixed_envelope)
-      outvol = apu.noise.volume << 8; /* fixed volume */
+   if (noise->fixed_envelope)
+      outvol = noise->volume << 8; /* fixed volume */
    else
-      outvol = (apu.noise.env_vol ^ 0x0F) << 8;
+      outvol = (noise->env_vol ^ 0x0F) << 8;
 
    num_times = total = 0;
 #endif /* APU_OVERSAMPLE */
 
-   while (apu.noise.accum < 0)
+#if defined(APU_OVERSAMPLE) && defined(REALTIME_NOISE)
+   /* The periods are whole clocks, so stepping the accumulator up to 0
+   ** is exact until the last add, and that rounds just like adding all of
+   ** the periods at once.  Count the steps instead of taking them (dozens
+   ** per sample at the highest noise pitches), then run the register.
+   */
+   num_times = (int) (-noise->accum / noise->freq);
+   while (noise->accum + (float) (num_times * noise->freq) < 0)
+      num_times++;
+   while (num_times > 1 && noise->accum + (float) ((num_times - 1) * noise->freq) >= 0)
+      num_times--;
+   noise->accum += (float) (num_times * noise->freq);
+
+   /* +outvol for each 1, -outvol for each 0 */
+   total = shift_register15_ones(&noise->sreg, noise->xor_tap, num_times);
+   total = outvol * (2 * total - num_times);
+#else /* !(APU_OVERSAMPLE && REALTIME_NOISE) */
+   while (noise->accum < 0)
    {
-      apu.noise.accum += apu.noise.freq;
+      noise->accum += noise->freq;
 
 #ifdef REALTIME_NOISE
-
-#ifdef APU_OVERSAMPLE
-      if (shift_register15(apu.noise.xor_tap))
-         total += outvol;
-      else
-         total -= outvol;
-
-      num_times++;
-#else /* !APU_OVERSAMPLE */
-      noise_bit = shift_register15(apu.noise.xor_tap);
-#endif /* !APU_OVERSAMPLE */
-
+      noise_bit = shift_register15(&noise->sreg, noise->xor_tap);
 #else /* !REALTIME_NOISE */
-      apu.noise.cur_pos++;
+      noise->cur_pos++;
 
-      if (apu.noise.short_sample)
+      if (noise->short_sample)
       {
-         if (APU_NOISE_93 == apu.noise.cur_pos)
-            apu.noise.cur_pos = 0;
+         if (APU_NOISE_93 == noise->cur_pos)
+            noise->cur_pos = 0;
       }
       else
       {
-         if (APU_NOISE_32K == apu.noise.cur_pos)
-            apu.noise.cur_pos = 0;
+         if (APU_NOISE_32K == noise->cur_pos)
+            noise->cur_pos = 0;
       }
 
 #ifdef APU_OVERSAMPLE
-      if (apu.noise.short_sample)
-         noise_bit = noise_short_lut[apu.noise.cur_pos];
+      if (noise->short_sample)
+         noise_bit = noise_short_lut[noise->cur_pos];
       else
-         noise_bit = noise_long_lut[apu.noise.cur_pos];
+         noise_bit = noise_long_lut[noise->cur_pos];
 
       if (noise_bit)
          total += outvol;
@@ -489,37 +520,38 @@ static int32 apu_noise(void)
 #endif /* APU_OVERSAMPLE */
 #endif /* !REALTIME_NOISE */
    }
+#endif /* !(APU_OVERSAMPLE && REALTIME_NOISE) */
 
 #ifdef APU_OVERSAMPLE
-   apu.noise.output_vol = total / num_times;
+   noise->output_vol = (1 == num_times) ? total : total / num_times;
 #else /* !APU_OVERSAMPLE */
-   if (apu.noise.fixed_envelope)
-      outvol = apu.noise.volume << 8; /* fixed volume */
+   if (noise->fixed_envelope)
+      outvol = noise->volume << 8; /* fixed volume */
    else
-      outvol = (apu.noise.env_vol ^ 0x0F) << 8;
+      outvol = (noise->env_vol ^ 0x0F) << 8;
 
 #ifndef REALTIME_NOISE
-   if (apu.noise.short_sample)
-      noise_bit = noise_short_lut[apu.noise.cur_pos];
+   if (noise->short_sample)
+      noise_bit = noise_short_lut[noise->cur_pos];
    else
-      noise_bit = noise_long_lut[apu.noise.cur_pos];
+      noise_bit = noise_long_lut[noise->cur_pos];
 #endif /* !REALTIME_NOISE */
 
    if (noise_bit)
-      apu.noise.output_vol = outvol;
+      noise->output_vol = outvol;
    else
-      apu.noise.output_vol = -outvol;
+      noise->output_vol = -outvol;
 #endif /* !APU_OVERSAMPLE */
 
-   return APU_NOISE_OUTPUT;
+   return noise->output_vol;
 }
 
 
-INLINE void apu_dmcreload(void)
+INLINE void apu_dmcreload(dmc_t *dmc)
 {
-   apu.dmc.address = apu.dmc.cached_addr;
-   apu.dmc.dma_length = apu.dmc.cached_dmalength;
-   apu.dmc.irq_occurred = false;
+   dmc->address = dmc->cached_addr;
+   dmc->dma_length = dmc->cached_dmalength;
+   dmc->irq_occurred = false;
 }
 
 /* DELTA MODULATION CHANNEL
@@ -529,82 +561,82 @@ INLINE void apu_dmcreload(void)
 ** reg2: 8 bits of 64-byte aligned address offset : $C000 + (value * 64)
 ** reg3: length, (value * 16) + 1
 */
-static int32 apu_dmc(void)
+INLINE int32 apu_dmc(dmc_t *dmc, float cycle_rate)
 {
    int delta_bit;
 
-   APU_VOLUME_DECAY(apu.dmc.output_vol);
+   APU_VOLUME_DECAY(dmc->output_vol);
 
    /* only process when channel is alive */
-   if (apu.dmc.dma_length)
+   if (dmc->dma_length)
    {
-      apu.dmc.accum -= apu.cycle_rate;
+      dmc->accum -= cycle_rate;
       
-      while (apu.dmc.accum < 0)
+      while (dmc->accum < 0)
       {
-         apu.dmc.accum += apu.dmc.freq;
+         dmc->accum += dmc->freq;
          
-         delta_bit = (apu.dmc.dma_length & 7) ^ 7;
+         delta_bit = (dmc->dma_length & 7) ^ 7;
          
          if (7 == delta_bit)
          {
-            apu.dmc.cur_byte = nes6502_getbyte(apu.dmc.address);
+            dmc->cur_byte = nes6502_getbyte(dmc->address);
             
             /* steal a cycle from CPU*/
             nes6502_burn(1);
 
             /* prevent wraparound */
-            if (0xFFFF == apu.dmc.address)
-               apu.dmc.address = 0x8000;
+            if (0xFFFF == dmc->address)
+               dmc->address = 0x8000;
             else
-               apu.dmc.address++;
+               dmc->address++;
          }
 
-         if (--apu.dmc.dma_length == 0)
+         if (--dmc->dma_length == 0)
          {
             /* if loop bit set, we're cool to retrigger sample */
-            if (apu.dmc.looping)
+            if (dmc->looping)
             {
-               apu_dmcreload();
+               apu_dmcreload(dmc);
             }
             else
             {
                /* check to see if we should generate an irq */
-               if (apu.dmc.irq_gen)
+               if (dmc->irq_gen)
                {
-                  apu.dmc.irq_occurred = true;
+                  dmc->irq_occurred = true;
                   if (apu.irq_callback)
                      apu.irq_callback();
                }
 
                /* bodge for timestamp queue */
-               apu.dmc.enabled = false;
+               dmc->enabled = false;
                break;
             }
          }
 
          /* positive delta */
-         if (apu.dmc.cur_byte & (1 << delta_bit))
+         if (dmc->cur_byte & (1 << delta_bit))
          {
-            if (apu.dmc.regs[1] < 0x7D)
+            if (dmc->regs[1] < 0x7D)
             {
-               apu.dmc.regs[1] += 2;
-               apu.dmc.output_vol += (2 << 8);
+               dmc->regs[1] += 2;
+               dmc->output_vol += (2 << 8);
             }
          }
          /* negative delta */
          else            
          {
-            if (apu.dmc.regs[1] > 1)
+            if (dmc->regs[1] > 1)
             {
-               apu.dmc.regs[1] -= 2;
-               apu.dmc.output_vol -= (2 << 8);
+               dmc->regs[1] -= 2;
+               dmc->output_vol -= (2 << 8);
             }
          }
       }
    }
 
-   return APU_DMC_OUTPUT;
+   return dmc->output_vol;
 }
 
 
@@ -804,7 +836,7 @@ void apu_write(uint32 address, uint8 value)
       if (value & 0x10)
       {
          if (0 == apu.dmc.dma_length)
-            apu_dmcreload();
+            apu_dmcreload(&apu.dmc);
       }
       else
       {
@@ -863,6 +895,61 @@ uint8 apu_read(uint32 address)
    return value;
 }
 
+/* Non-linear DAC mixing
+** =====================
+** The real APU sums the pulses and triangle/noise/DMC through two
+** resistor networks:
+**    pulse_out = 95.52 / (8128 / (p0 + p1) + 100)
+**    tnd_out   = 163.67 / (24329 / (3 * tri + 2 * noise + dmc) + 100)
+** Our channels produce signed, DC-decaying levels in 8.8 fixed point,
+** so the tables are indexed by the signed deviation (in 1/8 DAC steps)
+** from the midpoint of each network and hold the resulting deviation of
+** the output as a signed 16-bit sample.  The pulses and noise swing
+** +/-volume where the real ones switch between 0 and volume, so they
+** count half; the triangle steps two levels per unit.
+*/
+#define  APU_PULSE_MID        15
+#define  APU_PULSE_RANGE      (APU_PULSE_MID << 3)
+#define  APU_TND_MID          101
+#define  APU_TND_RANGE        (APU_TND_MID << 3)
+#define  APU_DAC_GAIN         65536.0
+
+static int16 pulse_lut[APU_PULSE_RANGE * 2 + 1];
+static int16 tnd_lut[APU_TND_RANGE * 2 + 1];
+
+static double apu_pulse_dac(double n)
+{
+   return (n <= 0) ? 0 : 95.52 / (8128.0 / n + 100);
+}
+
+static double apu_tnd_dac(double n)
+{
+   return (n <= 0) ? 0 : 163.67 / (24329.0 / n + 100);
+}
+
+static void apu_build_dac_luts(void)
+{
+   int i;
+   double mid;
+
+   mid = apu_pulse_dac(APU_PULSE_MID);
+   for (i = 0; i <= APU_PULSE_RANGE * 2; i++)
+      pulse_lut[i] = (int16) ((apu_pulse_dac(i / 8.0) - mid) * APU_DAC_GAIN);
+
+   mid = apu_tnd_dac(APU_TND_MID);
+   for (i = 0; i <= APU_TND_RANGE * 2; i++)
+      tnd_lut[i] = (int16) ((apu_tnd_dac(i / 8.0) - mid) * APU_DAC_GAIN);
+}
+
+INLINE int32 apu_dac_index(int32 sum, int32 range)
+{
+   if (sum > range)
+      return range << 1;
+   if (sum < -range)
+      return 0;
+   return sum + range;
+}
+
 #define CLIP_OUTPUT16(out) \
 { \
    /*out <<= 1;*/ \
@@ -872,12 +959,157 @@ uint8 apu_read(uint32 address)
       out = -0x8000; \
 }
 
-void apu_process(void *buffer, int num_samples)
+/* samples rendered per channel pass, keeps the scratch buffers small */
+#define  APU_BLOCK   64
+
+static int32 prev_sample = 0;
+
+/* A channel that isn't playing only decays its level, and that stops
+** moving once it is in [0, 128).  Its whole block is then that level.
+*/
+#define  APU_SETTLED(x)   ((x) >= 0 && (x) < 128)
+#define  APU_RESTING(chan) \
+   ((false == (chan).enabled || 0 == (chan).vbl_length) && APU_SETTLED((chan).output_vol))
+
+INLINE void apu_mix_level(int32 *buf, int count, int32 level)
+{
+   int i;
+
+   for (i = 0; i < count; i++)
+      buf[i] += level;
+}
+
+static void apu_mix_block(int16 *out, int count)
 {
-   static int32 prev_sample = 0;
+   int32 pulse[APU_BLOCK], tnd[APU_BLOCK], ext[APU_BLOCK];
+   int32 accum, next_sample;
+   float cycle_rate = apu.cycle_rate;
+   int i;
+
+   /* each channel runs over the whole block before the next one, on a
+   ** local copy of its state that the inlined generator keeps in
+   ** registers, and is only written back to apu at the end of the block
+   */
+   memset(pulse, 0, count * sizeof(int32));
+   memset(tnd, 0, count * sizeof(int32));
+
+   if (apu.mix_enable & 0x01)
+   {
+      if (APU_RESTING(apu.rectangle[0]))
+         apu_mix_level(pulse, count, apu.rectangle[0].output_vol);
+      else
+      {
+         rectangle_t rect = apu.rectangle[0];
+         for (i = 0; i < count; i++)
+            pulse[i] += apu_rectangle_0(&rect, cycle_rate);
+         apu.rectangle[0] = rect;
+      }
+   }
+   if (apu.mix_enable & 0x02)
+   {
+      if (APU_RESTING(apu.rectangle[1]))
+         apu_mix_level(pulse, count, apu.rectangle[1].output_vol);
+      else
+      {
+         rectangle_t rect = apu.rectangle[1];
+         for (i = 0; i < count; i++)
+            pulse[i] += apu_rectangle_1(&rect, cycle_rate);
+         apu.rectangle[1] = rect;
+      }
+   }
 
+   if (apu.mix_enable & 0x04)
+   {
+      if (APU_RESTING(apu.triangle))
+         apu_mix_level(tnd, count, (apu.triangle.output_vol * 3) >> 1);
+      else
+      {
+         triangle_t tri = apu.triangle;
+         for (i = 0; i < count; i++)
+            tnd[i] += (apu_triangle(&tri, cycle_rate) * 3) >> 1;
+         apu.triangle = tri;
+      }
+   }
+   if (apu.mix_enable & 0x08)
+   {
+      if (APU_RESTING(apu.noise))
+         apu_mix_level(tnd, count, apu.noise.output_vol);
+      else
+      {
+         noise_t noise = apu.noise;
+         for (i = 0; i < count; i++)
+            tnd[i] += apu_noise(&noise, cycle_rate);
+         apu.noise = noise;
+      }
+   }
+   if (apu.mix_enable & 0x10)
+   {
+      if (0 == apu.dmc.dma_length && APU_SETTLED(apu.dmc.output_vol))
+         apu_mix_level(tnd, count, apu.dmc.output_vol);
+      else
+      {
+         dmc_t dmc = apu.dmc;
+         for (i = 0; i < count; i++)
+            tnd[i] += apu_dmc(&dmc, cycle_rate);
+         apu.dmc = dmc;
+      }
+   }
+
+   for (i = 0; i < count; i++)
+      pulse[i] = pulse_lut[apu_dac_index(pulse[i] >> 6, APU_PULSE_RANGE)]
+               + tnd_lut[apu_dac_index(tnd[i] >> 5, APU_TND_RANGE)];
+
+   /* expansion chips are mixed linearly, as before */
+   if (apu.ext && (apu.mix_enable & 0x20))
+   {
+      for (i = 0; i < count; i++)
+         ext[i] = apu.ext->process();
+      for (i = 0; i < count; i++)
+         pulse[i] += ext[i];
+   }
+
+   /* filter type only changes from the gui, so branch once per block */
+   switch (apu.filter_type)
+   {
+   case APU_FILTER_LOWPASS:
+      for (i = 0; i < count; i++)
+      {
+         next_sample = pulse[i];
+         accum = (next_sample + prev_sample) >> 1;
+         prev_sample = next_sample;
+         CLIP_OUTPUT16(accum);
+         out[i] = (int16) accum;
+      }
+      break;
+
+   case APU_FILTER_WEIGHTED:
+      for (i = 0; i < count; i++)
+      {
+         next_sample = pulse[i];
+         accum = (next_sample + next_sample + next_sample + prev_sample) >> 2;
+         prev_sample = next_sample;
+         CLIP_OUTPUT16(accum);
+         out[i] = (int16) accum;
+      }
+      break;
+
+   default:
+      for (i = 0; i < count; i++)
+      {
+         accum = pulse[i];
+         CLIP_OUTPUT16(accum);
+         out[i] = (int16) accum;
+      }
+      break;
+   }
+}
+
+void apu_process(void *buffer, int num_samples)
+{
+   int16 block[APU_BLOCK];
    int16 *buf16;
    uint8 *buf8;
+   int count, i;
 
    if (NULL != buffer)
    {
@@ -887,47 +1119,23 @@ void apu_process(void *buffer, int num_samples)
       buf16 = (int16 *) buffer;
       buf8 = (uint8 *) buffer;
 
-      while (num_samples--)
+      while (num_samples > 0)
       {
-         int32 next_sample, accum = 0;
-
-         if (apu.mix_enable & 0x01)
-            accum += apu_rectangle_0();
-         if (apu.mix_enable & 0x02)
-            accum += apu_rectangle_1();
-         if (apu.mix_enable & 0x04)
-            accum += apu_triangle();
-         if (apu.mix_enable & 0x08)
-            accum += apu_noise();
-         if (apu.mix_enable & 0x10)
-            accum += apu_dmc();
-         if (apu.ext && (apu.mix_enable & 0x20))
-            accum += apu.ext->process();
-
-         /* do any filtering */
-         if (APU_FILTER_NONE != apu.filter_type)
-         {
-            next_sample = accum;
+         count = (num_samples > APU_BLOCK) ? APU_BLOCK : num_samples;
+         num_samples -= count;
 
-            if (APU_FILTER_LOWPASS == apu.filter_type)
-            {
-               accum += prev_sample;
-               accum >>= 1;
-            }
-            else
-               accum = (accum + accum + accum + prev_sample) >> 2;
-
-            prev_sample = next_sample;
-         }
-
-         /* do clipping */
-         CLIP_OUTPUT16(accum);
-
-         /* signed 16-bit output, unsigned 8-bit */
+         /* signed 16-bit output goes straight to the caller */
          if (16 == apu.sample_bits)
-            *buf16++ = (int16) accum;
+         {
+            apu_mix_block(buf16, count);
+            buf16 += count;
+         }
          else
-            *buf8++ = (accum >> 8) ^ 0x80;
+         {
+            apu_mix_block(block, count);
+            for (i = 0; i < count; i++)
+               *buf8++ = (block[i] >> 8) ^ 0x80;
+         }
       }
    }
 }
@@ -948,6 +1156,8 @@ void apu_reset(void)
 
    apu_write(0x4015, 0);
 
+   prev_sample = 0;
+
    if (apu.ext && NULL != apu.ext->reset)
       apu.ext->reset();
 }
@@ -973,6 +1183,8 @@ void apu_build_luts(int num_samples)
    shift_register15(noise_long_lut, APU_NOISE_32K);
    shift_register15(noise_short_lut, APU_NOISE_93);
 #endif /* !REALTIME_NOISE */
+
+   apu_build_dac_luts();
 }
 
 void apu_setparams(double base_freq, int sample_rate, int refresh_rate, int sample_bits)
@@ -1004,6 +1216,9 @@ apu_t *apu_create(double base_freq, int sample_rate, int refresh_rate, int sampl
       return NULL;
 
    memset(temp_apu, 0, sizeof(apu_t));
+#ifdef REALTIME_NOISE
+   temp_apu->noise.sreg = 0x4000;
+#endif /* REALTIME_NOISE */
 
    /* set the update routine */
    temp_apu->process = apu_process;
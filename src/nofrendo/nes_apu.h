@@ -138,6 +138,7 @@ typedef struct noise_s
 
 #ifdef REALTIME_NOISE
    uint8 xor_tap;
+   int sreg;
 #else
    bool short_sample;
    int cur_pos;
@@ -55,6 +55,82 @@
 /* the NES PPU */
 static ppu_t ppu;
 
+/* Decoded pattern rows, 8 pixels of 2 bit color index each. Direct mapped on
+** the address of the row's low plane byte, so bank switches can't make an
+** entry stale; only writes to CHR-RAM (and restoring it) have to invalidate.
+*/
+#define  CHR_CACHE_SIZE       1024
+typedef struct chrcache_s
+{
+   const uint8 *tag[CHR_CACHE_SIZE];
+   uint8 pix[CHR_CACHE_SIZE][8];
+} chrcache_t;
+
+static chrcache_t *chr_cache = NULL;
+
+/* OAM sorted into the (up to 8) sprites on each scanline, in OAM order.
+** Rebuilt before the next rendered line whenever OAM or the sprite size
+** changes, instead of every line checking all 64 sprites.
+*/
+static uint8 oam_bin[240][PPU_MAXSPRITE];
+static uint8 oam_bincount[240];
+static bool oam_dirty = true;
+
+INLINE int chr_index(const uint8 *data_ptr)
+{
+   /* row in bits 0-2, tile above it, fold in the pattern table/bank bits */
+   uint32 a = (uint32) (size_t) data_ptr;
+   a = (a & 7) | ((a >> 1) & ~7);
+   return (a ^ (a >> 10)) & (CHR_CACHE_SIZE - 1);
+}
+
+void ppu_flushchr(void)
+{
+   if (chr_cache)
+      memset(chr_cache->tag, 0, sizeof(chr_cache->tag));
+}
+
+/* a byte of either plane of a pattern row changed (mappers can put
+** nametables and CHR in the same memory, so this is any vram write) */
+INLINE void ppu_writechr(uint32 address)
+{
+   const uint8 *data_ptr = &PPU_MEM(address & ~8);
+   int i;
+
+   if (chr_cache)
+   {
+      i = chr_index(data_ptr);
+      if (chr_cache->tag[i] == data_ptr)
+         chr_cache->tag[i] = NULL;
+   }
+}
+
+/* decoded pixels of the pattern row whose low plane is at data_ptr */
+INLINE const uint8 *chr_decode(const uint8 *data_ptr)
+{
+   int i = chr_index(data_ptr);
+   uint8 *pix = chr_cache->pix[i];
+
+   if (chr_cache->tag[i] != data_ptr)
+   {
+      uint8 pat1 = data_ptr[0], pat2 = data_ptr[8];
+      uint32 pattern = ((pat2 & 0xAA) << 8) | ((pat2 & 0x55) << 1)
+                       | ((pat1 & 0xAA) << 7) | (pat1 & 0x55);
+
+      pix[0] = (pattern >> 14) & 3;
+      pix[1] = (pattern >> 6) & 3;
+      pix[2] = (pattern >> 12) & 3;
+      pix[3] = (pattern >> 4) & 3;
+      pix[4] = (pattern >> 10) & 3;
+      pix[5] = (pattern >> 2) & 3;
+      pix[6] = (pattern >> 8) & 3;
+      pix[7] = pattern & 3;
+      chr_cache->tag[i] = data_ptr;
+   }
+
+   return pix;
+}
+
 
 void ppu_displaysprites(bool display)
 {
@@ -88,6 +164,8 @@ void ppu_setcontext(ppu_t *src_ppu)
    ppu.page[13] = ppu.page[9] - 0x1000;
    ppu.page[14] = ppu.page[10] - 0x1000;
    ppu.page[15] = ppu.page[11] - 0x1000;
+
+   oam_dirty = true;
 }
 
 void ppu_getcontext(ppu_t *dest_ppu)
@@ -145,6 +223,11 @@ ppu_t *ppu_create(void)
 
    ppu_setdefaultpal(temp);
 
+   /* not having the cache just means decoding every tile */
+   if (NULL == chr_cache)
+      chr_cache = malloc(sizeof(chrcache_t));
+   ppu_flushchr();
+
    return temp;
 }
 
@@ -155,6 +238,12 @@ void ppu_destroy(ppu_t **src_ppu)
       free(*src_ppu);
       *src_ppu = NULL;
    }
+
+   if (chr_cache)
+   {
+      free(chr_cache);
+      chr_cache = NULL;
+   }
 }
 
 void ppu_setpage(int size, int page_num, uint8 *location)
@@ -205,12 +294,17 @@ uint8 *ppu_getpage(int page)
    return ppu.page[page];
 }
 
+/* power on garbage, the same every time so input movies replay */
 static void mem_trash(uint8 *buffer, int length)
 {
    int i;
+   uint32 seed = 1;
 
    for (i = 0; i < length; i++)
-      buffer[i] = (uint8) rand();
+   {
+      seed = seed * 1103515245 + 12345;
+      buffer[i] = (uint8) (seed >> 16);
+   }
 }
 
 /* reset state of ppu */
@@ -229,6 +323,10 @@ void ppu_reset(int reset_type)
 
    ppu.latch = 0;
    ppu.vram_accessible = true;
+
+   /* CHR-RAM was just trashed */
+   ppu_flushchr();
+   oam_dirty = true;
 }
 
 /* we render a scanline of graphics first so we know exactly
@@ -279,6 +377,8 @@ static void ppu_oamdma(uint8 value)
          ppu.oam[oam_loc] = nes6502_getbyte(cpu_address++);
    }
 
+   oam_dirty = true;
+
    /* make the CPU spin for DMA cycles */
    nes6502_burn(513);
    nes6502_release();
@@ -412,6 +512,8 @@ void ppu_write(uint32 address, uint8 value)
    case PPU_CTRL0:
       ppu.ctrl0 = value;
 
+      if (ppu.obj_height != ((value & PPU_CTRL0F_OBJ16) ? 16 : 8))
+         oam_dirty = true;
       ppu.obj_height = (value & PPU_CTRL0F_OBJ16) ? 16 : 8;
       ppu.bg_base = (value & PPU_CTRL0F_BGADDR) ? 0x1000 : 0;
       ppu.obj_base = (value & PPU_CTRL0F_OBJADDR) ? 0x1000 : 0;
@@ -438,6 +540,7 @@ void ppu_write(uint32 address, uint8 value)
 
    case PPU_OAMDATA:
       ppu.oam[ppu.oam_addr++] = value;
+      oam_dirty = true;
       break;
 
    case PPU_SCROLL:
@@ -488,6 +591,7 @@ void ppu_write(uint32 address, uint8 value)
             log_printf("VRAM write to $%04X, scanline %d\n", 
                        ppu.vaddr, nes_getcontextptr()->scanline);
             PPU_MEM(ppu.vaddr) = 0xFF; /* corrupt */
+            ppu_writechr(ppu.vaddr);
          }
          else 
          {
@@ -497,6 +601,7 @@ void ppu_write(uint32 address, uint8 value)
                ppu.vaddr -= 0x1000;
 
             PPU_MEM(addr) = value;
+            ppu_writechr(addr);
          }
       }
       else
@@ -576,6 +681,18 @@ void ppu_setvromswitch(ppuvromswitch_t func)
 }
 
 /* rendering routines */
+INLINE void draw_bgrow(uint8 *surface, const uint8 *pix, const uint8 *colors)
+{
+   surface[0] = colors[pix[0]];
+   surface[1] = colors[pix[1]];
+   surface[2] = colors[pix[2]];
+   surface[3] = colors[pix[3]];
+   surface[4] = colors[pix[4]];
+   surface[5] = colors[pix[5]];
+   surface[6] = colors[pix[6]];
+   surface[7] = colors[pix[7]];
+}
+
 INLINE void draw_bgtile(uint8 *surface, uint8 pat1, uint8 pat2, 
                         const uint8 *colors)
 {
@@ -592,104 +709,106 @@ INLINE void draw_bgtile(uint8 *surface, uint8 pat1, uint8 pat2,
    *surface = colors[pattern & 3];
 }
 
-INLINE int draw_oamtile(uint8 *surface, uint8 attrib, uint8 pat1, 
-                        uint8 pat2, const uint8 *col_tbl, bool check_strike)
+/* Sprite rows are composited 4 pixels to a word: byte n of a word is pixel
+** n (little endian host), and per pixel conditions become 0x00/0xFF byte
+** masks built from one bit of each byte.
+*/
+#define  BYTE_MASK(w, bit)    ((((w) >> (bit)) & 0x01010101) * 0xFF)
+#define  SP_PIXELS            (SP_PIXEL * 0x01010101)
+
+/* color indexes of a sprite row, flipped to screen order */
+INLINE void sprite_row(const uint8 *data_ptr, uint8 attrib, uint32 pix[2])
 {
-   int strike_pixel = -1;
-   uint32 color = ((pat2 & 0xAA) << 8) | ((pat2 & 0x55) << 1)
-                  | ((pat1 & 0xAA) << 7) | (pat1 & 0x55);
+   uint32 row[2];
 
-   /* sprite is not 100% transparent */
-   if (color)
+   if (chr_cache)
    {
-      uint8 colors[8];
+      memcpy(row, chr_decode(data_ptr), 8);
+   }
+   else
+   {
+      uint8 pat1 = data_ptr[0], pat2 = data_ptr[8];
+      uint32 color = ((pat2 & 0xAA) << 8) | ((pat2 & 0x55) << 1)
+                     | ((pat1 & 0xAA) << 7) | (pat1 & 0x55);
+
+      row[0] = ((color >> 14) & 3) | ((color >> 6) & 3) << 8
+               | ((color >> 12) & 3) << 16 | ((color >> 4) & 3) << 24;
+      row[1] = ((color >> 10) & 3) | ((color >> 2) & 3) << 8
+               | ((color >> 8) & 3) << 16 | (color & 3) << 24;
+   }
 
-      /* swap pixels around if our tile is flipped */
-      if (0 == (attrib & OAMF_HFLIP))
-      {
-         colors[0] = (color >> 14) & 3;
-         colors[1] = (color >> 6) & 3;
-         colors[2] = (color >> 12) & 3;
-         colors[3] = (color >> 4) & 3;
-         colors[4] = (color >> 10) & 3;
-         colors[5] = (color >> 2) & 3;
-         colors[6] = (color >> 8) & 3;
-         colors[7] = color & 3;
-      }
-      else
-      {
-         colors[7] = (color >> 14) & 3;
-         colors[6] = (color >> 6) & 3;
-         colors[5] = (color >> 12) & 3;
-         colors[4] = (color >> 4) & 3;
-         colors[3] = (color >> 10) & 3;
-         colors[2] = (color >> 2) & 3;
-         colors[1] = (color >> 8) & 3;
-         colors[0] = color & 3;
-      }
+   if (attrib & OAMF_HFLIP)
+   {
+      pix[0] = __builtin_bswap32(row[1]);
+      pix[1] = __builtin_bswap32(row[0]);
+   }
+   else
+   {
+      pix[0] = row[0];
+      pix[1] = row[1];
+   }
+}
 
-      /* check for solid sprite pixel overlapping solid bg pixel */
-      if (check_strike)
-      {
-         if (colors[0] && BG_SOLID(surface[0]))
-            strike_pixel = 0;
-         else if (colors[1] && BG_SOLID(surface[1]))
-            strike_pixel = 1;
-         else if (colors[2] && BG_SOLID(surface[2]))
-            strike_pixel = 2;
-         else if (colors[3] && BG_SOLID(surface[3]))
-            strike_pixel = 3;
-         else if (colors[4] && BG_SOLID(surface[4]))
-            strike_pixel = 4;
-         else if (colors[5] && BG_SOLID(surface[5]))
-            strike_pixel = 5;
-         else if (colors[6] && BG_SOLID(surface[6]))
-            strike_pixel = 6;
-         else if (colors[7] && BG_SOLID(surface[7]))
-            strike_pixel = 7;
-      }
+/* first set byte of a pixel mask pair, or -1 */
+INLINE int first_pixel(uint32 lo, uint32 hi)
+{
+   if (lo)
+      return __builtin_ctz(lo) >> 3;
+   if (hi)
+      return 4 + (__builtin_ctz(hi) >> 3);
+   return -1;
+}
+
+INLINE uint32 sprite_colors(uint32 pix, const uint8 *col_tbl)
+{
+   return col_tbl[pix & 0xFF] | col_tbl[(pix >> 8) & 0xFF] << 8
+          | col_tbl[(pix >> 16) & 0xFF] << 16 | (uint32) col_tbl[pix >> 24] << 24;
+}
+
+INLINE int draw_oamtile(uint8 *surface, uint8 attrib, const uint8 *data_ptr,
+                        const uint8 *col_tbl, bool check_strike)
+{
+   int strike_pixel = -1;
+   uint32 pix[2], opaque[2], under[2], write[2], color[2];
+   int i;
+
+   sprite_row(data_ptr, attrib, pix);
+   opaque[0] = BYTE_MASK(pix[0] | (pix[0] >> 1), 0);
+   opaque[1] = BYTE_MASK(pix[1] | (pix[1] >> 1), 0);
+
+   /* sprite is 100% transparent */
+   if (0 == (opaque[0] | opaque[1]))
+      return -1;
+
+   memcpy(under, surface, 8);
+
+   /* check for solid sprite pixel overlapping solid bg pixel */
+   if (check_strike)
+      strike_pixel = first_pixel(opaque[0] & ~BYTE_MASK(under[0], 7),
+                                 opaque[1] & ~BYTE_MASK(under[1], 7));
+
+   for (i = 0; i < 2; i++)
+   {
+      color[i] = sprite_colors(pix[i], col_tbl);
 
-      /* draw the character */
       if (attrib & OAMF_BEHIND)
       {
-         if (colors[0])
-            surface[0] = SP_PIXEL | (BG_CLEAR(surface[0]) ? col_tbl[colors[0]] : surface[0]);
-         if (colors[1])
-            surface[1] = SP_PIXEL | (BG_CLEAR(surface[1]) ? col_tbl[colors[1]] : surface[1]);
-         if (colors[2])
-            surface[2] = SP_PIXEL | (BG_CLEAR(surface[2]) ? col_tbl[colors[2]] : surface[2]);
-         if (colors[3])
-            surface[3] = SP_PIXEL | (BG_CLEAR(surface[3]) ? col_tbl[colors[3]] : surface[3]);
-         if (colors[4])
-            surface[4] = SP_PIXEL | (BG_CLEAR(surface[4]) ? col_tbl[colors[4]] : surface[4]);
-         if (colors[5])
-            surface[5] = SP_PIXEL | (BG_CLEAR(surface[5]) ? col_tbl[colors[5]] : surface[5]);
-         if (colors[6])
-            surface[6] = SP_PIXEL | (BG_CLEAR(surface[6]) ? col_tbl[colors[6]] : surface[6]);
-         if (colors[7])
-            surface[7] = SP_PIXEL | (BG_CLEAR(surface[7]) ? col_tbl[colors[7]] : surface[7]);
+         /* opaque pixels become sprite pixels, colored only where bg is clear */
+         uint32 clear = BYTE_MASK(under[i], 7);
+         color[i] = (color[i] & clear) | (under[i] & ~clear);
+         write[i] = opaque[i];
       }
       else
       {
-         if (colors[0] && SP_CLEAR(surface[0]))
-            surface[0] = SP_PIXEL | col_tbl[colors[0]];
-         if (colors[1] && SP_CLEAR(surface[1]))
-            surface[1] = SP_PIXEL | col_tbl[colors[1]];
-         if (colors[2] && SP_CLEAR(surface[2]))
-            surface[2] = SP_PIXEL | col_tbl[colors[2]];
-         if (colors[3] && SP_CLEAR(surface[3]))
-            surface[3] = SP_PIXEL | col_tbl[colors[3]];
-         if (colors[4] && SP_CLEAR(surface[4]))
-            surface[4] = SP_PIXEL | col_tbl[colors[4]];
-         if (colors[5] && SP_CLEAR(surface[5]))
-            surface[5] = SP_PIXEL | col_tbl[colors[5]];
-         if (colors[6] && SP_CLEAR(surface[6]))
-            surface[6] = SP_PIXEL | col_tbl[colors[6]];
-         if (colors[7] && SP_CLEAR(surface[7]))
-            surface[7] = SP_PIXEL | col_tbl[colors[7]];
+         /* opaque pixels not already covered by a higher priority sprite */
+         write[i] = opaque[i] & ~BYTE_MASK(under[i], 6);
       }
+
+      under[i] = ((color[i] | SP_PIXELS) & write[i]) | (under[i] & ~write[i]);
    }
 
+   memcpy(surface, under, 8);
+
    return strike_pixel;
 }
 
@@ -734,7 +853,10 @@ static void ppu_renderbg(uint8 *vidbuf)
       if (ppu.latchfunc)
          ppu.latchfunc(ppu.bg_base, tile_index);
 
-      draw_bgtile(bmp_ptr, data_ptr[0], data_ptr[8], ppu.palette + col_high);
+      if (chr_cache)
+         draw_bgrow(bmp_ptr, chr_decode(data_ptr), ppu.palette + col_high);
+      else
+         draw_bgtile(bmp_ptr, data_ptr[0], data_ptr[8], ppu.palette + col_high);
       bmp_ptr += 8;
 
       x_tile++;
@@ -783,14 +905,42 @@ typedef struct obj_s
    uint8 x_loc;
 } obj_t;
 
+/* sort sprites into the scanlines they cover, first 8 per line win */
+static void ppu_binoam(void)
+{
+   obj_t *sprite_ptr = (obj_t *) ppu.oam;
+   int sprite_num, line, last;
+   uint8 sprite_y;
+
+   memset(oam_bincount, 0, sizeof(oam_bincount));
+
+   for (sprite_num = 0; sprite_num < 64; sprite_num++, sprite_ptr++)
+   {
+      sprite_y = sprite_ptr->y_loc + 1;
+      if ((0 == sprite_y) || (sprite_y >= 240))
+         continue;
+
+      last = sprite_y + ppu.obj_height;
+      if (last > 240)
+         last = 240;
+
+      for (line = sprite_y; line < last; line++)
+      {
+         if (oam_bincount[line] < PPU_MAXSPRITE)
+            oam_bin[line][oam_bincount[line]++] = sprite_num;
+      }
+   }
+
+   oam_dirty = false;
+}
+
 /* TODO: fetch valid OAM a scanline before, like the Real Thing */
 static void ppu_renderoam(uint8 *vidbuf, int scanline)
 {
    uint8 *buf_ptr;
-   uint32 vram_offset, savecol[2];
+   uint32 vram_offset, savecol[2] = { 0, 0 };
    int sprite_num, spritecount;
    obj_t *sprite_ptr;
-   uint8 sprite_height;
 
    if (false == ppu.obj_on)
       return;
@@ -805,13 +955,12 @@ static void ppu_renderoam(uint8 *vidbuf, int scanline)
       savecol[1] = ((uint32 *) buf_ptr)[1];
    }
 
-   sprite_height = ppu.obj_height;
    vram_offset = ppu.obj_base;
-   spritecount = 0;
 
-   sprite_ptr = (obj_t *) ppu.oam;
+   if (oam_dirty)
+      ppu_binoam();
 
-   for (sprite_num = 0; sprite_num < 64; sprite_num++, sprite_ptr++)
+   for (spritecount = 0; spritecount < oam_bincount[scanline]; spritecount++)
    {
       uint8 *data_ptr, *bmp_ptr;
       uint32 vram_adr;
@@ -821,13 +970,10 @@ static void ppu_renderoam(uint8 *vidbuf, int scanline)
       bool check_strike;
       int strike_pixel;
 
+      sprite_num = oam_bin[scanline][spritecount];
+      sprite_ptr = (obj_t *) ppu.oam + sprite_num;
       sprite_y = sprite_ptr->y_loc + 1;
 
-      /* Check to see if sprite is out of range */
-      if ((sprite_y > scanline) || (sprite_y <= (scanline - sprite_height))
-          || (0 == sprite_y) || (sprite_y >= 240))
-         continue;
-
       sprite_x = sprite_ptr->x_loc;
       tile_index = sprite_ptr->tile;
       attrib = sprite_ptr->atr;
@@ -874,18 +1020,16 @@ static void ppu_renderoam(uint8 *vidbuf, int scanline)
       ** check for a strike 
       */
       check_strike = (0 == sprite_num) && (false == ppu.strikeflag);
-      strike_pixel = draw_oamtile(bmp_ptr, attrib, data_ptr[0], data_ptr[8], ppu.palette + 16 + col_high, check_strike);
+      strike_pixel = draw_oamtile(bmp_ptr, attrib, data_ptr, ppu.palette + 16 + col_high, check_strike);
       if (strike_pixel >= 0)
          ppu_setstrike(strike_pixel);
 
-      /* maximum of 8 sprites per scanline */
-      if (++spritecount == PPU_MAXSPRITE)
-      {
-         ppu.stat |= PPU_STATF_MAXSPRITE;
-         break;
-      }
    }
 
+   /* maximum of 8 sprites per scanline */
+   if (PPU_MAXSPRITE == oam_bincount[scanline])
+      ppu.stat |= PPU_STATF_MAXSPRITE;
+
    /* Restore lefthand column */
    if (ppu.obj_mask)
    {
@@ -900,9 +1044,8 @@ static void ppu_fakeoam(int scanline)
 {
    uint8 *data_ptr;
    obj_t *sprite_ptr;
-   uint32 vram_adr, color;
-   int y_offset;
-   uint8 pat1, pat2;
+   uint32 vram_adr, pix[2];
+   int y_offset, strike_pixel;
    uint8 tile_index, attrib;
    uint8 sprite_height, sprite_y, sprite_x;
 
@@ -952,56 +1095,11 @@ static void ppu_fakeoam(int scanline)
    }
 
    /* check for a solid sprite 0 pixel */
-   pat1 = data_ptr[0];
-   pat2 = data_ptr[8];
-   color = ((pat2 & 0xAA) << 8) | ((pat2 & 0x55) << 1)
-                  | ((pat1 & 0xAA) << 7) | (pat1 & 0x55);
-
-   if (color)
-   {
-      uint8 colors[8];
-
-      /* buckle up, it's going to get ugly... */
-      if (0 == (attrib & OAMF_HFLIP))
-      {
-         colors[0] = (color >> 14) & 3;
-         colors[1] = (color >> 6) & 3;
-         colors[2] = (color >> 12) & 3;
-         colors[3] = (color >> 4) & 3;
-         colors[4] = (color >> 10) & 3;
-         colors[5] = (color >> 2) & 3;
-         colors[6] = (color >> 8) & 3;
-         colors[7] = color & 3;
-      }
-      else
-      {
-         colors[7] = (color >> 14) & 3;
-         colors[6] = (color >> 6) & 3;
-         colors[5] = (color >> 12) & 3;
-         colors[4] = (color >> 4) & 3;
-         colors[3] = (color >> 10) & 3;
-         colors[2] = (color >> 2) & 3;
-         colors[1] = (color >> 8) & 3;
-         colors[0] = color & 3;
-      }
-
-      if (colors[0])
-         ppu_setstrike(sprite_x + 0);
-      else if (colors[1])
-         ppu_setstrike(sprite_x + 1);
-      else if (colors[2])
-         ppu_setstrike(sprite_x + 2);
-      else if (colors[3])
-         ppu_setstrike(sprite_x + 3);
-      else if (colors[4])
-         ppu_setstrike(sprite_x + 4);
-      else if (colors[5])
-         ppu_setstrike(sprite_x + 5);
-      else if (colors[6])
-         ppu_setstrike(sprite_x + 6);
-      else if (colors[7])
-         ppu_setstrike(sprite_x + 7);
-   }
+   sprite_row(data_ptr, attrib, pix);
+   strike_pixel = first_pixel(BYTE_MASK(pix[0] | (pix[0] >> 1), 0),
+                              BYTE_MASK(pix[1] | (pix[1] >> 1), 0));
+   if (strike_pixel >= 0)
+      ppu_setstrike(sprite_x + strike_pixel);
 }
 
 bool ppu_enabled(void)
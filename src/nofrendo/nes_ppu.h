@@ -129,6 +129,7 @@ extern void ppu_mirror(int nt1, int nt2, int nt3, int nt4);
 
 extern void ppu_setpage(int size, int page_num, uint8 *location);
 extern uint8 *ppu_getpage(int page);
+extern void ppu_flushchr(void);
 
 
 /* control */
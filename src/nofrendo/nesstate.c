@@ -276,6 +276,7 @@ static void load_vramblock(nes_t *state, SNSS_FILE *snssFile)
 
    ASSERT(snssFile->vramBlock.vramSize <= VRAM_8K); /* can't handle more than this! */
    memcpy(state->rominfo->vram, snssFile->vramBlock.vram, snssFile->vramBlock.vramSize);
+   ppu_flushchr();
 }
 
 static void load_sramblock(nes_t *state, SNSS_FILE *snssFile)
@@ -350,6 +351,7 @@ int state_save(void)
    
    /* build our filename using the image's name and the slot number */
    strncpy(fn, machine->rominfo->filename, PATH_MAX - 4);
+   fn[PATH_MAX - 4] = 0;
    
    ASSERT(state_slot >= FIRST_STATE_SLOT && state_slot <= LAST_STATE_SLOT);
    sprintf(ext, ".ss%d", state_slot);
@@ -425,6 +427,7 @@ int state_load(void)
 
    /* build the state name using the ROM's name and the slot number */
    strncpy(fn, machine->rominfo->filename, PATH_MAX - 4);
+   fn[PATH_MAX - 4] = 0;
 
    ASSERT(state_slot >= FIRST_STATE_SLOT && state_slot <= LAST_STATE_SLOT);
    sprintf(ext, ".ss%d", state_slot);
@@ -494,6 +497,113 @@ _error:
    return -1;
 }
 
+/* In memory snapshots.  Unlike SNSS these hold the raw contexts, bank
+** pointers included, so a buffer is only good for the running machine.
+** Mapper registers go through get_state/set_state where the mapper has them.
+*/
+typedef struct memstate_s
+{
+   nes6502_context cpu;
+   ppu_t ppu;
+   apu_t apu;
+   SnssMapperBlock mapper;
+   int mirror[4];       /* ppu page[8..15] point into whichever buffer saved them */
+   bool fiq_occurred;
+   uint8 fiq_state;
+   int fiq_cycles;
+   int scanline;
+   float scanline_cycles;
+} memstate_t;
+
+#define  MEMSTATE_SIZE  ((sizeof(memstate_t) + 3) & ~3)
+#define  MEMSTATE_RAM   0x800
+
+int state_size(void)
+{
+   nes_t *machine = nes_getcontextptr();
+   ASSERT(machine);
+
+   return MEMSTATE_SIZE + MEMSTATE_RAM
+          + (machine->rominfo->vram ? VRAM_8K : 0)
+          + (machine->rominfo->sram ? machine->rominfo->sram_banks * SRAM_1K : 0);
+}
+
+int state_save_mem(uint8 *buf)
+{
+   int i;
+   memstate_t *state = (memstate_t *) buf;
+   nes_t *machine = nes_getcontextptr();
+   uint8 *p = buf + MEMSTATE_SIZE;
+   ASSERT(machine);
+
+   nes6502_getcontext(&state->cpu);
+   ppu_getcontext(&state->ppu);
+   apu_getcontext(&state->apu);
+   if (machine->mmc->intf->get_state)
+      machine->mmc->intf->get_state(&state->mapper);
+   for (i = 0; i < 4; i++)
+      state->mirror[i] = (state->ppu.page[8 + i] - state->ppu.nametab + 0x2000 + (i * 0x400)) >> 10;
+
+   state->fiq_occurred = machine->fiq_occurred;
+   state->fiq_state = machine->fiq_state;
+   state->fiq_cycles = machine->fiq_cycles;
+   state->scanline = machine->scanline;
+   state->scanline_cycles = machine->scanline_cycles;
+
+   memcpy(p, state->cpu.mem_page[0], MEMSTATE_RAM);
+   p += MEMSTATE_RAM;
+   if (machine->rominfo->vram)
+   {
+      memcpy(p, machine->rominfo->vram, VRAM_8K);
+      p += VRAM_8K;
+   }
+   if (machine->rominfo->sram)
+   {
+      memcpy(p, machine->rominfo->sram, machine->rominfo->sram_banks * SRAM_1K);
+      p += machine->rominfo->sram_banks * SRAM_1K;
+   }
+
+   return p - buf;
+}
+
+int state_load_mem(const uint8 *buf)
+{
+   /* the setcontext calls only read from their argument */
+   memstate_t *state = (memstate_t *) buf;
+   nes_t *machine = nes_getcontextptr();
+   const uint8 *p = buf + MEMSTATE_SIZE;
+   ASSERT(machine);
+
+   nes6502_setcontext(&state->cpu);
+   ppu_setcontext(&state->ppu);
+   ppu_mirror(state->mirror[0], state->mirror[1], state->mirror[2], state->mirror[3]);
+   apu_setcontext(&state->apu);
+   if (machine->mmc->intf->set_state)
+      machine->mmc->intf->set_state(&state->mapper);
+
+   machine->fiq_occurred = state->fiq_occurred;
+   machine->fiq_state = state->fiq_state;
+   machine->fiq_cycles = state->fiq_cycles;
+   machine->scanline = state->scanline;
+   machine->scanline_cycles = state->scanline_cycles;
+
+   memcpy(state->cpu.mem_page[0], p, MEMSTATE_RAM);
+   p += MEMSTATE_RAM;
+   if (machine->rominfo->vram)
+   {
+      memcpy(machine->rominfo->vram, p, VRAM_8K);
+      p += VRAM_8K;
+      ppu_flushchr();
+   }
+   if (machine->rominfo->sram)
+   {
+      memcpy(machine->rominfo->sram, p, machine->rominfo->sram_banks * SRAM_1K);
+      p += machine->rominfo->sram_banks * SRAM_1K;
+   }
+
+   return p - buf;
+}
+
 /*
 ** $Log: nesstate.c,v $
 ** Revision 1.2  2001/04/27 14:37:11  neil
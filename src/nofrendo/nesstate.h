@@ -32,6 +32,11 @@ extern void state_setslot(int slot);
 extern int state_load();
 extern int state_save();
 
+/* in memory, for rewind and friends */
+extern int state_size(void);
+extern int state_save_mem(uint8 *buf);
+extern int state_load_mem(const uint8 *buf);
+
 #endif /* _NESSTATE_H_ */
 
 /*
@@ -237,14 +237,17 @@ int nes_emulate_init(const char* path, int width, int height)
 }
 
 void nes_renderframe(bool draw_flag);
-extern bitmap_t *primary_buffer; //, *back_buffer = NULL;
+extern bitmap_t *primary_buffer, *back_buffer;
 
-// emulate a frame, return
+// emulate a frame, return the lines just drawn
 uint8** nes_emulate_frame(bool draw_flag)
 {
     nes_renderframe(draw_flag);
-    vid_flush();
+    if (draw_flag)
+        vid_flush();            // swaps primary and back
     osd_getinput();
+    if (back_buffer)
+        return back_buffer->line;
     if (primary_buffer)
         return primary_buffer->line;
     return NULL;
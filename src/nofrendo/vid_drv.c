@@ -24,6 +24,7 @@
 */
 
 #include "string.h"
+#include <stdint.h>
 #include "noftypes.h"
 #include "log.h"
 #include "bitmap.h"
@@ -35,7 +36,7 @@
 static bitmap_t *screen = NULL;
 
 /* primary / backbuffer surfaces */
-bitmap_t *primary_buffer = NULL; //, *back_buffer = NULL;
+bitmap_t *primary_buffer = NULL, *back_buffer = NULL;
 
 static viddriver_t *driver = NULL;
 
@@ -61,7 +62,7 @@ static viddriver_t *driver = NULL;
 INLINE int vid_memcmp(const void *p1, const void *p2, int len)
 {
    /* check for 32-bit aligned data */
-   if (0 == (((uint32) p1 & 3) | ((uint32) p2 & 3)))
+   if (0 == (((uintptr_t) p1 & 3) | ((uintptr_t) p2 & 3)))
    {
       uint32 *dw1 = (uint32 *) p1;
       uint32 *dw2 = (uint32 *) p2;
@@ -356,10 +357,13 @@ void vid_flush(void)
    else
       vid_blitscreen(num_dirties, dirty_rects);
 
-   /* Swap pointers to the main/back buffers */
-//   temp = back_buffer;
-//   back_buffer = primary_buffer;
-//   primary_buffer = temp;
+   /* Swap pointers to the main/back buffers, the video isr shows back_buffer */
+   if (back_buffer)
+   {
+      temp = back_buffer;
+      back_buffer = primary_buffer;
+      primary_buffer = temp;
+   }
 }
 
 /* emulated machine tells us which resolution it wants */
@@ -367,23 +371,17 @@ int vid_setmode(int width, int height)
 {
    if (NULL != primary_buffer)
       bmp_destroy(&primary_buffer);
-//   if (NULL != back_buffer)
-//      bmp_destroy(&back_buffer);
+   if (NULL != back_buffer)
+      bmp_destroy(&back_buffer);
 
    primary_buffer = bmp_create(width, height, 8); /* no overdraw */
    if (NULL == primary_buffer)
       return -1;
 
-   /* Create our backbuffer */
-#if 0
-   back_buffer = bmp_create(width, height, 0); /* no overdraw */
-   if (NULL == back_buffer)
-   {
-      bmp_destroy(&primary_buffer);
-      return -1;
-   }
-   bmp_clear(back_buffer, GUI_BLACK);
-#endif
+   /* Create our backbuffer, if there is no room for it draw single buffered */
+   back_buffer = bmp_create(width, height, 8);
+   if (NULL != back_buffer)
+      bmp_clear(back_buffer, GUI_BLACK);
    bmp_clear(primary_buffer, GUI_BLACK);
 
    return 0;
@@ -440,10 +438,8 @@ void vid_shutdown(void)
 
    if (NULL != primary_buffer)
       bmp_destroy(&primary_buffer);
-#if 0
    if (NULL != back_buffer)
       bmp_destroy(&back_buffer);
-#endif
 
    if (driver && driver->shutdown)
       driver->shutdown();
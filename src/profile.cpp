@@ -0,0 +1,133 @@
+/* Copyright (c) 2020, Peter Barrett
+**
+** Permission to use, copy, modify, and/or distribute this software for
+** any purpose with or without fee is hereby granted, provided that the
+** above copyright notice and this permission notice appear in all copies.
+**
+** THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+** WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+** WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR
+** BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES
+** OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+** WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+** ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+** SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "profile.h"
+
+#ifndef ESP_PLATFORM
+#include <time.h>
+#endif
+
+uint32_t _prof_ticks[PROF_ZONES];
+uint32_t _prof_start = 0;
+int _prof_zone = PROF_EMU;
+uint32_t _prof_counts[PROF_COUNTERS];
+
+static uint32_t _prof_ring[PROF_FRAMES][PROF_ZONES];
+static uint32_t _prof_count_ring[PROF_FRAMES][PROF_COUNTERS];
+static int _prof_frames = -1;     // first frame started at an arbitrary point, drop it
+
+static const char* _prof_names[PROF_ZONES] = {
+    "idle","emu","cpu","video","332","audio","gui","hid","blit","isr"
+};
+
+static const char* _prof_count_names[PROF_COUNTERS] = {
+    "t.hit","t.mis","t.evc"
+};
+
+const char* prof_name(int zone)
+{
+    return _prof_names[zone];
+}
+
+const char* prof_count_name(int counter)
+{
+    return _prof_count_names[counter];
+}
+
+// ccount on the ESP32, tsc on the host
+static uint32_t ticks_per_us()
+{
+#ifdef ESP_PLATFORM
+    return 240;
+#else
+    static uint32_t _tpu = 0;
+    if (!_tpu) {
+        timespec a,b;
+        clock_gettime(CLOCK_MONOTONIC,&a);
+        uint32_t t = prof_now();
+        do {
+            clock_gettime(CLOCK_MONOTONIC,&b);
+        } while ((b.tv_sec - a.tv_sec)*1000000000LL + (b.tv_nsec - a.tv_nsec) < 10000000);
+        _tpu = (prof_now() - t)/10000;
+        if (!_tpu)
+            _tpu = 1;
+    }
+    return _tpu;
+#endif
+}
+
+// close out the zone we are in and move this frame's totals into the ring
+void prof_frame()
+{
+    prof_enter(_prof_zone);
+    if (_prof_frames >= 0) {
+        memcpy(_prof_ring[_prof_frames % PROF_FRAMES],_prof_ticks,sizeof(_prof_ticks));
+        memcpy(_prof_count_ring[_prof_frames % PROF_FRAMES],_prof_counts,sizeof(_prof_counts));
+    }
+    _prof_frames++;
+    memset(_prof_ticks,0,sizeof(_prof_ticks));
+    memset(_prof_counts,0,sizeof(_prof_counts));
+}
+
+void prof_count_stats(int counter, uint32_t* avg, uint32_t* max)
+{
+    int n = _prof_frames < PROF_FRAMES ? _prof_frames : PROF_FRAMES;
+    uint64_t sum = 0;
+    uint32_t m = 0;
+    for (int i = 0; i < n; i++) {
+        uint32_t c = _prof_count_ring[i][counter];
+        sum += c;
+        if (c > m)
+            m = c;
+    }
+    *avg = n ? (uint32_t)(sum/n) : 0;
+    *max = m;
+}
+
+void prof_stats(int zone, uint32_t* avg_us, uint32_t* max_us)
+{
+    int n = _prof_frames < PROF_FRAMES ? _prof_frames : PROF_FRAMES;
+    uint64_t sum = 0;
+    uint32_t m = 0;
+    for (int i = 0; i < n; i++) {
+        uint32_t t = _prof_ring[i][zone];
+        sum += t;
+        if (t > m)
+            m = t;
+    }
+    uint32_t tpu = ticks_per_us();
+    *avg_us = n ? (uint32_t)(sum/n/tpu) : 0;
+    *max_us = m/tpu;
+}
+
+void prof_print()
+{
+    printf("frame us avg/max");
+    for (int z = 0; z < PROF_ZONES; z++) {
+        uint32_t avg,m;
+        prof_stats(z,&avg,&m);
+        printf(" %s:%d/%d",prof_name(z),avg,m);
+    }
+    printf("\nframe count avg/max");
+    for (int c = 0; c < PROF_COUNTERS; c++) {
+        uint32_t avg,m;
+        prof_count_stats(c,&avg,&m);
+        printf(" %s:%d/%d",prof_count_name(c),avg,m);
+    }
+    printf("\n");
+}
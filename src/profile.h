@@ -0,0 +1,124 @@
+/* Copyright (c) 2020, Peter Barrett
+**
+** Permission to use, copy, modify, and/or distribute this software for
+** any purpose with or without fee is hereby granted, provided that the
+** above copyright notice and this permission notice appear in all copies.
+**
+** THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+** WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+** WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR
+** BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES
+** OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+** WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+** ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+** SOFTWARE.
+*/
+
+#ifndef profile_h
+#define profile_h
+
+// Zone based cycle profiler, enabled with PERF in config.h
+// The emulator task is always in exactly one zone: PROF_ENTER switches zones and
+// PROF_LEAVE switches back (PROF_ZONE wraps a single statement), ticks are charged to whichever zone was running so
+// nested zones are exclusive (cpu time inside ANTIC_Frame is charged to cpu, not video).
+// The video ISR runs on the other core and adds its time directly with PROF_BEGIN/PROF_END.
+// Totals are kept per frame in a ring so the HUD can show average and worst case.
+// PROF_COUNT bumps an event counter (cache hits etc) that is ringed the same way.
+
+// config.h turns on O2 for whoever includes it, leave the cores as they were
+#pragma GCC push_options
+#include "../config.h"
+#pragma GCC pop_options
+
+#include <stdint.h>
+
+enum {
+    PROF_IDLE,      // waiting for vblank
+    PROF_EMU,       // everything not in another zone
+    PROF_CPU,       // 6502/Z80 execute
+    PROF_VIDEO,     // PPU/VDP/ANTIC render
+    PROF_332,       // smsplus render_332
+    PROF_AUDIO,     // APU/SN76496/POKEY mixing
+    PROF_GUI,       // overlay
+    PROF_HID,       // hid parse
+
+    PROF_BLIT,      // ISR zones, core 1
+    PROF_ISR,
+    PROF_ZONES
+};
+
+// event counters, per frame like the zones
+enum {
+    PROF_TILE_HIT,  // smsplus tile cache
+    PROF_TILE_MISS,
+    PROF_TILE_EVICT,
+    PROF_COUNTERS
+};
+
+#define PROF_FRAMES 64
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern uint32_t _prof_ticks[PROF_ZONES];    // current frame
+extern uint32_t _prof_start;
+extern int _prof_zone;
+extern uint32_t _prof_counts[PROF_COUNTERS];
+
+void prof_frame();                          // end of an emulated frame
+void prof_stats(int zone, uint32_t* avg_us, uint32_t* max_us);
+const char* prof_name(int zone);
+void prof_count_stats(int counter, uint32_t* avg, uint32_t* max);
+const char* prof_count_name(int counter);
+void prof_print();
+
+static inline uint32_t prof_now()
+{
+#ifdef ESP_PLATFORM
+    uint32_t c;
+    __asm__ __volatile__("rsr %0, ccount" : "=a"(c));
+    return c;
+#else
+    uint32_t lo,hi;
+    __asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+    return lo;
+#endif
+}
+
+static inline int prof_enter(int zone)
+{
+    uint32_t t = prof_now();
+    int z = _prof_zone;
+    _prof_ticks[z] += t - _prof_start;
+    _prof_start = t;
+    _prof_zone = zone;
+    return z;
+}
+
+static inline void prof_add(int zone, uint32_t ticks)
+{
+    _prof_ticks[zone] += ticks;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef PERF
+#define PROF_ENTER(_z)      int _prof_prev = prof_enter(_z)
+#define PROF_LEAVE()        prof_enter(_prof_prev)
+#define PROF_BEGIN(_t)      uint32_t _t = prof_now()
+#define PROF_END(_z,_t)     prof_add(_z,prof_now() - _t)
+#define PROF_ZONE(_z,_x)    do { int _prof_p = prof_enter(_z); _x; prof_enter(_prof_p); } while (0)
+#define PROF_COUNT(_c)      _prof_counts[_c]++
+#else
+#define PROF_ENTER(_z)
+#define PROF_LEAVE()
+#define PROF_BEGIN(_t)
+#define PROF_END(_z,_t)
+#define PROF_ZONE(_z,_x)    _x
+#define PROF_COUNT(_c)
+#endif
+
+#endif /* profile_h */
@@ -0,0 +1,200 @@
+/* Copyright (c) 2020, Peter Barrett
+**
+** Permission to use, copy, modify, and/or distribute this software for
+** any purpose with or without fee is hereby granted, provided that the
+** above copyright notice and this permission notice appear in all copies.
+**
+** THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+** WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+** WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR
+** BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES
+** OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+** WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+** ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+** SOFTWARE.
+*/
+
+#include "rewind.h"
+
+#define KEY_FRAMES  120     // deltas per keyframe at most
+#define REC_BYTES   128     // budget per index entry, deltas of quiet frames are tiny
+
+// XOR against the keyframe as runs of (unchanged words << 16 | changed words) followed by the changed words
+// -1 if it won't fit in limit words, time for a new keyframe
+static int xor_rle(const uint32_t* cur, const uint32_t* key, int words, uint32_t* out, int limit)
+{
+    int i = 0;
+    int o = 0;
+    while (i < words) {
+        int skip = 0;
+        while (i < words && skip < 0xFFFF && cur[i] == key[i]) {
+            i++;
+            skip++;
+        }
+        if (o >= limit)
+            return -1;
+        int h = o++;
+        int lit = 0;
+        while (i < words && lit < 0xFFFF && cur[i] != key[i]) {
+            if (o >= limit)
+                return -1;
+            out[o++] = cur[i] ^ key[i];
+            i++;
+            lit++;
+        }
+        out[h] = (skip << 16) | lit;
+    }
+    return o;
+}
+
+static void xor_apply(uint32_t* dst, const uint32_t* d, int n)
+{
+    int i = 0;
+    int j = 0;
+    while (j < n) {
+        uint32_t h = d[j++];
+        i += h >> 16;
+        for (int lit = h & 0xFFFF; lit; lit--)
+            dst[i++] ^= d[j++];
+    }
+}
+
+Rewind::Rewind() : _mem(0),_recs(0),_cap(0),_ring(0),_ring_size(0),_size(0),_cur(0),_delta(0)
+{
+    reset();
+}
+
+Rewind::~Rewind()
+{
+    free(_mem);
+    free(_cur);
+    free(_delta);
+}
+
+void Rewind::reset()
+{
+    _first = _end = _key = 0;
+    _since_key = 0;
+    _head = 0;
+}
+
+// size of the core's state changed (first push or new media), start over
+bool Rewind::init(int size)
+{
+    reset();
+    free(_cur);
+    free(_delta);
+    _cur = _delta = 0;
+    _size = (size + 3) & ~3;
+    if (!_mem) {
+        int budget = REWIND_KB*1024;
+        _cap = budget/REC_BYTES;
+        _mem = (uint8_t*)malloc(budget);
+        if (!_mem) {
+            printf("rewind: no room for %dk of history\n",REWIND_KB);
+            return false;
+        }
+        _recs = (Rec*)_mem;
+        _ring = _mem + _cap*sizeof(Rec);
+        _ring_size = budget - _cap*sizeof(Rec);
+    }
+    if (_size*2 > _ring_size) {
+        printf("rewind: %d byte state is too big for %dk of history\n",size,REWIND_KB);
+        return false;
+    }
+    _cur = (uint32_t*)malloc(_size);
+    _delta = (uint32_t*)malloc(_size/4 + 4);
+    return _cur && _delta;
+}
+
+// drop the oldest record, deltas of an evicted keyframe go with it
+void Rewind::evict()
+{
+    uint32_t s = _first++;
+    if (rec(s).key == s)
+        while (_first != _end && rec(_first).key == s)
+            _first++;
+}
+
+// live records sit in age order from the oldest round to _head, evict what is in the way of len more bytes
+Rewind::Rec* Rewind::make_room(int len)
+{
+    if (len > _ring_size)
+        return 0;
+    if (!frames())
+        _head = 0;
+    if (_head + len > _ring_size) {
+        while (frames() && rec(_first).off >= _head)   // the end of the ring holds the oldest lap
+            evict();
+        _head = 0;
+    }
+    while (frames() && (frames() >= _cap || (rec(_first).off >= _head && rec(_first).off < _head + len)))
+        evict();
+    Rec* r = &rec(_end);
+    r->off = _head;
+    r->len = len;
+    _head += len;
+    return r;
+}
+
+void Rewind::push(Emu* emu)
+{
+    if (!REWIND_KB)
+        return;                     // don't even ask the core for its state size
+    int size = emu->state_size();
+    if (size <= 0)
+        return;
+    if (((size + 3) & ~3) != _size && !init(size))
+        return;
+    if (!_cur)
+        return;                     // did not fit
+
+    int words = _size >> 2;
+    _cur[words-1] = 0;
+    emu->save_state((uint8_t*)_cur);
+
+    if (valid(_key) && _since_key < KEY_FRAMES) {
+        int n = xor_rle(_cur,(uint32_t*)(_ring + rec(_key).off),words,_delta,words/4);
+        if (n >= 0) {
+            Rec* r = make_room(n*4);
+            if (r && valid(_key)) {             // making room can evict the keyframe itself
+                memcpy(_ring + r->off,_delta,n*4);
+                r->key = _key;
+                _end++;
+                _since_key++;
+                return;
+            }
+            if (r)
+                _head = r->off;
+        }
+    }
+
+    Rec* r = make_room(_size);
+    if (!r)
+        return;
+    memcpy(_ring + r->off,_cur,_size);
+    r->key = _key = _end++;
+    _since_key = 0;
+}
+
+bool Rewind::pop(Emu* emu)
+{
+    if (!frames() || !_cur)
+        return false;
+    uint32_t s = _end - 1;
+    Rec& r = rec(s);
+    if (r.key == s)
+        emu->load_state(_ring + r.off);
+    else {
+        memcpy(_cur,_ring + rec(r.key).off,_size);
+        xor_apply(_cur,(const uint32_t*)(_ring + r.off),r.len >> 2);
+        emu->load_state((const uint8_t*)_cur);
+    }
+    _head = r.off;
+    _end = s;
+    if (frames()) {
+        _key = rec(_end - 1).key;
+        _since_key = _end - 1 - _key;
+    }
+    return true;
+}
@@ -0,0 +1,69 @@
+/* Copyright (c) 2020, Peter Barrett
+**
+** Permission to use, copy, modify, and/or distribute this software for
+** any purpose with or without fee is hereby granted, provided that the
+** above copyright notice and this permission notice appear in all copies.
+**
+** THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+** WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+** WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR
+** BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES
+** OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+** WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+** ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+** SOFTWARE.
+*/
+
+#ifndef rewind_h
+#define rewind_h
+
+#include "emu.h"
+
+// Rewind history in a fixed budget (REWIND_KB in config.h)
+// Every frame the core's save_state is XORed against the last keyframe and the
+// runs of changed words are stored, most frames only touch a few hundred bytes of
+// a NES/SMS state or of the Atari's 64k. A new keyframe is taken when the delta
+// gets too big or too old. Each delta only needs its keyframe to restore so popping
+// is one copy and one pass. When the ring fills the oldest keyframe and its deltas go.
+
+class Rewind {
+public:
+    Rewind();
+    ~Rewind();
+
+    void reset();                   // forget everything, new media
+    void push(Emu* emu);            // snapshot the frame about to be run
+    bool pop(Emu* emu);             // restore the newest snapshot and drop it, false if none left
+    int frames() const { return _end - _first; }
+
+private:
+    struct Rec {
+        int off;                    // in _ring
+        int len;
+        uint32_t key;               // seq of the keyframe this delta applies to, own seq for keyframes
+    };
+
+    bool init(int size);
+    void evict();
+    Rec* make_room(int len);
+    bool valid(uint32_t seq) const { return seq - _first < _end - _first; }
+    Rec& rec(uint32_t seq) { return _recs[seq % _cap]; }
+
+    uint8_t* _mem;                  // one allocation of REWIND_KB: index then ring
+    Rec* _recs;
+    int _cap;
+    uint8_t* _ring;
+    int _ring_size;
+    int _head;                      // next free byte in _ring
+
+    uint32_t _first;                // oldest live seq
+    uint32_t _end;                  // one past the newest
+    uint32_t _key;                  // newest keyframe
+    int _since_key;
+
+    int _size;                      // state size rounded up to words
+    uint32_t* _cur;
+    uint32_t* _delta;
+};
+
+#endif /* rewind_h */
@@ -1,6 +1,8 @@
 #pragma GCC optimize ("O2")
 
 #include "shared.h"
+#include "../profile.h"
+#include "../video_line.h"
 
 /* Background drawing function */
 void (*render_bg)(int line);
@@ -13,13 +15,18 @@ uint8 *linebuf;
 #define ALIGN_DWORD 1 //esp doesn't support unaligned word writes
 
 int16 cachePtr[512*4];				//(tile+attr<<9) -> cache tile store index (i<<6); -1 if not cached
-uint8 cacheStore[CACHEDTILES*64];	//Tile store
-uint8 cacheStoreUsed[CACHEDTILES];	//Marks if a tile is used
+uint8 cacheStore[CACHEDTILES*64] __attribute__((aligned(4)));	//Tile store
+int16 cacheKey[CACHEDTILES];		//Cache tile store index -> (tile+attr<<9); -1 if free
 
-uint8 is_vram_dirty;
+//Free slots are a stack threaded through cacheNext, used slots a doubly linked list
+//in cacheNext/cachePrev with the most recently used at cacheHead
+int16 cacheNext[CACHEDTILES];
+int16 cachePrev[CACHEDTILES];
+int cacheFree=-1;
+int cacheHead=-1;
+int cacheTail=-1;
 
-int cacheKillPtr=0;
-int freePtr=0;
+uint8 is_vram_dirty;
 
 /* Pixel look-up table */
 //uint8 lut[0x10000];
@@ -47,70 +54,106 @@ void palette_sync(int index);
 void render_reset(void);
 void render_init(void);
 
+static void cacheUnlink(int i) {
+	if (cachePrev[i]!=-1) cacheNext[cachePrev[i]]=cacheNext[i]; else cacheHead=cacheNext[i];
+	if (cacheNext[i]!=-1) cachePrev[cacheNext[i]]=cachePrev[i]; else cacheTail=cachePrev[i];
+}
+
+static void cachePushHead(int i) {
+	cachePrev[i]=-1;
+	cacheNext[i]=cacheHead;
+	if (cacheHead!=-1) cachePrev[cacheHead]=i; else cacheTail=i;
+	cacheHead=i;
+}
+
+//Drop a cache tile store index back on the free stack
+static void cacheRelease(int i) {
+	cacheUnlink(i);
+	cachePtr[cacheKey[i]]=-1;
+	cacheKey[i]=-1;
+	cacheNext[i]=cacheFree;
+	cacheFree=i;
+}
+
+//Everything free, nothing cached
+static void cacheReset(void) {
+	int i;
+	for (i=0; i<512*4; i++) cachePtr[i]=-1;
+	for (i=0; i<CACHEDTILES; i++) {
+		cacheKey[i]=-1;
+		cacheNext[i]=i+1<CACHEDTILES ? i+1 : -1;
+	}
+	cacheFree=0;
+	cacheHead=cacheTail=-1;
+}
+
 void vramMarkTileDirty(int index) {
 	int i=index;
 	while (i<0x800) {
 		if (cachePtr[i]!=-1) {
-			freePtr=cachePtr[i]>>6;
-//			printf("Freeing cache loc %d for tile %d\n", freePtr, index);
-			cacheStoreUsed[freePtr]=0;
-			cachePtr[i]=-1;
+//			printf("Freeing cache loc %d for tile %d\n", cachePtr[i]>>6, index);
+			cacheRelease(cachePtr[i]>>6);
 		}
 		i+=0x200;
 	}
 }
 
+//One bitplane nibble -> 4 pixels, leftmost (bit 3) in the low byte
+static const uint32 planar[16] = {
+	0x00000000, 0x01000000, 0x00010000, 0x01010000,
+	0x00000100, 0x01000100, 0x00010100, 0x01010100,
+	0x00000001, 0x01000001, 0x00010001, 0x01010001,
+	0x00000101, 0x01000101, 0x00010101, 0x01010101,
+};
+
 uint8 *getCache(int tile, int attr) {
-    int n, i, x, y, c;
-    int b0, b1, b2, b3;
-    int i0, i1, i2, i3;
-	int p;
+    int i, y;
+    uint32 lo, hi;
+    uint32 *dst;
+    const uint8 *src;
+	int key=tile+(attr<<9);
 	//See if we have this in cache.
-	if (cachePtr[tile+(attr<<9)]!=-1) return &cacheStore[cachePtr[tile+(attr<<9)]];
-
-	//Nope! Generate cache tile.
-	//Find free cache idx first.
-	do {
-		i=freePtr;
-		n=0;
-		while (cacheStoreUsed[i] && n<CACHEDTILES) {
-			i++;
-			n++;
-			if (i==CACHEDTILES) i=0;
+	if (cachePtr[key]!=-1) {
+		i=cachePtr[key]>>6;
+		if (i!=cacheHead) {
+			cacheUnlink(i);
+			cachePushHead(i);
 		}
+		PROF_COUNT(PROF_TILE_HIT);
+		return &cacheStore[i<<6];
+	}
 
-		if (n==CACHEDTILES) {
-			//printf("Eek, tile cache overflow\n");
-			//Crap, out of cache. Kill a tile.
-			vramMarkTileDirty(cacheKillPtr++);
-			if (cacheKillPtr>=512) cacheKillPtr=0;
-			i=freePtr;
-		}
-	} while (cacheStoreUsed[i]);
-	//Okay, somehow we have a free cache tile in i now.
-	cacheStoreUsed[i]=1;
-	cachePtr[tile+(attr<<9)]=i<<6;
+	//Nope! Generate cache tile.
+	//Take a free cache idx, or kill the least recently used tile if there are none.
+	PROF_COUNT(PROF_TILE_MISS);
+	if (cacheFree==-1) {
+		//printf("Eek, tile cache overflow\n");
+		PROF_COUNT(PROF_TILE_EVICT);
+		cacheRelease(cacheTail);
+	}
+	i=cacheFree;
+	cacheFree=cacheNext[i];
+	cacheKey[i]=key;
+	cachePushHead(i);
+	cachePtr[key]=i<<6;
 
 //	printf("Generating cache loc %d for tile %d attr %d\n", i, tile, attr);
-	//Calculate tile
+	//Calculate tile, a row of 4 planes at a time
+	src=&vdp.vram[tile << 5];
+	dst=(uint32 *)&cacheStore[i<<6];
+	if (attr&2) dst+=7*2;		//vflip, rows go bottom up
 	for(y = 0; y < 8; y += 1) {
-		b0 = vdp.vram[(tile << 5) | (y << 2) | (0)];
-		b1 = vdp.vram[(tile << 5) | (y << 2) | (1)];
-		b2 = vdp.vram[(tile << 5) | (y << 2) | (2)];
-		b3 = vdp.vram[(tile << 5) | (y << 2) | (3)];
-		for(x = 0; x < 8; x += 1) {
-			i0 = (b0 >> (x ^ 7)) & 1;
-			i1 = (b1 >> (x ^ 7)) & 1;
-			i2 = (b2 >> (x ^ 7)) & 1;
-			i3 = (b3 >> (x ^ 7)) & 1;
-
-			c = (i3 << 3 | i2 << 2 | i1 << 1 | i0);
-			if (attr==0) cacheStore[(i<<6)|(y<<3)|(x)]=c;
-			if (attr==1) cacheStore[(i<<6)|(y<<3)|(x^7)]=c;
-			if (attr==2) cacheStore[(i<<6)|((y^7)<<3)|(x)]=c;
-			if (attr==3) cacheStore[(i<<6)|((y^7)<<3)|(x^7)]=c;
-
+		lo = planar[src[0] >> 4] | planar[src[1] >> 4] << 1 | planar[src[2] >> 4] << 2 | planar[src[3] >> 4] << 3;
+		hi = planar[src[0] & 15] | planar[src[1] & 15] << 1 | planar[src[2] & 15] << 2 | planar[src[3] & 15] << 3;
+		if (attr&1) {				//hflip, pixels go right to left
+			dst[0]=__builtin_bswap32(hi);
+			dst[1]=__builtin_bswap32(lo);
+		} else {
+			dst[0]=lo;
+			dst[1]=hi;
 		}
+		src+=4;
+		dst+=(attr&2) ? -2 : 2;
 	}
 	return &cacheStore[i<<6];
 }
@@ -122,7 +165,7 @@ uint8 *getCache(int tile, int attr) {
 
 static __inline__ uint32 read_dword(void *address)
 {
-    if ((uint32)address & 3)
+    if ((uintptr_t)address & 3)
 	{
 #ifdef LSB_FIRST  /* little endian version */
         return ( *((uint8 *)address) +
@@ -143,7 +186,7 @@ static __inline__ uint32 read_dword(void *address)
 
 static __inline__ void write_dword(void *address, uint32 data)
 {
-    if ((uint32)address & 3)
+    if ((uintptr_t)address & 3)
 	{
 #ifdef LSB_FIRST
             *((uint8 *)address) =    data;
@@ -238,8 +281,10 @@ void render_reset(void)
 {
     int i;
 
-    /* Clear display bitmap */
+    /* Clear display bitmap, its line ids no longer describe it */
     memset(bitmap.data, 0, bitmap.pitch * bitmap.height);
+    if (bitmap.hash)
+        memset(bitmap.hash, 0, bitmap.height * sizeof(uint32));
 
     /* Clear palette */
     for(i = 0; i < PALETTE_SIZE; i += 1)
@@ -248,8 +293,7 @@ void render_reset(void)
     }
 
     /* Invalidate pattern cache */
-	for (i=0; i<512*4; i++) cachePtr[i]=-1;
-	for (i=0; i<512; i++) vramMarkTileDirty(i);
+	cacheReset();
 
     /* Set up viewport size */
     if(IS_GG)
@@ -275,6 +319,7 @@ void render_reset(void)
 /* Draw a line of the display */
 static void render_332(const uint8_t* buf, int line);
 static uint32_t linebuf_[256];	//make sure it aligns to 32bit
+static uint32 line_id = 0;      /* last id handed out, multiples of 4 so the blit's salt can't alias them */
 
 void render_line(int line)
 {
@@ -306,7 +351,25 @@ void render_line(int line)
             memset(linebuf, BACKDROP_COLOR, 8);
         }
     }
-    render_332(linebuf,line);   // convert to 332 truecolor
+    PROF_ZONE(PROF_332,render_332(linebuf,line));   // convert to 332 truecolor
+
+    /* The dma buffer this line is blitted into holds the line two above. If the two */
+    /* are the same the line shares its id and the blit is skipped, otherwise it gets */
+    /* a new one. The rows above the bitmap are border, so line - 2 is always there. */
+    if (bitmap.hash)
+    {
+        const uint8 *row = bitmap.data + 256*line;
+        uint32 id = bitmap.hash[line - 2];
+        if (!id || memcmp(row, row - 2*256, 256))
+        {
+            line_id += 4;
+            if (!line_id)
+                line_id = 4;
+            id = line_id;
+        }
+        bitmap.hash[line] = id;
+    }
+    VIDEO_LINE(line + 24, bitmap.data + 256*line);  // bitmap starts 24 lines into the 240 line frame
 }
 
 
@@ -385,7 +448,7 @@ void render_bg_sms(int line)
     {
         int x, c, a;
 
-        char *p = &linebuf[(0 - shift)+(column << 3)];
+        uint8 *p = &linebuf[(0 - shift)+(column << 3)];
 
         attr = nt[(column + nt_scroll) & 0x1F];
 
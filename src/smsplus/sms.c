@@ -1,5 +1,6 @@
 
 #include "shared.h"
+#include "../profile.h"
 void ym2413_write(int chip, int offset, int data);
 
 /* SMS context */
@@ -32,49 +33,23 @@ void sms_frame(int skip_render)
 
     if(snd.log) snd.callback(0x00);
 
-    for(vdp.line = 0; vdp.line < 262; vdp.line += 1)
+    vdp_frame_begin(skip_render);
+    while(vdp.line < LINES_PER_FRAME)
     {
-        /* Handle VDP line events */
-        vdp_run();
+        int cycles;
 
-        /* Draw the current frame */
-        if(!skip_render) render_line(vdp.line);
+        /* Handle VDP line events */
+        vdp_sync();
 
-        /* Run the Z80 for a line */
-        z80_execute(227);
+        /* Run the Z80 without stopping until the VDP has work to do */
+        cycles = vdp_cpu_begin();
+        PROF_ZONE(PROF_CPU,z80_execute(cycles));
+        vdp_cpu_end();
     }
+    vdp_frame_end();
 
-    /* Update the emulated sound stream */
-    if(snd.enabled) 
-    {
-/*
-        int count;
-
-        SN76496Update(0, snd.psg_buffer, snd.bufsize, sms.psg_mask);
-
-//        if(sms.use_fm)
-//        {
-//            int i;
-//            for(i = 0; i < snd.bufsize; i++)
-//            {
-//                snd.fm_buffer[i] = OPLL_calc(opll);
-//            }
-//        }
-
-        for(count = 0; count < snd.bufsize; count += 1)
-        {
-            signed short left   = 0;
-            signed short right  = 0;
-//            left = right = snd.fm_buffer[count];
-			left=0;
-            left  += snd.psg_buffer[0][count];
-            right += snd.psg_buffer[1][count];
-            snd.buffer[0][count] = left;
-            snd.buffer[1][count] = right;
-        }
-*/
-        SN76496Update(0, snd.buffer, snd.bufsize, sms.psg_mask);
-    }
+    /* The PSG is rendered straight into the frame's audio buffer, see
+       SN76496UpdateMono() in EmuSMSPlus::audio_buffer() */
 }
 
 
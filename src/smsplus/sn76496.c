@@ -6,6 +6,7 @@
 #define FB_WNOISE   0x12000
 #define FB_PNOISE   0x08000
 #define NG_PRESET   0x0F35
+#define BLOCK       64      /* samples per pass of SN76496UpdateMono */
 
 t_SN76496 sn[MAX_76496];
 
@@ -181,6 +182,179 @@ void SN76496Update(int chip,INT16 *buffer[2],int length, unsigned char mask)
 }
 
 
+/* Add one tone channel's output for n samples into l/r (either may be 0).
+   While the next edge is more than a sample away the output is a constant,
+   so a whole run of samples is added at once; samples holding an edge are
+   integrated exactly as SN76496Update does. */
+static void SN76496Tone(t_SN76496 *R, int i, unsigned int *l, unsigned int *r, int n)
+{
+	unsigned int amp = R->Volume[i];
+	int k = 0;
+
+	while (k < n)
+	{
+		int vol;
+
+		if (R->Count[i] > STEP)
+		{
+			int run = (R->Count[i] - 1) / STEP;
+			if (run > n - k) run = n - k;
+			R->Count[i] -= run * STEP;
+			if (R->Output[i])
+			{
+				unsigned int v = STEP * amp;
+				int end = k + run;
+				int j;
+				if (l) for (j = k; j < end; j++) l[j] += v;
+				if (r) for (j = k; j < end; j++) r[j] += v;
+			}
+			k += run;
+			continue;
+		}
+
+		vol = 0;
+		if (R->Output[i]) vol += R->Count[i];
+		R->Count[i] -= STEP;
+		while (R->Count[i] <= 0)
+		{
+			R->Count[i] += R->Period[i];
+			if (R->Count[i] > 0)
+			{
+				R->Output[i] ^= 1;
+				if (R->Output[i]) vol += R->Period[i];
+				break;
+			}
+			R->Count[i] += R->Period[i];
+			vol += R->Period[i];
+		}
+		if (R->Output[i]) vol -= R->Count[i];
+
+		if (l) l[k] += vol * amp;
+		if (r) r[k] += vol * amp;
+		k++;
+	}
+}
+
+/* Same for the noise channel, shifting the RNG at each edge */
+static void SN76496Noise(t_SN76496 *R, unsigned int *l, unsigned int *r, int n)
+{
+	unsigned int amp = R->Volume[3];
+	int k = 0;
+
+	while (k < n)
+	{
+		int vol, left;
+
+		if (R->Count[3] > STEP)
+		{
+			int run = (R->Count[3] - 1) / STEP;
+			if (run > n - k) run = n - k;
+			R->Count[3] -= run * STEP;
+			if (R->Output[3])
+			{
+				unsigned int v = STEP * amp;
+				int end = k + run;
+				int j;
+				if (l) for (j = k; j < end; j++) l[j] += v;
+				if (r) for (j = k; j < end; j++) r[j] += v;
+			}
+			k += run;
+			continue;
+		}
+
+		vol = 0;
+		left = STEP;
+		do
+		{
+			int nextevent;
+
+			if (R->Count[3] < left) nextevent = R->Count[3];
+			else nextevent = left;
+
+			if (R->Output[3]) vol += R->Count[3];
+			R->Count[3] -= nextevent;
+			if (R->Count[3] <= 0)
+			{
+				if (R->RNG & 1) R->RNG ^= R->NoiseFB;
+				R->RNG >>= 1;
+				R->Output[3] = R->RNG & 1;
+				R->Count[3] += R->Period[3];
+				if (R->Output[3]) vol += R->Period[3];
+			}
+			if (R->Output[3]) vol -= R->Count[3];
+
+			left -= nextevent;
+		} while (left > 0);
+
+		if (l) l[k] += vol * amp;
+		if (r) r[k] += vol * amp;
+		k++;
+	}
+}
+
+/* Render mono signed 16 bit samples straight into buffer. The channels are
+   summed exactly as SN76496Update does, then the two sides are averaged and
+   the DC level removed as each sample is written. */
+void SN76496UpdateMono(int chip,INT16 *buffer,int length, unsigned char mask)
+{
+	unsigned int acc[2][BLOCK];
+	int i, k, n;
+	t_SN76496 *R = &sn[chip];
+
+	/* channels that only play on one side need the sides summed apart */
+	int stereo = ((mask >> 4) ^ mask) & 0x0F;
+
+	/* If the volume is 0, increase the counter, see SN76496Update */
+	for (i = 0;i < 4;i++)
+	{
+		if (R->Volume[i] == 0)
+		{
+			if (R->Count[i] <= length*STEP) R->Count[i] += length*STEP;
+		}
+	}
+
+	for (; length > 0; length -= n, buffer += n)
+	{
+		n = (length < BLOCK) ? length : BLOCK;
+
+		memset(acc[0], 0, n * sizeof(unsigned int));
+		if (stereo) memset(acc[1], 0, n * sizeof(unsigned int));
+
+		for (i = 0;i < 4;i++)
+		{
+			unsigned int *l = (mask & (1 << (4+i))) ? acc[0] : 0;
+			unsigned int *r = (stereo && (mask & (1 << i))) ? acc[1] : 0;
+
+			/* silent channels still have to keep time */
+			if (R->Volume[i] == 0) l = r = 0;
+
+			if (i < 3) SN76496Tone(R, i, l, r, n);
+			else SN76496Noise(R, l, r, n);
+		}
+
+		for (k = 0; k < n; k++)
+		{
+			int s;
+			unsigned int out = acc[0][k];
+			if (out > MAX_OUTPUT * STEP) out = MAX_OUTPUT * STEP;
+			s = out / STEP;
+			if (stereo)
+			{
+				out = acc[1][k];
+				if (out > MAX_OUTPUT * STEP) out = MAX_OUTPUT * STEP;
+				s = (s + (int)(out / STEP)) >> 1;
+			}
+
+			R->Dc = (R->Dc * 31 + s) >> 5;    /* lo pass */
+			s -= R->Dc;                         /* signed */
+			if (s < -32767) s = -32767;         /* clip */
+			if (s > 32767) s = 32767;
+			buffer[k] = s;
+		}
+	}
+}
+
+
 
 void SN76496_set_clock(int chip,int clock)
 {
@@ -236,6 +410,8 @@ int SN76496_init(int chip,int clock,int volume,int sample_rate)
 		R->Period[i] = R->Count[i] = R->UpdateStep;
 	}
 	R->RNG = NG_PRESET;
+	R->NoiseFB = FB_PNOISE;	/* register 6 is 0, periodic noise */
+	R->Dc = 0;
 	R->Output[3] = R->RNG & 1;
 
     SN76496_set_gain(0, (volume >> 8) & 0xFF);
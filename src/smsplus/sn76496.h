@@ -17,12 +17,14 @@ typedef struct
 	int Period[4];
 	int Count[4];
 	int Output[4];
+	int Dc;             /* running average removed from the mono output */
 }t_SN76496;
 
 extern t_SN76496 sn[MAX_76496];
 
 void SN76496Write(int chip,int data);
 void SN76496Update(int chip, signed short int *buffer[2],int length,unsigned char mask);
+void SN76496UpdateMono(int chip, signed short int *buffer,int length,unsigned char mask);
 void SN76496_set_clock(int chip,int clock);
 void SN76496_set_gain(int chip,int gain);
 int SN76496_init(int chip,int clock,int volume,int sample_rate);
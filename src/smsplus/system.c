@@ -66,12 +66,7 @@ void audio_init(int rate)
     /* Calculate buffer size in samples */
     snd.bufsize = rate == 15720 ? 262 : 312;   // EWWWW
 
-    /* Sound output */
-    snd.buffer[0] = (signed short int *)malloc(snd.bufsize * 2);
-    snd.buffer[1] = (signed short int *)malloc(snd.bufsize * 2);
-    if(!snd.buffer[0] || !snd.buffer[1]) return;
-    memset(snd.buffer[0], 0, snd.bufsize * 2);
-    memset(snd.buffer[1], 0, snd.bufsize * 2);
+    /* Sound output is rendered into the caller's buffer by SN76496UpdateMono */
 
     /* YM2413 sound stream */
 //    snd.fm_buffer = (signed short int *)malloc(snd.bufsize * 2);
@@ -124,6 +119,47 @@ void system_reset(void)
 }
 
 
+/* Rebuild what the saved contexts point at or cache */
+static void system_restore(void)
+{
+    int i;
+
+    /* Restore callbacks */
+    z80_set_irq_callback(sms_irq_callback);
+
+    cpu_readmap[0] = cart.rom + 0x0000; /* 0000-3FFF */
+    cpu_readmap[1] = cart.rom + 0x2000;
+    cpu_readmap[2] = cart.rom + 0x4000; /* 4000-7FFF */
+    cpu_readmap[3] = cart.rom + 0x6000;
+    cpu_readmap[4] = cart.rom + 0x0000; /* 0000-3FFF */
+    cpu_readmap[5] = cart.rom + 0x2000;
+    cpu_readmap[6] = sms.ram;
+    cpu_readmap[7] = sms.ram;
+
+    cpu_writemap[0] = sms.dummy;
+    cpu_writemap[1] = sms.dummy;
+    cpu_writemap[2] = sms.dummy;         
+    cpu_writemap[3] = sms.dummy;
+    cpu_writemap[4] = sms.dummy;         
+    cpu_writemap[5] = sms.dummy;
+    cpu_writemap[6] = sms.ram;           
+    cpu_writemap[7] = sms.ram;
+
+    sms_mapper_w(3, sms.fcr[3]);
+    sms_mapper_w(2, sms.fcr[2]);
+    sms_mapper_w(1, sms.fcr[1]);
+    sms_mapper_w(0, sms.fcr[0]);
+
+    /* Force full pattern cache update */
+    for(i = 0; i < 0x200; i += 1)
+        vramMarkTileDirty(i);
+
+    /* Restore palette */
+    for(i = 0; i < PALETTE_SIZE; i += 1)
+        palette_sync(i);
+}
+
+
 void system_save_state(void *fd)
 {
     /* Save VDP context */
@@ -146,7 +182,6 @@ void system_save_state(void *fd)
 
 void system_load_state(void *fd)
 {
-    int i;
     uint8 reg[0x40];
 
     /* Initialize everything */
@@ -169,44 +204,14 @@ void system_load_state(void *fd)
     /* Load SN76489 context */
     //fread(&sn[0], sizeof(t_SN76496), 1, fd);
 
-    /* Restore callbacks */
-    z80_set_irq_callback(sms_irq_callback);
-
-    cpu_readmap[0] = cart.rom + 0x0000; /* 0000-3FFF */
-    cpu_readmap[1] = cart.rom + 0x2000;
-    cpu_readmap[2] = cart.rom + 0x4000; /* 4000-7FFF */
-    cpu_readmap[3] = cart.rom + 0x6000;
-    cpu_readmap[4] = cart.rom + 0x0000; /* 0000-3FFF */
-    cpu_readmap[5] = cart.rom + 0x2000;
-    cpu_readmap[6] = sms.ram;
-    cpu_readmap[7] = sms.ram;
-
-    cpu_writemap[0] = sms.dummy;
-    cpu_writemap[1] = sms.dummy;
-    cpu_writemap[2] = sms.dummy;         
-    cpu_writemap[3] = sms.dummy;
-    cpu_writemap[4] = sms.dummy;         
-    cpu_writemap[5] = sms.dummy;
-    cpu_writemap[6] = sms.ram;           
-    cpu_writemap[7] = sms.ram;
-
-    sms_mapper_w(3, sms.fcr[3]);
-    sms_mapper_w(2, sms.fcr[2]);
-    sms_mapper_w(1, sms.fcr[1]);
-    sms_mapper_w(0, sms.fcr[0]);
-
-    /* Force full pattern cache update */
-//    is_vram_dirty = 1;
-//    memset(vram_dirty, 1, 0x200);
-
-    /* Restore palette */
-    for(i = 0; i < PALETTE_SIZE; i += 1)
-        palette_sync(i);
+    system_restore();
 
     /* Restore sound state */
     if(snd.enabled)
     {
 #if 0
+        int i;
+
         /* Clear YM2413 context */
         OPLL_reset(opll) ;
         OPLL_reset_patch(opll,0) ;            /* if use default voice data. */ 
@@ -246,6 +251,49 @@ void system_load_state(void *fd)
     }
 }
 
+/* In memory snapshot: same contexts as the file state plus sound and SRAM.
+   Does not reset anything so it is cheap enough to take every frame. */
+#define STATE_ALIGN(n)  (((n) + 3) & ~3)
+
+int system_state_size(void)
+{
+    return STATE_ALIGN(sizeof(t_vdp)) + STATE_ALIGN(sizeof(t_sms)) + STATE_ALIGN(sizeof(Z80_Regs)) +
+        2*sizeof(int) + sizeof(t_SN76496) + 0x8000;
+}
+
+int system_save_state_mem(uint8 *buf)
+{
+    uint8 *p = buf;
+    memcpy(p, &vdp, sizeof(t_vdp));             p += STATE_ALIGN(sizeof(t_vdp));
+    memcpy(p, &sms, sizeof(t_sms));             p += STATE_ALIGN(sizeof(t_sms));
+    memcpy(p, Z80_Context, sizeof(Z80_Regs));   p += STATE_ALIGN(sizeof(Z80_Regs));
+    memcpy(p, &after_EI, sizeof(int));          p += sizeof(int);
+    memcpy(p, &z80_ICount, sizeof(int));        p += sizeof(int);
+    memcpy(p, &sn[0], sizeof(t_SN76496));       p += sizeof(t_SN76496);
+    if(sms.save)
+    {
+        memcpy(p, sms.sram, 0x8000);            p += 0x8000;
+    }
+    return p - buf;
+}
+
+int system_load_state_mem(const uint8 *buf)
+{
+    const uint8 *p = buf;
+    memcpy(&vdp, p, sizeof(t_vdp));             p += STATE_ALIGN(sizeof(t_vdp));
+    memcpy(&sms, p, sizeof(t_sms));             p += STATE_ALIGN(sizeof(t_sms));
+    memcpy(Z80_Context, p, sizeof(Z80_Regs));   p += STATE_ALIGN(sizeof(Z80_Regs));
+    memcpy(&after_EI, p, sizeof(int));          p += sizeof(int);
+    memcpy(&z80_ICount, p, sizeof(int));        p += sizeof(int);
+    memcpy(&sn[0], p, sizeof(t_SN76496));       p += sizeof(t_SN76496);
+    if(sms.save)
+    {
+        memcpy(sms.sram, p, 0x8000);            p += 0x8000;
+    }
+    system_restore();
+    return p - buf;
+}
+
 void ym2413_write(int chip, int offset, int data)
 {
 //    static uint8 latch = 0;
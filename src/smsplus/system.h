@@ -69,6 +69,7 @@ typedef struct
 typedef struct
 {
     unsigned char *data;
+    uint32 *hash;               /* per line of data, lines with the same id hold the same pixels, 0 if unknown */
     int width;
     int height;
     int pitch;
@@ -94,6 +95,9 @@ void system_reset(void);
 void system_load_sram(void);
 void system_save_state(void *fd);
 void system_load_state(void *fd);
+int system_state_size(void);
+int system_save_state_mem(uint8 *buf);
+int system_load_state_mem(const uint8 *buf);
 void audio_init(int rate);
 
 #endif /* _SYSTEM_H_ */
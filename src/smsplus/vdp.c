@@ -1,11 +1,41 @@
 #pragma GCC optimize ("O2")
 
 #include "shared.h"
+#include "../profile.h"
 
 
 /* VDP context */
 t_vdp vdp;
 
+/* Line scheduling. sms_frame runs the Z80 in one go up to the first cycle
+   of the next line where vdp_run has anything to do, and the line the CPU
+   is on is worked out from z80_ICount whenever it touches the VDP. The
+   lines in between get their vdp_run late, in vdp_sync(), before the CPU
+   touches VDP state.
+
+   Drawing waits longer still. Register and CRAM writes go into vdp_log
+   stamped with the line the CPU was on, and vdp_draw() replays them while
+   it renders a run of lines in one pass: at the end of the frame, or when
+   a VRAM write or status read needs every line up to the CPU drawn. */
+static int vdp_cycle;                   /* cycles into the frame the Z80 has run */
+static int vdp_target;                  /* cycle the running Z80 stops at, 0 if stopped */
+static int vdp_ran = LINES_PER_FRAME;   /* last line vdp_run has seen */
+static int vdp_drawn;                   /* lines below this are rendered */
+static int vdp_skip = 1;                /* frame isn't being drawn */
+
+#define VDP_LOG_SIZE    256
+
+typedef struct
+{
+    uint16 line;    /* takes effect from the line after this one */
+    uint8 index;    /* 0x00-0x0F register, 0x40-0x7F CRAM */
+    uint8 old;
+    uint8 data;
+}t_vdp_log;
+
+static t_vdp_log vdp_log[VDP_LOG_SIZE];
+static int vdp_logged;
+
 
 /* Return values from the V counter */
 const uint8 vcnt[0x200] =
@@ -75,6 +105,91 @@ void vdp_reset(void)
 }
 
 
+/* Store a register (0x00-0x0F) or CRAM (0x40-0x7F) byte */
+static void vdp_apply(int index, int data)
+{
+    if(index & 0x40)
+    {
+        vdp.cram[index & 0x3F] = data;
+        palette_sync((cart.type == TYPE_GG) ? ((index >> 1) & 0x1F) : (index & 0x1F));
+    }
+    else
+    {
+        vdp.reg[index] = data;
+
+        /* Update table addresses */
+        vdp.ntab = (vdp.reg[2] << 10) & 0x3800;
+        vdp.satb = (vdp.reg[5] << 7) & 0x3F00;
+    }
+}
+
+
+/* Work out the line the running Z80 is on from the cycles it has left */
+static void vdp_clock(void)
+{
+    if(vdp_target)
+    {
+        vdp.line = (vdp_target - z80_ICount) / CYCLES_PER_LINE;
+    }
+}
+
+
+/* Store a register or CRAM byte, logging it if undrawn lines need the old one */
+static void vdp_state_w(int index, int data)
+{
+    int line = (vdp.line < LINES_PER_FRAME) ? vdp.line : LINES_PER_FRAME - 1;
+
+    if(!vdp_skip && vdp_drawn <= line)
+    {
+        if(vdp_logged == VDP_LOG_SIZE)
+        {
+            vdp_draw();
+        }
+        else
+        {
+            t_vdp_log *e = &vdp_log[vdp_logged++];
+            e->line = line;
+            e->index = index;
+            e->old = (index & 0x40) ? vdp.cram[index & 0x3F] : vdp.reg[index];
+            e->data = data;
+        }
+    }
+
+    vdp_apply(index, data);
+}
+
+
+/* Render every undrawn line up to the given one, replaying the log */
+static void vdp_draw_to(int line)
+{
+    int i;
+
+    if(vdp_skip) return;
+
+    /* Rewind to what the first undrawn line saw */
+    for(i = vdp_logged - 1; i >= 0; i--)
+    {
+        vdp_apply(vdp_log[i].index, vdp_log[i].old);
+    }
+
+    for(i = 0; vdp_drawn <= line; vdp_drawn++)
+    {
+        while((i < vdp_logged) && (vdp_log[i].line < vdp_drawn))
+        {
+            vdp_apply(vdp_log[i].index, vdp_log[i].data);
+            i++;
+        }
+        PROF_ZONE(PROF_VIDEO,render_line(vdp_drawn));
+    }
+
+    for(; i < vdp_logged; i++)
+    {
+        vdp_apply(vdp_log[i].index, vdp_log[i].data);
+    }
+    vdp_logged = 0;
+}
+
+
 /* Write data to the VDP's control port */
 void vdp_ctrl_w(int data)
 {
@@ -114,12 +229,21 @@ void vdp_ctrl_w(int data)
             int r = (data & 0x0F);
             int d = vdp.latch;
 
+            /* Line events so far saw the old value */
+            vdp_clock();
+            vdp_sync();
+
             /* Store register data */
-            vdp.reg[r] = d;
+            vdp_state_w(r, d);
 
-            /* Update table addresses */
-            vdp.ntab = (vdp.reg[2] << 10) & 0x3800;
-            vdp.satb = (vdp.reg[5] << 7) & 0x3F00;
+            /* IRQ enables and the line counter can bring the next event
+               closer, stop the Z80 there instead */
+            r = vdp_next_event() * CYCLES_PER_LINE;
+            if(vdp_target && r < vdp_target)
+            {
+                z80_ICount -= (vdp_target - r);
+                vdp_target = r;
+            }
         }
     }
 }
@@ -128,8 +252,15 @@ void vdp_ctrl_w(int data)
 /* Read the status flags */
 int vdp_ctrl_r(void)
 {
+    uint8 temp;
+
+    /* Sprite collisions are flagged as lines are drawn */
+    vdp_clock();
+    vdp_sync();
+    vdp_draw();
+
     /* Save the status flags */
-    uint8 temp = vdp.status;
+    temp = vdp.status;
 
     /* Clear pending flag */
     vdp.pending = 0;
@@ -169,6 +300,10 @@ void vdp_data_w(int data)
             /* Only update if data is new */
             if(data != vdp.vram[index])
             {
+                /* Too big to log, draw what the old data covers */
+                vdp_clock();
+                vdp_draw();
+
                 /* Store VRAM byte */
                 vdp.vram[index] = data;
 
@@ -183,9 +318,8 @@ void vdp_data_w(int data)
                 index = (vdp.addr & 0x3F);
                 if(data != vdp.cram[index])
                 {
-                    vdp.cram[index] = data;
-                    index = (vdp.addr >> 1) & 0x1F;
-                    palette_sync(index);
+                    vdp_clock();
+                    vdp_state_w(0x40 | index, data);
                 }
             }
             else
@@ -193,8 +327,8 @@ void vdp_data_w(int data)
                 index = (vdp.addr & 0x1F);
                 if(data != vdp.cram[index])
                 {
-                    vdp.cram[index] = data;
-                    palette_sync(index);
+                    vdp_clock();
+                    vdp_state_w(0x40 | index, data);
                 }
             }
             break;
@@ -218,16 +352,16 @@ int vdp_data_r(void)
 
 
 /* Process frame events */
-void vdp_run(void)
+static void vdp_run_line(int line)
 {
-    if(vdp.line <= 0xC0)
+    if(line <= 0xC0)
     {
-        if(vdp.line == 0xC0)
+        if(line == 0xC0)
         {
             vdp.status |= 0x80;
         }
 
-        if(vdp.line == 0)
+        if(line == 0)
         {
             vdp.left = vdp.reg[10];
         }
@@ -252,7 +386,7 @@ void vdp_run(void)
     {
         vdp.left = vdp.reg[10];
 
-        if((vdp.line < 0xE0) && (vdp.status & 0x80) && (vdp.reg[1] & 0x20))
+        if((line < 0xE0) && (vdp.status & 0x80) && (vdp.reg[1] & 0x20))
         {
             sms.irq = 1;
             z80_set_irq_line(0, ASSERT_LINE);
@@ -261,8 +395,96 @@ void vdp_run(void)
 }
 
 
+void vdp_run(void)
+{
+    vdp_run_line(vdp.line);
+}
+
+
+/* First line after the current one where vdp_run sets a status flag or
+   raises an IRQ. Lines before it only count down the line counter. */
+int vdp_next_event(void)
+{
+    int line = vdp.line;
+
+    if(line < 0xC0)
+    {
+        int next;
+
+        /* A pending line interrupt is raised again every line */
+        if((vdp.status & 0x40) && (vdp.reg[0] & 0x10)) return (line + 1);
+
+        /* The counter underflows after another vdp.left lines */
+        next = line + 1 + vdp.left;
+        return (next < 0xC0 ? next : 0xC0);
+    }
+
+    if((line < 0xDF) && (vdp.status & 0x80) && (vdp.reg[1] & 0x20)) return (line + 1);
+
+    return (LINES_PER_FRAME);
+}
+
+
+/* Cycles to run the Z80 for, up to the start of the next event line */
+int vdp_cpu_begin(void)
+{
+    vdp_target = vdp_next_event() * CYCLES_PER_LINE;
+    return (vdp_target - vdp_cycle);
+}
+
+
+/* The Z80 stopped, its overshoot is carried into the next run */
+void vdp_cpu_end(void)
+{
+    vdp_cycle = vdp_target - z80_ICount;
+    vdp.line = vdp_cycle / CYCLES_PER_LINE;
+    vdp_target = 0;
+}
+
+
+/* Start a frame, lines are drawn unless skip_render is set */
+void vdp_frame_begin(int skip_render)
+{
+    vdp.line = 0;
+    vdp_cycle = 0;                      /* overshoot past the last line is dropped */
+    vdp_skip = skip_render;
+    vdp_drawn = 0;
+    vdp_ran = -1;
+    vdp_logged = 0;
+}
+
+
+/* Catch up line events to the line the CPU is on */
+void vdp_sync(void)
+{
+    int line = (vdp.line < LINES_PER_FRAME) ? vdp.line : LINES_PER_FRAME - 1;
+
+    while(vdp_ran < line)
+    {
+        vdp_run_line(++vdp_ran);
+    }
+}
+
+
+/* Draw every line up to the one the CPU is on */
+void vdp_draw(void)
+{
+    vdp_draw_to((vdp.line < LINES_PER_FRAME) ? vdp.line : LINES_PER_FRAME - 1);
+}
+
+
+/* Finish the frame's line events and draw it in one pass */
+void vdp_frame_end(void)
+{
+    vdp_sync();
+    vdp_draw_to(LINES_PER_FRAME - 1);
+    vdp_skip = 1;
+}
+
+
 uint8 vdp_vcounter_r(void)
 {
+    vdp_clock();
     return (vcnt[(vdp.line & 0x1FF)]);
 }
 
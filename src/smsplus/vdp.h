@@ -40,6 +40,13 @@ uint8 vdp_hcounter_r(void);
 void vdp_data_w(int data);
 int vdp_data_r(void);
 void vdp_run(void);
+int vdp_next_event(void);
+int vdp_cpu_begin(void);
+void vdp_cpu_end(void);
+void vdp_frame_begin(int skip_render);
+void vdp_sync(void);
+void vdp_draw(void);
+void vdp_frame_end(void);
 
 #endif /* _VDP_H_ */
 
@@ -84,6 +84,16 @@ unsigned char *cpu_writemap[8];
 #define BIG_SWITCH              1
 #endif
 
+/* execute the opcodes threaded with computed gotos, keeping the
+   main registers and the T-state count in locals (GCC only) */
+#ifndef Z80_JUMPTABLE
+#ifdef __GNUC__
+#define Z80_JUMPTABLE           1
+#else
+#define Z80_JUMPTABLE           0
+#endif
+#endif
+
 /* big flags array for ADD/ADC/SUB/SBC/CP results */
 #define BIG_FLAGS_ARRAY         0
 
@@ -169,6 +179,8 @@ unsigned char *cpu_writemap[8];
 #define _IFF2	Z80.IFF2
 #define _HALT	Z80.HALT
 
+#define REG16(r)	Z80.r		/* register pair by name, for RM16/WM16 and EX */
+
 int z80_ICount;
 static Z80_Regs Z80;
 Z80_Regs *Z80_Context = &Z80;
@@ -634,12 +646,12 @@ static __inline__ UINT32 ARG16(void)
 /***************************************************************
  * POP
  ***************************************************************/
-#define POP(DR) { RM16( _SPD, &Z80.DR ); _SP += 2; }
+#define POP(DR) { RM16( _SPD, &REG16(DR) ); _SP += 2; }
 
 /***************************************************************
  * PUSH
  ***************************************************************/
-#define PUSH(SR) { _SP -= 2; WM16( _SPD, &Z80.SR ); }
+#define PUSH(SR) { _SP -= 2; WM16( _SPD, &REG16(SR) ); }
 
 /***************************************************************
  * JP
@@ -1276,7 +1288,7 @@ static __inline__ UINT8 DEC(UINT8 value)
  ***************************************************************/
 #define EX_AF {                                                 \
 	PAIR tmp;													\
-    tmp = Z80.AF; Z80.AF = Z80.AF2; Z80.AF2 = tmp;              \
+    tmp = REG16(AF); REG16(AF) = Z80.AF2; Z80.AF2 = tmp;       \
 }
 
 /***************************************************************
@@ -1284,7 +1296,7 @@ static __inline__ UINT8 DEC(UINT8 value)
  ***************************************************************/
 #define EX_DE_HL {                                              \
 	PAIR tmp;													\
-    tmp = Z80.DE; Z80.DE = Z80.HL; Z80.HL = tmp;                \
+    tmp = REG16(DE); REG16(DE) = REG16(HL); REG16(HL) = tmp;   \
 }
 
 /***************************************************************
@@ -1292,9 +1304,9 @@ static __inline__ UINT8 DEC(UINT8 value)
  ***************************************************************/
 #define EXX {                                                   \
 	PAIR tmp;													\
-    tmp = Z80.BC; Z80.BC = Z80.BC2; Z80.BC2 = tmp;              \
-    tmp = Z80.DE; Z80.DE = Z80.DE2; Z80.DE2 = tmp;              \
-    tmp = Z80.HL; Z80.HL = Z80.HL2; Z80.HL2 = tmp;              \
+    tmp = REG16(BC); REG16(BC) = Z80.BC2; Z80.BC2 = tmp;       \
+    tmp = REG16(DE); REG16(DE) = Z80.DE2; Z80.DE2 = tmp;       \
+    tmp = REG16(HL); REG16(HL) = Z80.HL2; Z80.HL2 = tmp;       \
 }
 
 /***************************************************************
@@ -1304,8 +1316,8 @@ static __inline__ UINT8 DEC(UINT8 value)
 {																\
 	PAIR tmp = { { 0, 0, 0, 0 } };								\
 	RM16( _SPD, &tmp ); 										\
-	WM16( _SPD, &Z80.DR );										\
-	Z80.DR = tmp;												\
+	WM16( _SPD, &REG16(DR) );										\
+	REG16(DR) = tmp;												\
 }
 
 
@@ -1325,8 +1337,8 @@ static __inline__ UINT8 DEC(UINT8 value)
  " movb %%ch,%%ah       \n" /* get result MSB */                \
  " andb $0x28,%%ah      \n" /* maks flags 5+3 */                \
  " orb %%ah,%1          \n" /* put them into flags */           \
- :"=c" (Z80.DR.d), "=r" (_F)                                    \
- :"0" (Z80.DR.d), "1" (_F), "d" (Z80.SR.d)                      \
+ :"=c" (REG16(DR).d), "=r" (_F)                                \
+ :"0" (REG16(DR).d), "1" (_F), "d" (REG16(SR).d)               \
  )
 #else
 #define ADD16(DR,SR)                                            \
@@ -1337,18 +1349,18 @@ static __inline__ UINT8 DEC(UINT8 value)
  " lahf                 \n"                                     \
  " andb $0x11,%%ah      \n"                                     \
  " orb %%ah,%1          \n"                                     \
- :"=c" (Z80.DR.d), "=r" (_F)                                    \
- :"0" (Z80.DR.d), "1" (_F), "d" (Z80.SR.d)                      \
+ :"=c" (REG16(DR).d), "=r" (_F)                                \
+ :"0" (REG16(DR).d), "1" (_F), "d" (REG16(SR).d)               \
  )
 #endif
 #else
 #define ADD16(DR,SR)											\
 {																\
-	UINT32 res = Z80.DR.d + Z80.SR.d;							\
+	UINT32 res = REG16(DR).d + REG16(SR).d;							\
 	_F = (_F & (SF | ZF | VF)) |								\
-		(((Z80.DR.d ^ res ^ Z80.SR.d) >> 8) & HF) | 			\
+		(((REG16(DR).d ^ res ^ REG16(SR).d) >> 8) & HF) | 			\
 		((res >> 16) & CF); 									\
-	Z80.DR.w.l = (UINT16)res;									\
+	REG16(DR).w.l = (UINT16)res;									\
 }
 #endif
 
@@ -1376,7 +1388,7 @@ static __inline__ UINT8 DEC(UINT8 value)
  " andb $0x28,%%ah      \n" /* maks flags 5+3 */                \
  " orb %%ah,%1          \n" /* put them into flags */           \
  :"=c" (_HLD), "=r" (_F)                                        \
- :"0" (_HLD), "1" (_F), "d" (Z80.Reg.d)                         \
+ :"0" (_HLD), "1" (_F), "d" (REG16(Reg).d)                     \
  )
 #else
 #define ADC16(Reg)                                              \
@@ -1395,18 +1407,18 @@ static __inline__ UINT8 DEC(UINT8 value)
  " orb %%ah,%1          \n" /* overflow into P/V */             \
  " andb %%dl,%1         \n" /* mask zero */                     \
  :"=c" (_HLD), "=r" (_F)                                        \
- :"0" (_HLD), "1" (_F), "d" (Z80.Reg.d)                         \
+ :"0" (_HLD), "1" (_F), "d" (REG16(Reg).d)                     \
  )
 #endif
 #else
 #define ADC16(Reg)												\
 {																\
-	UINT32 res = _HLD + Z80.Reg.d + (_F & CF);					\
-	_F = (((_HLD ^ res ^ Z80.Reg.d) >> 8) & HF) |				\
+	UINT32 res = _HLD + REG16(Reg).d + (_F & CF);					\
+	_F = (((_HLD ^ res ^ REG16(Reg).d) >> 8) & HF) |				\
 		((res >> 16) & CF) |									\
 		((res >> 8) & SF) | 									\
 		((res & 0xffff) ? 0 : ZF) | 							\
-		(((Z80.Reg.d ^ _HLD ^ 0x8000) & (Z80.Reg.d ^ res) & 0x8000) >> 13); \
+		(((REG16(Reg).d ^ _HLD ^ 0x8000) & (REG16(Reg).d ^ res) & 0x8000) >> 13); \
 	_HL = (UINT16)res;											\
 }
 #endif
@@ -1436,7 +1448,7 @@ asm (															\
  " andb $0x28,%%ah      \n" /* maks flags 5+3 */                \
  " orb %%ah,%1          \n" /* put them into flags */           \
  :"=c" (_HLD), "=r" (_F)                                        \
- :"0" (_HLD), "1" (_F), "d" (Z80.Reg.d)                         \
+ :"0" (_HLD), "1" (_F), "d" (REG16(Reg).d)                     \
  )
 #else
 #define SBC16(Reg)                                              \
@@ -1456,18 +1468,18 @@ asm (															\
  " orb %%ah,%1          \n" /* overflow into P/V */             \
  " andb %%dl,%1         \n" /* mask zero */                     \
  :"=c" (_HLD), "=r" (_F)                                        \
- :"0" (_HLD), "1" (_F), "d" (Z80.Reg.d)                         \
+ :"0" (_HLD), "1" (_F), "d" (REG16(Reg).d)                     \
  )
 #endif
 #else
 #define SBC16(Reg)												\
 {																\
-	UINT32 res = _HLD - Z80.Reg.d - (_F & CF);					\
-	_F = (((_HLD ^ res ^ Z80.Reg.d) >> 8) & HF) | NF |			\
+	UINT32 res = _HLD - REG16(Reg).d - (_F & CF);					\
+	_F = (((_HLD ^ res ^ REG16(Reg).d) >> 8) & HF) | NF |			\
 		((res >> 16) & CF) |									\
 		((res >> 8) & SF) | 									\
 		((res & 0xffff) ? 0 : ZF) | 							\
-		(((Z80.Reg.d ^ _HLD) & (_HLD ^ res) &0x8000) >> 13);	\
+		(((REG16(Reg).d ^ _HLD) & (_HLD ^ res) &0x8000) >> 13);	\
 	_HL = (UINT16)res;											\
 }
 #endif
@@ -2073,1472 +2085,6 @@ static __inline__ UINT8 SET(UINT8 bit, UINT8 value)
     } else _IFF2 = 1;                                           \
 }
 
-/**********************************************************
- * opcodes with CB prefix
- * rotate, shift and bit operations
- **********************************************************/
-OP(cb,00) { _B = RLC(_B);											} /* RLC  B 		  */
-OP(cb,01) { _C = RLC(_C);											} /* RLC  C 		  */
-OP(cb,02) { _D = RLC(_D);											} /* RLC  D 		  */
-OP(cb,03) { _E = RLC(_E);											} /* RLC  E 		  */
-OP(cb,04) { _H = RLC(_H);											} /* RLC  H 		  */
-OP(cb,05) { _L = RLC(_L);											} /* RLC  L 		  */
-OP(cb,06) { WM( _HL, RLC(RM(_HL)) );								} /* RLC  (HL)		  */
-OP(cb,07) { _A = RLC(_A);											} /* RLC  A 		  */
-
-OP(cb,08) { _B = RRC(_B);											} /* RRC  B 		  */
-OP(cb,09) { _C = RRC(_C);											} /* RRC  C 		  */
-OP(cb,0a) { _D = RRC(_D);											} /* RRC  D 		  */
-OP(cb,0b) { _E = RRC(_E);											} /* RRC  E 		  */
-OP(cb,0c) { _H = RRC(_H);											} /* RRC  H 		  */
-OP(cb,0d) { _L = RRC(_L);											} /* RRC  L 		  */
-OP(cb,0e) { WM( _HL, RRC(RM(_HL)) );								} /* RRC  (HL)		  */
-OP(cb,0f) { _A = RRC(_A);											} /* RRC  A 		  */
-
-OP(cb,10) { _B = RL(_B);											} /* RL   B 		  */
-OP(cb,11) { _C = RL(_C);											} /* RL   C 		  */
-OP(cb,12) { _D = RL(_D);											} /* RL   D 		  */
-OP(cb,13) { _E = RL(_E);											} /* RL   E 		  */
-OP(cb,14) { _H = RL(_H);											} /* RL   H 		  */
-OP(cb,15) { _L = RL(_L);											} /* RL   L 		  */
-OP(cb,16) { WM( _HL, RL(RM(_HL)) ); 								} /* RL   (HL)		  */
-OP(cb,17) { _A = RL(_A);											} /* RL   A 		  */
-
-OP(cb,18) { _B = RR(_B);											} /* RR   B 		  */
-OP(cb,19) { _C = RR(_C);											} /* RR   C 		  */
-OP(cb,1a) { _D = RR(_D);											} /* RR   D 		  */
-OP(cb,1b) { _E = RR(_E);											} /* RR   E 		  */
-OP(cb,1c) { _H = RR(_H);											} /* RR   H 		  */
-OP(cb,1d) { _L = RR(_L);											} /* RR   L 		  */
-OP(cb,1e) { WM( _HL, RR(RM(_HL)) ); 								} /* RR   (HL)		  */
-OP(cb,1f) { _A = RR(_A);											} /* RR   A 		  */
-
-OP(cb,20) { _B = SLA(_B);											} /* SLA  B 		  */
-OP(cb,21) { _C = SLA(_C);											} /* SLA  C 		  */
-OP(cb,22) { _D = SLA(_D);											} /* SLA  D 		  */
-OP(cb,23) { _E = SLA(_E);											} /* SLA  E 		  */
-OP(cb,24) { _H = SLA(_H);											} /* SLA  H 		  */
-OP(cb,25) { _L = SLA(_L);											} /* SLA  L 		  */
-OP(cb,26) { WM( _HL, SLA(RM(_HL)) );								} /* SLA  (HL)		  */
-OP(cb,27) { _A = SLA(_A);											} /* SLA  A 		  */
-
-OP(cb,28) { _B = SRA(_B);											} /* SRA  B 		  */
-OP(cb,29) { _C = SRA(_C);											} /* SRA  C 		  */
-OP(cb,2a) { _D = SRA(_D);											} /* SRA  D 		  */
-OP(cb,2b) { _E = SRA(_E);											} /* SRA  E 		  */
-OP(cb,2c) { _H = SRA(_H);											} /* SRA  H 		  */
-OP(cb,2d) { _L = SRA(_L);											} /* SRA  L 		  */
-OP(cb,2e) { WM( _HL, SRA(RM(_HL)) );								} /* SRA  (HL)		  */
-OP(cb,2f) { _A = SRA(_A);											} /* SRA  A 		  */
-
-OP(cb,30) { _B = SLL(_B);											} /* SLL  B 		  */
-OP(cb,31) { _C = SLL(_C);											} /* SLL  C 		  */
-OP(cb,32) { _D = SLL(_D);											} /* SLL  D 		  */
-OP(cb,33) { _E = SLL(_E);											} /* SLL  E 		  */
-OP(cb,34) { _H = SLL(_H);											} /* SLL  H 		  */
-OP(cb,35) { _L = SLL(_L);											} /* SLL  L 		  */
-OP(cb,36) { WM( _HL, SLL(RM(_HL)) );								} /* SLL  (HL)		  */
-OP(cb,37) { _A = SLL(_A);											} /* SLL  A 		  */
-
-OP(cb,38) { _B = SRL(_B);											} /* SRL  B 		  */
-OP(cb,39) { _C = SRL(_C);											} /* SRL  C 		  */
-OP(cb,3a) { _D = SRL(_D);											} /* SRL  D 		  */
-OP(cb,3b) { _E = SRL(_E);											} /* SRL  E 		  */
-OP(cb,3c) { _H = SRL(_H);											} /* SRL  H 		  */
-OP(cb,3d) { _L = SRL(_L);											} /* SRL  L 		  */
-OP(cb,3e) { WM( _HL, SRL(RM(_HL)) );								} /* SRL  (HL)		  */
-OP(cb,3f) { _A = SRL(_A);											} /* SRL  A 		  */
-
-OP(cb,40) { BIT(0,_B);												} /* BIT  0,B		  */
-OP(cb,41) { BIT(0,_C);												} /* BIT  0,C		  */
-OP(cb,42) { BIT(0,_D);												} /* BIT  0,D		  */
-OP(cb,43) { BIT(0,_E);												} /* BIT  0,E		  */
-OP(cb,44) { BIT(0,_H);												} /* BIT  0,H		  */
-OP(cb,45) { BIT(0,_L);												} /* BIT  0,L		  */
-OP(cb,46) { BIT(0,RM(_HL)); 										} /* BIT  0,(HL)	  */
-OP(cb,47) { BIT(0,_A);												} /* BIT  0,A		  */
-
-OP(cb,48) { BIT(1,_B);												} /* BIT  1,B		  */
-OP(cb,49) { BIT(1,_C);												} /* BIT  1,C		  */
-OP(cb,4a) { BIT(1,_D);												} /* BIT  1,D		  */
-OP(cb,4b) { BIT(1,_E);												} /* BIT  1,E		  */
-OP(cb,4c) { BIT(1,_H);												} /* BIT  1,H		  */
-OP(cb,4d) { BIT(1,_L);												} /* BIT  1,L		  */
-OP(cb,4e) { BIT(1,RM(_HL)); 										} /* BIT  1,(HL)	  */
-OP(cb,4f) { BIT(1,_A);												} /* BIT  1,A		  */
-
-OP(cb,50) { BIT(2,_B);												} /* BIT  2,B		  */
-OP(cb,51) { BIT(2,_C);												} /* BIT  2,C		  */
-OP(cb,52) { BIT(2,_D);												} /* BIT  2,D		  */
-OP(cb,53) { BIT(2,_E);												} /* BIT  2,E		  */
-OP(cb,54) { BIT(2,_H);												} /* BIT  2,H		  */
-OP(cb,55) { BIT(2,_L);												} /* BIT  2,L		  */
-OP(cb,56) { BIT(2,RM(_HL)); 										} /* BIT  2,(HL)	  */
-OP(cb,57) { BIT(2,_A);												} /* BIT  2,A		  */
-
-OP(cb,58) { BIT(3,_B);												} /* BIT  3,B		  */
-OP(cb,59) { BIT(3,_C);												} /* BIT  3,C		  */
-OP(cb,5a) { BIT(3,_D);												} /* BIT  3,D		  */
-OP(cb,5b) { BIT(3,_E);												} /* BIT  3,E		  */
-OP(cb,5c) { BIT(3,_H);												} /* BIT  3,H		  */
-OP(cb,5d) { BIT(3,_L);												} /* BIT  3,L		  */
-OP(cb,5e) { BIT(3,RM(_HL)); 										} /* BIT  3,(HL)	  */
-OP(cb,5f) { BIT(3,_A);												} /* BIT  3,A		  */
-
-OP(cb,60) { BIT(4,_B);												} /* BIT  4,B		  */
-OP(cb,61) { BIT(4,_C);												} /* BIT  4,C		  */
-OP(cb,62) { BIT(4,_D);												} /* BIT  4,D		  */
-OP(cb,63) { BIT(4,_E);												} /* BIT  4,E		  */
-OP(cb,64) { BIT(4,_H);												} /* BIT  4,H		  */
-OP(cb,65) { BIT(4,_L);												} /* BIT  4,L		  */
-OP(cb,66) { BIT(4,RM(_HL)); 										} /* BIT  4,(HL)	  */
-OP(cb,67) { BIT(4,_A);												} /* BIT  4,A		  */
-
-OP(cb,68) { BIT(5,_B);												} /* BIT  5,B		  */
-OP(cb,69) { BIT(5,_C);												} /* BIT  5,C		  */
-OP(cb,6a) { BIT(5,_D);												} /* BIT  5,D		  */
-OP(cb,6b) { BIT(5,_E);												} /* BIT  5,E		  */
-OP(cb,6c) { BIT(5,_H);												} /* BIT  5,H		  */
-OP(cb,6d) { BIT(5,_L);												} /* BIT  5,L		  */
-OP(cb,6e) { BIT(5,RM(_HL)); 										} /* BIT  5,(HL)	  */
-OP(cb,6f) { BIT(5,_A);												} /* BIT  5,A		  */
-
-OP(cb,70) { BIT(6,_B);												} /* BIT  6,B		  */
-OP(cb,71) { BIT(6,_C);												} /* BIT  6,C		  */
-OP(cb,72) { BIT(6,_D);												} /* BIT  6,D		  */
-OP(cb,73) { BIT(6,_E);												} /* BIT  6,E		  */
-OP(cb,74) { BIT(6,_H);												} /* BIT  6,H		  */
-OP(cb,75) { BIT(6,_L);												} /* BIT  6,L		  */
-OP(cb,76) { BIT(6,RM(_HL)); 										} /* BIT  6,(HL)	  */
-OP(cb,77) { BIT(6,_A);												} /* BIT  6,A		  */
-
-OP(cb,78) { BIT(7,_B);												} /* BIT  7,B		  */
-OP(cb,79) { BIT(7,_C);												} /* BIT  7,C		  */
-OP(cb,7a) { BIT(7,_D);												} /* BIT  7,D		  */
-OP(cb,7b) { BIT(7,_E);												} /* BIT  7,E		  */
-OP(cb,7c) { BIT(7,_H);												} /* BIT  7,H		  */
-OP(cb,7d) { BIT(7,_L);												} /* BIT  7,L		  */
-OP(cb,7e) { BIT(7,RM(_HL)); 										} /* BIT  7,(HL)	  */
-OP(cb,7f) { BIT(7,_A);												} /* BIT  7,A		  */
-
-OP(cb,80) { _B = RES(0,_B); 										} /* RES  0,B		  */
-OP(cb,81) { _C = RES(0,_C); 										} /* RES  0,C		  */
-OP(cb,82) { _D = RES(0,_D); 										} /* RES  0,D		  */
-OP(cb,83) { _E = RES(0,_E); 										} /* RES  0,E		  */
-OP(cb,84) { _H = RES(0,_H); 										} /* RES  0,H		  */
-OP(cb,85) { _L = RES(0,_L); 										} /* RES  0,L		  */
-OP(cb,86) { WM( _HL, RES(0,RM(_HL)) );								} /* RES  0,(HL)	  */
-OP(cb,87) { _A = RES(0,_A); 										} /* RES  0,A		  */
-
-OP(cb,88) { _B = RES(1,_B); 										} /* RES  1,B		  */
-OP(cb,89) { _C = RES(1,_C); 										} /* RES  1,C		  */
-OP(cb,8a) { _D = RES(1,_D); 										} /* RES  1,D		  */
-OP(cb,8b) { _E = RES(1,_E); 										} /* RES  1,E		  */
-OP(cb,8c) { _H = RES(1,_H); 										} /* RES  1,H		  */
-OP(cb,8d) { _L = RES(1,_L); 										} /* RES  1,L		  */
-OP(cb,8e) { WM( _HL, RES(1,RM(_HL)) );								} /* RES  1,(HL)	  */
-OP(cb,8f) { _A = RES(1,_A); 										} /* RES  1,A		  */
-
-OP(cb,90) { _B = RES(2,_B); 										} /* RES  2,B		  */
-OP(cb,91) { _C = RES(2,_C); 										} /* RES  2,C		  */
-OP(cb,92) { _D = RES(2,_D); 										} /* RES  2,D		  */
-OP(cb,93) { _E = RES(2,_E); 										} /* RES  2,E		  */
-OP(cb,94) { _H = RES(2,_H); 										} /* RES  2,H		  */
-OP(cb,95) { _L = RES(2,_L); 										} /* RES  2,L		  */
-OP(cb,96) { WM( _HL, RES(2,RM(_HL)) );								} /* RES  2,(HL)	  */
-OP(cb,97) { _A = RES(2,_A); 										} /* RES  2,A		  */
-
-OP(cb,98) { _B = RES(3,_B); 										} /* RES  3,B		  */
-OP(cb,99) { _C = RES(3,_C); 										} /* RES  3,C		  */
-OP(cb,9a) { _D = RES(3,_D); 										} /* RES  3,D		  */
-OP(cb,9b) { _E = RES(3,_E); 										} /* RES  3,E		  */
-OP(cb,9c) { _H = RES(3,_H); 										} /* RES  3,H		  */
-OP(cb,9d) { _L = RES(3,_L); 										} /* RES  3,L		  */
-OP(cb,9e) { WM( _HL, RES(3,RM(_HL)) );								} /* RES  3,(HL)	  */
-OP(cb,9f) { _A = RES(3,_A); 										} /* RES  3,A		  */
-
-OP(cb,a0) { _B = RES(4,_B); 										} /* RES  4,B		  */
-OP(cb,a1) { _C = RES(4,_C); 										} /* RES  4,C		  */
-OP(cb,a2) { _D = RES(4,_D); 										} /* RES  4,D		  */
-OP(cb,a3) { _E = RES(4,_E); 										} /* RES  4,E		  */
-OP(cb,a4) { _H = RES(4,_H); 										} /* RES  4,H		  */
-OP(cb,a5) { _L = RES(4,_L); 										} /* RES  4,L		  */
-OP(cb,a6) { WM( _HL, RES(4,RM(_HL)) );								} /* RES  4,(HL)	  */
-OP(cb,a7) { _A = RES(4,_A); 										} /* RES  4,A		  */
-
-OP(cb,a8) { _B = RES(5,_B); 										} /* RES  5,B		  */
-OP(cb,a9) { _C = RES(5,_C); 										} /* RES  5,C		  */
-OP(cb,aa) { _D = RES(5,_D); 										} /* RES  5,D		  */
-OP(cb,ab) { _E = RES(5,_E); 										} /* RES  5,E		  */
-OP(cb,ac) { _H = RES(5,_H); 										} /* RES  5,H		  */
-OP(cb,ad) { _L = RES(5,_L); 										} /* RES  5,L		  */
-OP(cb,ae) { WM( _HL, RES(5,RM(_HL)) );								} /* RES  5,(HL)	  */
-OP(cb,af) { _A = RES(5,_A); 										} /* RES  5,A		  */
-
-OP(cb,b0) { _B = RES(6,_B); 										} /* RES  6,B		  */
-OP(cb,b1) { _C = RES(6,_C); 										} /* RES  6,C		  */
-OP(cb,b2) { _D = RES(6,_D); 										} /* RES  6,D		  */
-OP(cb,b3) { _E = RES(6,_E); 										} /* RES  6,E		  */
-OP(cb,b4) { _H = RES(6,_H); 										} /* RES  6,H		  */
-OP(cb,b5) { _L = RES(6,_L); 										} /* RES  6,L		  */
-OP(cb,b6) { WM( _HL, RES(6,RM(_HL)) );								} /* RES  6,(HL)	  */
-OP(cb,b7) { _A = RES(6,_A); 										} /* RES  6,A		  */
-
-OP(cb,b8) { _B = RES(7,_B); 										} /* RES  7,B		  */
-OP(cb,b9) { _C = RES(7,_C); 										} /* RES  7,C		  */
-OP(cb,ba) { _D = RES(7,_D); 										} /* RES  7,D		  */
-OP(cb,bb) { _E = RES(7,_E); 										} /* RES  7,E		  */
-OP(cb,bc) { _H = RES(7,_H); 										} /* RES  7,H		  */
-OP(cb,bd) { _L = RES(7,_L); 										} /* RES  7,L		  */
-OP(cb,be) { WM( _HL, RES(7,RM(_HL)) );								} /* RES  7,(HL)	  */
-OP(cb,bf) { _A = RES(7,_A); 										} /* RES  7,A		  */
-
-OP(cb,c0) { _B = SET(0,_B); 										} /* SET  0,B		  */
-OP(cb,c1) { _C = SET(0,_C); 										} /* SET  0,C		  */
-OP(cb,c2) { _D = SET(0,_D); 										} /* SET  0,D		  */
-OP(cb,c3) { _E = SET(0,_E); 										} /* SET  0,E		  */
-OP(cb,c4) { _H = SET(0,_H); 										} /* SET  0,H		  */
-OP(cb,c5) { _L = SET(0,_L); 										} /* SET  0,L		  */
-OP(cb,c6) { WM( _HL, SET(0,RM(_HL)) );								} /* SET  0,(HL)	  */
-OP(cb,c7) { _A = SET(0,_A); 										} /* SET  0,A		  */
-
-OP(cb,c8) { _B = SET(1,_B); 										} /* SET  1,B		  */
-OP(cb,c9) { _C = SET(1,_C); 										} /* SET  1,C		  */
-OP(cb,ca) { _D = SET(1,_D); 										} /* SET  1,D		  */
-OP(cb,cb) { _E = SET(1,_E); 										} /* SET  1,E		  */
-OP(cb,cc) { _H = SET(1,_H); 										} /* SET  1,H		  */
-OP(cb,cd) { _L = SET(1,_L); 										} /* SET  1,L		  */
-OP(cb,ce) { WM( _HL, SET(1,RM(_HL)) );								} /* SET  1,(HL)	  */
-OP(cb,cf) { _A = SET(1,_A); 										} /* SET  1,A		  */
-
-OP(cb,d0) { _B = SET(2,_B); 										} /* SET  2,B		  */
-OP(cb,d1) { _C = SET(2,_C); 										} /* SET  2,C		  */
-OP(cb,d2) { _D = SET(2,_D); 										} /* SET  2,D		  */
-OP(cb,d3) { _E = SET(2,_E); 										} /* SET  2,E		  */
-OP(cb,d4) { _H = SET(2,_H); 										} /* SET  2,H		  */
-OP(cb,d5) { _L = SET(2,_L); 										} /* SET  2,L		  */
-OP(cb,d6) { WM( _HL, SET(2,RM(_HL)) );								}/* SET  2,(HL) 	 */
-OP(cb,d7) { _A = SET(2,_A); 										} /* SET  2,A		  */
-
-OP(cb,d8) { _B = SET(3,_B); 										} /* SET  3,B		  */
-OP(cb,d9) { _C = SET(3,_C); 										} /* SET  3,C		  */
-OP(cb,da) { _D = SET(3,_D); 										} /* SET  3,D		  */
-OP(cb,db) { _E = SET(3,_E); 										} /* SET  3,E		  */
-OP(cb,dc) { _H = SET(3,_H); 										} /* SET  3,H		  */
-OP(cb,dd) { _L = SET(3,_L); 										} /* SET  3,L		  */
-OP(cb,de) { WM( _HL, SET(3,RM(_HL)) );								} /* SET  3,(HL)	  */
-OP(cb,df) { _A = SET(3,_A); 										} /* SET  3,A		  */
-
-OP(cb,e0) { _B = SET(4,_B); 										} /* SET  4,B		  */
-OP(cb,e1) { _C = SET(4,_C); 										} /* SET  4,C		  */
-OP(cb,e2) { _D = SET(4,_D); 										} /* SET  4,D		  */
-OP(cb,e3) { _E = SET(4,_E); 										} /* SET  4,E		  */
-OP(cb,e4) { _H = SET(4,_H); 										} /* SET  4,H		  */
-OP(cb,e5) { _L = SET(4,_L); 										} /* SET  4,L		  */
-OP(cb,e6) { WM( _HL, SET(4,RM(_HL)) );								} /* SET  4,(HL)	  */
-OP(cb,e7) { _A = SET(4,_A); 										} /* SET  4,A		  */
-
-OP(cb,e8) { _B = SET(5,_B); 										} /* SET  5,B		  */
-OP(cb,e9) { _C = SET(5,_C); 										} /* SET  5,C		  */
-OP(cb,ea) { _D = SET(5,_D); 										} /* SET  5,D		  */
-OP(cb,eb) { _E = SET(5,_E); 										} /* SET  5,E		  */
-OP(cb,ec) { _H = SET(5,_H); 										} /* SET  5,H		  */
-OP(cb,ed) { _L = SET(5,_L); 										} /* SET  5,L		  */
-OP(cb,ee) { WM( _HL, SET(5,RM(_HL)) );								} /* SET  5,(HL)	  */
-OP(cb,ef) { _A = SET(5,_A); 										} /* SET  5,A		  */
-
-OP(cb,f0) { _B = SET(6,_B); 										} /* SET  6,B		  */
-OP(cb,f1) { _C = SET(6,_C); 										} /* SET  6,C		  */
-OP(cb,f2) { _D = SET(6,_D); 										} /* SET  6,D		  */
-OP(cb,f3) { _E = SET(6,_E); 										} /* SET  6,E		  */
-OP(cb,f4) { _H = SET(6,_H); 										} /* SET  6,H		  */
-OP(cb,f5) { _L = SET(6,_L); 										} /* SET  6,L		  */
-OP(cb,f6) { WM( _HL, SET(6,RM(_HL)) );								} /* SET  6,(HL)	  */
-OP(cb,f7) { _A = SET(6,_A); 										} /* SET  6,A		  */
-
-OP(cb,f8) { _B = SET(7,_B); 										} /* SET  7,B		  */
-OP(cb,f9) { _C = SET(7,_C); 										} /* SET  7,C		  */
-OP(cb,fa) { _D = SET(7,_D); 										} /* SET  7,D		  */
-OP(cb,fb) { _E = SET(7,_E); 										} /* SET  7,E		  */
-OP(cb,fc) { _H = SET(7,_H); 										} /* SET  7,H		  */
-OP(cb,fd) { _L = SET(7,_L); 										} /* SET  7,L		  */
-OP(cb,fe) { WM( _HL, SET(7,RM(_HL)) );								} /* SET  7,(HL)	  */
-OP(cb,ff) { _A = SET(7,_A); 										} /* SET  7,A		  */
-
-
-/**********************************************************
-* opcodes with DD/FD CB prefix
-* rotate, shift and bit operations with (IX+o)
-**********************************************************/
-OP(xxcb,00) { _B = RLC( RM(EA) ); WM( EA,_B );						} /* RLC  B=(XY+o)	  */
-OP(xxcb,01) { _C = RLC( RM(EA) ); WM( EA,_C );						} /* RLC  C=(XY+o)	  */
-OP(xxcb,02) { _D = RLC( RM(EA) ); WM( EA,_D );						} /* RLC  D=(XY+o)	  */
-OP(xxcb,03) { _E = RLC( RM(EA) ); WM( EA,_E );						} /* RLC  E=(XY+o)	  */
-OP(xxcb,04) { _H = RLC( RM(EA) ); WM( EA,_H );						} /* RLC  H=(XY+o)	  */
-OP(xxcb,05) { _L = RLC( RM(EA) ); WM( EA,_L );						} /* RLC  L=(XY+o)	  */
-OP(xxcb,06) { WM( EA, RLC( RM(EA) ) );								} /* RLC  (XY+o)	  */
-OP(xxcb,07) { _A = RLC( RM(EA) ); WM( EA,_A );						} /* RLC  A=(XY+o)	  */
-
-OP(xxcb,08) { _B = RRC( RM(EA) ); WM( EA,_B );						} /* RRC  B=(XY+o)	  */
-OP(xxcb,09) { _C = RRC( RM(EA) ); WM( EA,_C );						} /* RRC  C=(XY+o)	  */
-OP(xxcb,0a) { _D = RRC( RM(EA) ); WM( EA,_D );						} /* RRC  D=(XY+o)	  */
-OP(xxcb,0b) { _E = RRC( RM(EA) ); WM( EA,_E );						} /* RRC  E=(XY+o)	  */
-OP(xxcb,0c) { _H = RRC( RM(EA) ); WM( EA,_H );						} /* RRC  H=(XY+o)	  */
-OP(xxcb,0d) { _L = RRC( RM(EA) ); WM( EA,_L );						} /* RRC  L=(XY+o)	  */
-OP(xxcb,0e) { WM( EA,RRC( RM(EA) ) );								} /* RRC  (XY+o)	  */
-OP(xxcb,0f) { _A = RRC( RM(EA) ); WM( EA,_A );						} /* RRC  A=(XY+o)	  */
-
-OP(xxcb,10) { _B = RL( RM(EA) ); WM( EA,_B );						} /* RL   B=(XY+o)	  */
-OP(xxcb,11) { _C = RL( RM(EA) ); WM( EA,_C );						} /* RL   C=(XY+o)	  */
-OP(xxcb,12) { _D = RL( RM(EA) ); WM( EA,_D );						} /* RL   D=(XY+o)	  */
-OP(xxcb,13) { _E = RL( RM(EA) ); WM( EA,_E );						} /* RL   E=(XY+o)	  */
-OP(xxcb,14) { _H = RL( RM(EA) ); WM( EA,_H );						} /* RL   H=(XY+o)	  */
-OP(xxcb,15) { _L = RL( RM(EA) ); WM( EA,_L );						} /* RL   L=(XY+o)	  */
-OP(xxcb,16) { WM( EA,RL( RM(EA) ) );								} /* RL   (XY+o)	  */
-OP(xxcb,17) { _A = RL( RM(EA) ); WM( EA,_A );						} /* RL   A=(XY+o)	  */
-
-OP(xxcb,18) { _B = RR( RM(EA) ); WM( EA,_B );						} /* RR   B=(XY+o)	  */
-OP(xxcb,19) { _C = RR( RM(EA) ); WM( EA,_C );						} /* RR   C=(XY+o)	  */
-OP(xxcb,1a) { _D = RR( RM(EA) ); WM( EA,_D );						} /* RR   D=(XY+o)	  */
-OP(xxcb,1b) { _E = RR( RM(EA) ); WM( EA,_E );						} /* RR   E=(XY+o)	  */
-OP(xxcb,1c) { _H = RR( RM(EA) ); WM( EA,_H );						} /* RR   H=(XY+o)	  */
-OP(xxcb,1d) { _L = RR( RM(EA) ); WM( EA,_L );						} /* RR   L=(XY+o)	  */
-OP(xxcb,1e) { WM( EA,RR( RM(EA) ) );								} /* RR   (XY+o)	  */
-OP(xxcb,1f) { _A = RR( RM(EA) ); WM( EA,_A );						} /* RR   A=(XY+o)	  */
-
-OP(xxcb,20) { _B = SLA( RM(EA) ); WM( EA,_B );						} /* SLA  B=(XY+o)	  */
-OP(xxcb,21) { _C = SLA( RM(EA) ); WM( EA,_C );						} /* SLA  C=(XY+o)	  */
-OP(xxcb,22) { _D = SLA( RM(EA) ); WM( EA,_D );						} /* SLA  D=(XY+o)	  */
-OP(xxcb,23) { _E = SLA( RM(EA) ); WM( EA,_E );						} /* SLA  E=(XY+o)	  */
-OP(xxcb,24) { _H = SLA( RM(EA) ); WM( EA,_H );						} /* SLA  H=(XY+o)	  */
-OP(xxcb,25) { _L = SLA( RM(EA) ); WM( EA,_L );						} /* SLA  L=(XY+o)	  */
-OP(xxcb,26) { WM( EA,SLA( RM(EA) ) );								} /* SLA  (XY+o)	  */
-OP(xxcb,27) { _A = SLA( RM(EA) ); WM( EA,_A );						} /* SLA  A=(XY+o)	  */
-
-OP(xxcb,28) { _B = SRA( RM(EA) ); WM( EA,_B );						} /* SRA  B=(XY+o)	  */
-OP(xxcb,29) { _C = SRA( RM(EA) ); WM( EA,_C );						} /* SRA  C=(XY+o)	  */
-OP(xxcb,2a) { _D = SRA( RM(EA) ); WM( EA,_D );						} /* SRA  D=(XY+o)	  */
-OP(xxcb,2b) { _E = SRA( RM(EA) ); WM( EA,_E );						} /* SRA  E=(XY+o)	  */
-OP(xxcb,2c) { _H = SRA( RM(EA) ); WM( EA,_H );						} /* SRA  H=(XY+o)	  */
-OP(xxcb,2d) { _L = SRA( RM(EA) ); WM( EA,_L );						} /* SRA  L=(XY+o)	  */
-OP(xxcb,2e) { WM( EA,SRA( RM(EA) ) );								} /* SRA  (XY+o)	  */
-OP(xxcb,2f) { _A = SRA( RM(EA) ); WM( EA,_A );						} /* SRA  A=(XY+o)	  */
-
-OP(xxcb,30) { _B = SLL( RM(EA) ); WM( EA,_B );						} /* SLL  B=(XY+o)	  */
-OP(xxcb,31) { _C = SLL( RM(EA) ); WM( EA,_C );						} /* SLL  C=(XY+o)	  */
-OP(xxcb,32) { _D = SLL( RM(EA) ); WM( EA,_D );						} /* SLL  D=(XY+o)	  */
-OP(xxcb,33) { _E = SLL( RM(EA) ); WM( EA,_E );						} /* SLL  E=(XY+o)	  */
-OP(xxcb,34) { _H = SLL( RM(EA) ); WM( EA,_H );						} /* SLL  H=(XY+o)	  */
-OP(xxcb,35) { _L = SLL( RM(EA) ); WM( EA,_L );						} /* SLL  L=(XY+o)	  */
-OP(xxcb,36) { WM( EA,SLL( RM(EA) ) );								} /* SLL  (XY+o)	  */
-OP(xxcb,37) { _A = SLL( RM(EA) ); WM( EA,_A );						} /* SLL  A=(XY+o)	  */
-
-OP(xxcb,38) { _B = SRL( RM(EA) ); WM( EA,_B );						} /* SRL  B=(XY+o)	  */
-OP(xxcb,39) { _C = SRL( RM(EA) ); WM( EA,_C );						} /* SRL  C=(XY+o)	  */
-OP(xxcb,3a) { _D = SRL( RM(EA) ); WM( EA,_D );						} /* SRL  D=(XY+o)	  */
-OP(xxcb,3b) { _E = SRL( RM(EA) ); WM( EA,_E );						} /* SRL  E=(XY+o)	  */
-OP(xxcb,3c) { _H = SRL( RM(EA) ); WM( EA,_H );						} /* SRL  H=(XY+o)	  */
-OP(xxcb,3d) { _L = SRL( RM(EA) ); WM( EA,_L );						} /* SRL  L=(XY+o)	  */
-OP(xxcb,3e) { WM( EA,SRL( RM(EA) ) );								} /* SRL  (XY+o)	  */
-OP(xxcb,3f) { _A = SRL( RM(EA) ); WM( EA,_A );						} /* SRL  A=(XY+o)	  */
-
-OP(xxcb,40) { xxcb_46();											} /* BIT  0,B=(XY+o)  */
-OP(xxcb,41) { xxcb_46();													  } /* BIT	0,C=(XY+o)	*/
-OP(xxcb,42) { xxcb_46();											} /* BIT  0,D=(XY+o)  */
-OP(xxcb,43) { xxcb_46();											} /* BIT  0,E=(XY+o)  */
-OP(xxcb,44) { xxcb_46();											} /* BIT  0,H=(XY+o)  */
-OP(xxcb,45) { xxcb_46();											} /* BIT  0,L=(XY+o)  */
-OP(xxcb,46) { BIT_XY(0,RM(EA)); 									} /* BIT  0,(XY+o)	  */
-OP(xxcb,47) { xxcb_46();											} /* BIT  0,A=(XY+o)  */
-
-OP(xxcb,48) { xxcb_4e();											} /* BIT  1,B=(XY+o)  */
-OP(xxcb,49) { xxcb_4e();													  } /* BIT	1,C=(XY+o)	*/
-OP(xxcb,4a) { xxcb_4e();											} /* BIT  1,D=(XY+o)  */
-OP(xxcb,4b) { xxcb_4e();											} /* BIT  1,E=(XY+o)  */
-OP(xxcb,4c) { xxcb_4e();											} /* BIT  1,H=(XY+o)  */
-OP(xxcb,4d) { xxcb_4e();											} /* BIT  1,L=(XY+o)  */
-OP(xxcb,4e) { BIT_XY(1,RM(EA)); 									} /* BIT  1,(XY+o)	  */
-OP(xxcb,4f) { xxcb_4e();											} /* BIT  1,A=(XY+o)  */
-
-OP(xxcb,50) { xxcb_56();											} /* BIT  2,B=(XY+o)  */
-OP(xxcb,51) { xxcb_56();													  } /* BIT	2,C=(XY+o)	*/
-OP(xxcb,52) { xxcb_56();											} /* BIT  2,D=(XY+o)  */
-OP(xxcb,53) { xxcb_56();											} /* BIT  2,E=(XY+o)  */
-OP(xxcb,54) { xxcb_56();											} /* BIT  2,H=(XY+o)  */
-OP(xxcb,55) { xxcb_56();											} /* BIT  2,L=(XY+o)  */
-OP(xxcb,56) { BIT_XY(2,RM(EA)); 									} /* BIT  2,(XY+o)	  */
-OP(xxcb,57) { xxcb_56();											} /* BIT  2,A=(XY+o)  */
-
-OP(xxcb,58) { xxcb_5e();											} /* BIT  3,B=(XY+o)  */
-OP(xxcb,59) { xxcb_5e();													  } /* BIT	3,C=(XY+o)	*/
-OP(xxcb,5a) { xxcb_5e();											} /* BIT  3,D=(XY+o)  */
-OP(xxcb,5b) { xxcb_5e();											} /* BIT  3,E=(XY+o)  */
-OP(xxcb,5c) { xxcb_5e();											} /* BIT  3,H=(XY+o)  */
-OP(xxcb,5d) { xxcb_5e();											} /* BIT  3,L=(XY+o)  */
-OP(xxcb,5e) { BIT_XY(3,RM(EA)); 									} /* BIT  3,(XY+o)	  */
-OP(xxcb,5f) { xxcb_5e();											} /* BIT  3,A=(XY+o)  */
-
-OP(xxcb,60) { xxcb_66();											} /* BIT  4,B=(XY+o)  */
-OP(xxcb,61) { xxcb_66();													  } /* BIT	4,C=(XY+o)	*/
-OP(xxcb,62) { xxcb_66();											} /* BIT  4,D=(XY+o)  */
-OP(xxcb,63) { xxcb_66();											} /* BIT  4,E=(XY+o)  */
-OP(xxcb,64) { xxcb_66();											} /* BIT  4,H=(XY+o)  */
-OP(xxcb,65) { xxcb_66();											} /* BIT  4,L=(XY+o)  */
-OP(xxcb,66) { BIT_XY(4,RM(EA)); 									} /* BIT  4,(XY+o)	  */
-OP(xxcb,67) { xxcb_66();											} /* BIT  4,A=(XY+o)  */
-
-OP(xxcb,68) { xxcb_6e();											} /* BIT  5,B=(XY+o)  */
-OP(xxcb,69) { xxcb_6e();													  } /* BIT	5,C=(XY+o)	*/
-OP(xxcb,6a) { xxcb_6e();											} /* BIT  5,D=(XY+o)  */
-OP(xxcb,6b) { xxcb_6e();											} /* BIT  5,E=(XY+o)  */
-OP(xxcb,6c) { xxcb_6e();											} /* BIT  5,H=(XY+o)  */
-OP(xxcb,6d) { xxcb_6e();											} /* BIT  5,L=(XY+o)  */
-OP(xxcb,6e) { BIT_XY(5,RM(EA)); 									} /* BIT  5,(XY+o)	  */
-OP(xxcb,6f) { xxcb_6e();											} /* BIT  5,A=(XY+o)  */
-
-OP(xxcb,70) { xxcb_76();											} /* BIT  6,B=(XY+o)  */
-OP(xxcb,71) { xxcb_76();													  } /* BIT	6,C=(XY+o)	*/
-OP(xxcb,72) { xxcb_76();											} /* BIT  6,D=(XY+o)  */
-OP(xxcb,73) { xxcb_76();											} /* BIT  6,E=(XY+o)  */
-OP(xxcb,74) { xxcb_76();											} /* BIT  6,H=(XY+o)  */
-OP(xxcb,75) { xxcb_76();											} /* BIT  6,L=(XY+o)  */
-OP(xxcb,76) { BIT_XY(6,RM(EA)); 									} /* BIT  6,(XY+o)	  */
-OP(xxcb,77) { xxcb_76();											} /* BIT  6,A=(XY+o)  */
-
-OP(xxcb,78) { xxcb_7e();											} /* BIT  7,B=(XY+o)  */
-OP(xxcb,79) { xxcb_7e();													  } /* BIT	7,C=(XY+o)	*/
-OP(xxcb,7a) { xxcb_7e();											} /* BIT  7,D=(XY+o)  */
-OP(xxcb,7b) { xxcb_7e();											} /* BIT  7,E=(XY+o)  */
-OP(xxcb,7c) { xxcb_7e();											} /* BIT  7,H=(XY+o)  */
-OP(xxcb,7d) { xxcb_7e();											} /* BIT  7,L=(XY+o)  */
-OP(xxcb,7e) { BIT_XY(7,RM(EA)); 									} /* BIT  7,(XY+o)	  */
-OP(xxcb,7f) { xxcb_7e();											} /* BIT  7,A=(XY+o)  */
-
-OP(xxcb,80) { _B = RES(0, RM(EA) ); WM( EA,_B );					} /* RES  0,B=(XY+o)  */
-OP(xxcb,81) { _C = RES(0, RM(EA) ); WM( EA,_C );					} /* RES  0,C=(XY+o)  */
-OP(xxcb,82) { _D = RES(0, RM(EA) ); WM( EA,_D );					} /* RES  0,D=(XY+o)  */
-OP(xxcb,83) { _E = RES(0, RM(EA) ); WM( EA,_E );					} /* RES  0,E=(XY+o)  */
-OP(xxcb,84) { _H = RES(0, RM(EA) ); WM( EA,_H );					} /* RES  0,H=(XY+o)  */
-OP(xxcb,85) { _L = RES(0, RM(EA) ); WM( EA,_L );					} /* RES  0,L=(XY+o)  */
-OP(xxcb,86) { WM( EA, RES(0,RM(EA)) );								} /* RES  0,(XY+o)	  */
-OP(xxcb,87) { _A = RES(0, RM(EA) ); WM( EA,_A );					} /* RES  0,A=(XY+o)  */
-
-OP(xxcb,88) { _B = RES(1, RM(EA) ); WM( EA,_B );					} /* RES  1,B=(XY+o)  */
-OP(xxcb,89) { _C = RES(1, RM(EA) ); WM( EA,_C );					} /* RES  1,C=(XY+o)  */
-OP(xxcb,8a) { _D = RES(1, RM(EA) ); WM( EA,_D );					} /* RES  1,D=(XY+o)  */
-OP(xxcb,8b) { _E = RES(1, RM(EA) ); WM( EA,_E );					} /* RES  1,E=(XY+o)  */
-OP(xxcb,8c) { _H = RES(1, RM(EA) ); WM( EA,_H );					} /* RES  1,H=(XY+o)  */
-OP(xxcb,8d) { _L = RES(1, RM(EA) ); WM( EA,_L );					} /* RES  1,L=(XY+o)  */
-OP(xxcb,8e) { WM( EA, RES(1,RM(EA)) );								} /* RES  1,(XY+o)	  */
-OP(xxcb,8f) { _A = RES(1, RM(EA) ); WM( EA,_A );					} /* RES  1,A=(XY+o)  */
-
-OP(xxcb,90) { _B = RES(2, RM(EA) ); WM( EA,_B );					} /* RES  2,B=(XY+o)  */
-OP(xxcb,91) { _C = RES(2, RM(EA) ); WM( EA,_C );					} /* RES  2,C=(XY+o)  */
-OP(xxcb,92) { _D = RES(2, RM(EA) ); WM( EA,_D );					} /* RES  2,D=(XY+o)  */
-OP(xxcb,93) { _E = RES(2, RM(EA) ); WM( EA,_E );					} /* RES  2,E=(XY+o)  */
-OP(xxcb,94) { _H = RES(2, RM(EA) ); WM( EA,_H );					} /* RES  2,H=(XY+o)  */
-OP(xxcb,95) { _L = RES(2, RM(EA) ); WM( EA,_L );					} /* RES  2,L=(XY+o)  */
-OP(xxcb,96) { WM( EA, RES(2,RM(EA)) );								} /* RES  2,(XY+o)	  */
-OP(xxcb,97) { _A = RES(2, RM(EA) ); WM( EA,_A );					} /* RES  2,A=(XY+o)  */
-
-OP(xxcb,98) { _B = RES(3, RM(EA) ); WM( EA,_B );					} /* RES  3,B=(XY+o)  */
-OP(xxcb,99) { _C = RES(3, RM(EA) ); WM( EA,_C );					} /* RES  3,C=(XY+o)  */
-OP(xxcb,9a) { _D = RES(3, RM(EA) ); WM( EA,_D );					} /* RES  3,D=(XY+o)  */
-OP(xxcb,9b) { _E = RES(3, RM(EA) ); WM( EA,_E );					} /* RES  3,E=(XY+o)  */
-OP(xxcb,9c) { _H = RES(3, RM(EA) ); WM( EA,_H );					} /* RES  3,H=(XY+o)  */
-OP(xxcb,9d) { _L = RES(3, RM(EA) ); WM( EA,_L );					} /* RES  3,L=(XY+o)  */
-OP(xxcb,9e) { WM( EA, RES(3,RM(EA)) );								} /* RES  3,(XY+o)	  */
-OP(xxcb,9f) { _A = RES(3, RM(EA) ); WM( EA,_A );					} /* RES  3,A=(XY+o)  */
-
-OP(xxcb,a0) { _B = RES(4, RM(EA) ); WM( EA,_B );					} /* RES  4,B=(XY+o)  */
-OP(xxcb,a1) { _C = RES(4, RM(EA) ); WM( EA,_C );					} /* RES  4,C=(XY+o)  */
-OP(xxcb,a2) { _D = RES(4, RM(EA) ); WM( EA,_D );					} /* RES  4,D=(XY+o)  */
-OP(xxcb,a3) { _E = RES(4, RM(EA) ); WM( EA,_E );					} /* RES  4,E=(XY+o)  */
-OP(xxcb,a4) { _H = RES(4, RM(EA) ); WM( EA,_H );					} /* RES  4,H=(XY+o)  */
-OP(xxcb,a5) { _L = RES(4, RM(EA) ); WM( EA,_L );					} /* RES  4,L=(XY+o)  */
-OP(xxcb,a6) { WM( EA, RES(4,RM(EA)) );								} /* RES  4,(XY+o)	  */
-OP(xxcb,a7) { _A = RES(4, RM(EA) ); WM( EA,_A );					} /* RES  4,A=(XY+o)  */
-
-OP(xxcb,a8) { _B = RES(5, RM(EA) ); WM( EA,_B );					} /* RES  5,B=(XY+o)  */
-OP(xxcb,a9) { _C = RES(5, RM(EA) ); WM( EA,_C );					} /* RES  5,C=(XY+o)  */
-OP(xxcb,aa) { _D = RES(5, RM(EA) ); WM( EA,_D );					} /* RES  5,D=(XY+o)  */
-OP(xxcb,ab) { _E = RES(5, RM(EA) ); WM( EA,_E );					} /* RES  5,E=(XY+o)  */
-OP(xxcb,ac) { _H = RES(5, RM(EA) ); WM( EA,_H );					} /* RES  5,H=(XY+o)  */
-OP(xxcb,ad) { _L = RES(5, RM(EA) ); WM( EA,_L );					} /* RES  5,L=(XY+o)  */
-OP(xxcb,ae) { WM( EA, RES(5,RM(EA)) );								} /* RES  5,(XY+o)	  */
-OP(xxcb,af) { _A = RES(5, RM(EA) ); WM( EA,_A );					} /* RES  5,A=(XY+o)  */
-
-OP(xxcb,b0) { _B = RES(6, RM(EA) ); WM( EA,_B );					} /* RES  6,B=(XY+o)  */
-OP(xxcb,b1) { _C = RES(6, RM(EA) ); WM( EA,_C );					} /* RES  6,C=(XY+o)  */
-OP(xxcb,b2) { _D = RES(6, RM(EA) ); WM( EA,_D );					} /* RES  6,D=(XY+o)  */
-OP(xxcb,b3) { _E = RES(6, RM(EA) ); WM( EA,_E );					} /* RES  6,E=(XY+o)  */
-OP(xxcb,b4) { _H = RES(6, RM(EA) ); WM( EA,_H );					} /* RES  6,H=(XY+o)  */
-OP(xxcb,b5) { _L = RES(6, RM(EA) ); WM( EA,_L );					} /* RES  6,L=(XY+o)  */
-OP(xxcb,b6) { WM( EA, RES(6,RM(EA)) );								} /* RES  6,(XY+o)	  */
-OP(xxcb,b7) { _A = RES(6, RM(EA) ); WM( EA,_A );					} /* RES  6,A=(XY+o)  */
-
-OP(xxcb,b8) { _B = RES(7, RM(EA) ); WM( EA,_B );					} /* RES  7,B=(XY+o)  */
-OP(xxcb,b9) { _C = RES(7, RM(EA) ); WM( EA,_C );					} /* RES  7,C=(XY+o)  */
-OP(xxcb,ba) { _D = RES(7, RM(EA) ); WM( EA,_D );					} /* RES  7,D=(XY+o)  */
-OP(xxcb,bb) { _E = RES(7, RM(EA) ); WM( EA,_E );					} /* RES  7,E=(XY+o)  */
-OP(xxcb,bc) { _H = RES(7, RM(EA) ); WM( EA,_H );					} /* RES  7,H=(XY+o)  */
-OP(xxcb,bd) { _L = RES(7, RM(EA) ); WM( EA,_L );					} /* RES  7,L=(XY+o)  */
-OP(xxcb,be) { WM( EA, RES(7,RM(EA)) );								} /* RES  7,(XY+o)	  */
-OP(xxcb,bf) { _A = RES(7, RM(EA) ); WM( EA,_A );					} /* RES  7,A=(XY+o)  */
-
-OP(xxcb,c0) { _B = SET(0, RM(EA) ); WM( EA,_B );					} /* SET  0,B=(XY+o)  */
-OP(xxcb,c1) { _C = SET(0, RM(EA) ); WM( EA,_C );					} /* SET  0,C=(XY+o)  */
-OP(xxcb,c2) { _D = SET(0, RM(EA) ); WM( EA,_D );					} /* SET  0,D=(XY+o)  */
-OP(xxcb,c3) { _E = SET(0, RM(EA) ); WM( EA,_E );					} /* SET  0,E=(XY+o)  */
-OP(xxcb,c4) { _H = SET(0, RM(EA) ); WM( EA,_H );					} /* SET  0,H=(XY+o)  */
-OP(xxcb,c5) { _L = SET(0, RM(EA) ); WM( EA,_L );					} /* SET  0,L=(XY+o)  */
-OP(xxcb,c6) { WM( EA, SET(0,RM(EA)) );								} /* SET  0,(XY+o)	  */
-OP(xxcb,c7) { _A = SET(0, RM(EA) ); WM( EA,_A );					} /* SET  0,A=(XY+o)  */
-
-OP(xxcb,c8) { _B = SET(1, RM(EA) ); WM( EA,_B );					} /* SET  1,B=(XY+o)  */
-OP(xxcb,c9) { _C = SET(1, RM(EA) ); WM( EA,_C );					} /* SET  1,C=(XY+o)  */
-OP(xxcb,ca) { _D = SET(1, RM(EA) ); WM( EA,_D );					} /* SET  1,D=(XY+o)  */
-OP(xxcb,cb) { _E = SET(1, RM(EA) ); WM( EA,_E );					} /* SET  1,E=(XY+o)  */
-OP(xxcb,cc) { _H = SET(1, RM(EA) ); WM( EA,_H );					} /* SET  1,H=(XY+o)  */
-OP(xxcb,cd) { _L = SET(1, RM(EA) ); WM( EA,_L );					} /* SET  1,L=(XY+o)  */
-OP(xxcb,ce) { WM( EA, SET(1,RM(EA)) );								} /* SET  1,(XY+o)	  */
-OP(xxcb,cf) { _A = SET(1, RM(EA) ); WM( EA,_A );					} /* SET  1,A=(XY+o)  */
-
-OP(xxcb,d0) { _B = SET(2, RM(EA) ); WM( EA,_B );					} /* SET  2,B=(XY+o)  */
-OP(xxcb,d1) { _C = SET(2, RM(EA) ); WM( EA,_C );					} /* SET  2,C=(XY+o)  */
-OP(xxcb,d2) { _D = SET(2, RM(EA) ); WM( EA,_D );					} /* SET  2,D=(XY+o)  */
-OP(xxcb,d3) { _E = SET(2, RM(EA) ); WM( EA,_E );					} /* SET  2,E=(XY+o)  */
-OP(xxcb,d4) { _H = SET(2, RM(EA) ); WM( EA,_H );					} /* SET  2,H=(XY+o)  */
-OP(xxcb,d5) { _L = SET(2, RM(EA) ); WM( EA,_L );					} /* SET  2,L=(XY+o)  */
-OP(xxcb,d6) { WM( EA, SET(2,RM(EA)) );								} /* SET  2,(XY+o)	  */
-OP(xxcb,d7) { _A = SET(2, RM(EA) ); WM( EA,_A );					} /* SET  2,A=(XY+o)  */
-
-OP(xxcb,d8) { _B = SET(3, RM(EA) ); WM( EA,_B );					} /* SET  3,B=(XY+o)  */
-OP(xxcb,d9) { _C = SET(3, RM(EA) ); WM( EA,_C );					} /* SET  3,C=(XY+o)  */
-OP(xxcb,da) { _D = SET(3, RM(EA) ); WM( EA,_D );					} /* SET  3,D=(XY+o)  */
-OP(xxcb,db) { _E = SET(3, RM(EA) ); WM( EA,_E );					} /* SET  3,E=(XY+o)  */
-OP(xxcb,dc) { _H = SET(3, RM(EA) ); WM( EA,_H );					} /* SET  3,H=(XY+o)  */
-OP(xxcb,dd) { _L = SET(3, RM(EA) ); WM( EA,_L );					} /* SET  3,L=(XY+o)  */
-OP(xxcb,de) { WM( EA, SET(3,RM(EA)) );								} /* SET  3,(XY+o)	  */
-OP(xxcb,df) { _A = SET(3, RM(EA) ); WM( EA,_A );					} /* SET  3,A=(XY+o)  */
-
-OP(xxcb,e0) { _B = SET(4, RM(EA) ); WM( EA,_B );					} /* SET  4,B=(XY+o)  */
-OP(xxcb,e1) { _C = SET(4, RM(EA) ); WM( EA,_C );					} /* SET  4,C=(XY+o)  */
-OP(xxcb,e2) { _D = SET(4, RM(EA) ); WM( EA,_D );					} /* SET  4,D=(XY+o)  */
-OP(xxcb,e3) { _E = SET(4, RM(EA) ); WM( EA,_E );					} /* SET  4,E=(XY+o)  */
-OP(xxcb,e4) { _H = SET(4, RM(EA) ); WM( EA,_H );					} /* SET  4,H=(XY+o)  */
-OP(xxcb,e5) { _L = SET(4, RM(EA) ); WM( EA,_L );					} /* SET  4,L=(XY+o)  */
-OP(xxcb,e6) { WM( EA, SET(4,RM(EA)) );								} /* SET  4,(XY+o)	  */
-OP(xxcb,e7) { _A = SET(4, RM(EA) ); WM( EA,_A );					} /* SET  4,A=(XY+o)  */
-
-OP(xxcb,e8) { _B = SET(5, RM(EA) ); WM( EA,_B );					} /* SET  5,B=(XY+o)  */
-OP(xxcb,e9) { _C = SET(5, RM(EA) ); WM( EA,_C );					} /* SET  5,C=(XY+o)  */
-OP(xxcb,ea) { _D = SET(5, RM(EA) ); WM( EA,_D );					} /* SET  5,D=(XY+o)  */
-OP(xxcb,eb) { _E = SET(5, RM(EA) ); WM( EA,_E );					} /* SET  5,E=(XY+o)  */
-OP(xxcb,ec) { _H = SET(5, RM(EA) ); WM( EA,_H );					} /* SET  5,H=(XY+o)  */
-OP(xxcb,ed) { _L = SET(5, RM(EA) ); WM( EA,_L );					} /* SET  5,L=(XY+o)  */
-OP(xxcb,ee) { WM( EA, SET(5,RM(EA)) );								} /* SET  5,(XY+o)	  */
-OP(xxcb,ef) { _A = SET(5, RM(EA) ); WM( EA,_A );					} /* SET  5,A=(XY+o)  */
-
-OP(xxcb,f0) { _B = SET(6, RM(EA) ); WM( EA,_B );					} /* SET  6,B=(XY+o)  */
-OP(xxcb,f1) { _C = SET(6, RM(EA) ); WM( EA,_C );					} /* SET  6,C=(XY+o)  */
-OP(xxcb,f2) { _D = SET(6, RM(EA) ); WM( EA,_D );					} /* SET  6,D=(XY+o)  */
-OP(xxcb,f3) { _E = SET(6, RM(EA) ); WM( EA,_E );					} /* SET  6,E=(XY+o)  */
-OP(xxcb,f4) { _H = SET(6, RM(EA) ); WM( EA,_H );					} /* SET  6,H=(XY+o)  */
-OP(xxcb,f5) { _L = SET(6, RM(EA) ); WM( EA,_L );					} /* SET  6,L=(XY+o)  */
-OP(xxcb,f6) { WM( EA, SET(6,RM(EA)) );								} /* SET  6,(XY+o)	  */
-OP(xxcb,f7) { _A = SET(6, RM(EA) ); WM( EA,_A );					} /* SET  6,A=(XY+o)  */
-
-OP(xxcb,f8) { _B = SET(7, RM(EA) ); WM( EA,_B );					} /* SET  7,B=(XY+o)  */
-OP(xxcb,f9) { _C = SET(7, RM(EA) ); WM( EA,_C );					} /* SET  7,C=(XY+o)  */
-OP(xxcb,fa) { _D = SET(7, RM(EA) ); WM( EA,_D );					} /* SET  7,D=(XY+o)  */
-OP(xxcb,fb) { _E = SET(7, RM(EA) ); WM( EA,_E );					} /* SET  7,E=(XY+o)  */
-OP(xxcb,fc) { _H = SET(7, RM(EA) ); WM( EA,_H );					} /* SET  7,H=(XY+o)  */
-OP(xxcb,fd) { _L = SET(7, RM(EA) ); WM( EA,_L );					} /* SET  7,L=(XY+o)  */
-OP(xxcb,fe) { WM( EA, SET(7,RM(EA)) );								} /* SET  7,(XY+o)	  */
-OP(xxcb,ff) { _A = SET(7, RM(EA) ); WM( EA,_A );					} /* SET  7,A=(XY+o)  */
-
-OP(illegal,1) {
-	_PC--;
-}
-
-/**********************************************************
- * IX register related opcodes (DD prefix)
- **********************************************************/
-OP(dd,00) { illegal_1();											} /* DB   DD		  */
-OP(dd,01) { illegal_1();											} /* DB   DD		  */
-OP(dd,02) { illegal_1();											} /* DB   DD		  */
-OP(dd,03) { illegal_1();											} /* DB   DD		  */
-OP(dd,04) { illegal_1();											} /* DB   DD		  */
-OP(dd,05) { illegal_1();											} /* DB   DD		  */
-OP(dd,06) { illegal_1();											} /* DB   DD		  */
-OP(dd,07) { illegal_1();											} /* DB   DD		  */
-
-OP(dd,08) { illegal_1();											} /* DB   DD		  */
-OP(dd,09) { ADD16(IX,BC);											} /* ADD  IX,BC 	  */
-OP(dd,0a) { illegal_1();											} /* DB   DD		  */
-OP(dd,0b) { illegal_1();											} /* DB   DD		  */
-OP(dd,0c) { illegal_1();											} /* DB   DD		  */
-OP(dd,0d) { illegal_1();											} /* DB   DD		  */
-OP(dd,0e) { illegal_1();											} /* DB   DD		  */
-OP(dd,0f) { illegal_1();											} /* DB   DD		  */
-
-OP(dd,10) { illegal_1();											} /* DB   DD		  */
-OP(dd,11) { illegal_1();											} /* DB   DD		  */
-OP(dd,12) { illegal_1();											} /* DB   DD		  */
-OP(dd,13) { illegal_1();											} /* DB   DD		  */
-OP(dd,14) { illegal_1();											} /* DB   DD		  */
-OP(dd,15) { illegal_1();											} /* DB   DD		  */
-OP(dd,16) { illegal_1();											} /* DB   DD		  */
-OP(dd,17) { illegal_1();											} /* DB   DD		  */
-
-OP(dd,18) { illegal_1();											} /* DB   DD		  */
-OP(dd,19) { ADD16(IX,DE);											} /* ADD  IX,DE 	  */
-OP(dd,1a) { illegal_1();											} /* DB   DD		  */
-OP(dd,1b) { illegal_1();											} /* DB   DD		  */
-OP(dd,1c) { illegal_1();											} /* DB   DD		  */
-OP(dd,1d) { illegal_1();											} /* DB   DD		  */
-OP(dd,1e) { illegal_1();											} /* DB   DD		  */
-OP(dd,1f) { illegal_1();											} /* DB   DD		  */
-
-OP(dd,20) { illegal_1();											} /* DB   DD		  */
-OP(dd,21) { _IX = ARG16();											} /* LD   IX,w		  */
-OP(dd,22) { EA = ARG16(); WM16( EA, &Z80.IX );						} /* LD   (w),IX	  */
-OP(dd,23) { _IX++;													} /* INC  IX		  */
-OP(dd,24) { _HX = INC(_HX); 										} /* INC  HX		  */
-OP(dd,25) { _HX = DEC(_HX); 										} /* DEC  HX		  */
-OP(dd,26) { _HX = ARG();											} /* LD   HX,n		  */
-OP(dd,27) { illegal_1();											} /* DB   DD		  */
-
-OP(dd,28) { illegal_1();											} /* DB   DD		  */
-OP(dd,29) { ADD16(IX,IX);											} /* ADD  IX,IX 	  */
-OP(dd,2a) { EA = ARG16(); RM16( EA, &Z80.IX );						} /* LD   IX,(w)	  */
-OP(dd,2b) { _IX--;													} /* DEC  IX		  */
-OP(dd,2c) { _LX = INC(_LX); 										} /* INC  LX		  */
-OP(dd,2d) { _LX = DEC(_LX); 										} /* DEC  LX		  */
-OP(dd,2e) { _LX = ARG();											} /* LD   LX,n		  */
-OP(dd,2f) { illegal_1();											} /* DB   DD		  */
-
-OP(dd,30) { illegal_1();											} /* DB   DD		  */
-OP(dd,31) { illegal_1();											} /* DB   DD		  */
-OP(dd,32) { illegal_1();											} /* DB   DD		  */
-OP(dd,33) { illegal_1();											} /* DB   DD		  */
-OP(dd,34) { EAX; WM( EA, INC(RM(EA)) ); 							} /* INC  (IX+o)	  */
-OP(dd,35) { EAX; WM( EA, DEC(RM(EA)) ); 							} /* DEC  (IX+o)	  */
-OP(dd,36) { EAX; WM( EA, ARG() );									} /* LD   (IX+o),n	  */
-OP(dd,37) { illegal_1();											} /* DB   DD		  */
-
-OP(dd,38) { illegal_1();											} /* DB   DD		  */
-OP(dd,39) { ADD16(IX,SP);											} /* ADD  IX,SP 	  */
-OP(dd,3a) { illegal_1();											} /* DB   DD		  */
-OP(dd,3b) { illegal_1();											} /* DB   DD		  */
-OP(dd,3c) { illegal_1();											} /* DB   DD		  */
-OP(dd,3d) { illegal_1();											} /* DB   DD		  */
-OP(dd,3e) { illegal_1();											} /* DB   DD		  */
-OP(dd,3f) { illegal_1();											} /* DB   DD		  */
-
-OP(dd,40) { illegal_1();											} /* DB   DD		  */
-OP(dd,41) { illegal_1();											} /* DB   DD		  */
-OP(dd,42) { illegal_1();											} /* DB   DD		  */
-OP(dd,43) { illegal_1();											} /* DB   DD		  */
-OP(dd,44) { _B = _HX;												} /* LD   B,HX		  */
-OP(dd,45) { _B = _LX;												} /* LD   B,LX		  */
-OP(dd,46) { EAX; _B = RM(EA);										} /* LD   B,(IX+o)	  */
-OP(dd,47) { illegal_1();											} /* DB   DD		  */
-
-OP(dd,48) { illegal_1();											} /* DB   DD		  */
-OP(dd,49) { illegal_1();											} /* DB   DD		  */
-OP(dd,4a) { illegal_1();											} /* DB   DD		  */
-OP(dd,4b) { illegal_1();											} /* DB   DD		  */
-OP(dd,4c) { _C = _HX;												} /* LD   C,HX		  */
-OP(dd,4d) { _C = _LX;												} /* LD   C,LX		  */
-OP(dd,4e) { EAX; _C = RM(EA);										} /* LD   C,(IX+o)	  */
-OP(dd,4f) { illegal_1();											} /* DB   DD		  */
-
-OP(dd,50) { illegal_1();											} /* DB   DD		  */
-OP(dd,51) { illegal_1();											} /* DB   DD		  */
-OP(dd,52) { illegal_1();											} /* DB   DD		  */
-OP(dd,53) { illegal_1();											} /* DB   DD		  */
-OP(dd,54) { _D = _HX;												} /* LD   D,HX		  */
-OP(dd,55) { _D = _LX;												} /* LD   D,LX		  */
-OP(dd,56) { EAX; _D = RM(EA);										} /* LD   D,(IX+o)	  */
-OP(dd,57) { illegal_1();											} /* DB   DD		  */
-
-OP(dd,58) { illegal_1();											} /* DB   DD		  */
-OP(dd,59) { illegal_1();											} /* DB   DD		  */
-OP(dd,5a) { illegal_1();											} /* DB   DD		  */
-OP(dd,5b) { illegal_1();											} /* DB   DD		  */
-OP(dd,5c) { _E = _HX;												} /* LD   E,HX		  */
-OP(dd,5d) { _E = _LX;												} /* LD   E,LX		  */
-OP(dd,5e) { EAX; _E = RM(EA);										} /* LD   E,(IX+o)	  */
-OP(dd,5f) { illegal_1();											} /* DB   DD		  */
-
-OP(dd,60) { _HX = _B;												} /* LD   HX,B		  */
-OP(dd,61) { _HX = _C;												} /* LD   HX,C		  */
-OP(dd,62) { _HX = _D;												} /* LD   HX,D		  */
-OP(dd,63) { _HX = _E;												} /* LD   HX,E		  */
-OP(dd,64) { 														} /* LD   HX,HX 	  */
-OP(dd,65) { _HX = _LX;												} /* LD   HX,LX 	  */
-OP(dd,66) { EAX; _H = RM(EA);										} /* LD   H,(IX+o)	  */
-OP(dd,67) { _HX = _A;												} /* LD   HX,A		  */
-
-OP(dd,68) { _LX = _B;												} /* LD   LX,B		  */
-OP(dd,69) { _LX = _C;												} /* LD   LX,C		  */
-OP(dd,6a) { _LX = _D;												} /* LD   LX,D		  */
-OP(dd,6b) { _LX = _E;												} /* LD   LX,E		  */
-OP(dd,6c) { _LX = _HX;												} /* LD   LX,HX 	  */
-OP(dd,6d) { 														} /* LD   LX,LX 	  */
-OP(dd,6e) { EAX; _L = RM(EA);										} /* LD   L,(IX+o)	  */
-OP(dd,6f) { _LX = _A;												} /* LD   LX,A		  */
-
-OP(dd,70) { EAX; WM( EA, _B );										} /* LD   (IX+o),B	  */
-OP(dd,71) { EAX; WM( EA, _C );										} /* LD   (IX+o),C	  */
-OP(dd,72) { EAX; WM( EA, _D );										} /* LD   (IX+o),D	  */
-OP(dd,73) { EAX; WM( EA, _E );										} /* LD   (IX+o),E	  */
-OP(dd,74) { EAX; WM( EA, _H );										} /* LD   (IX+o),H	  */
-OP(dd,75) { EAX; WM( EA, _L );										} /* LD   (IX+o),L	  */
-OP(dd,76) { illegal_1();											}		  /* DB   DD		  */
-OP(dd,77) { EAX; WM( EA, _A );										} /* LD   (IX+o),A	  */
-
-OP(dd,78) { illegal_1();											} /* DB   DD		  */
-OP(dd,79) { illegal_1();											} /* DB   DD		  */
-OP(dd,7a) { illegal_1();											} /* DB   DD		  */
-OP(dd,7b) { illegal_1();											} /* DB   DD		  */
-OP(dd,7c) { _A = _HX;												} /* LD   A,HX		  */
-OP(dd,7d) { _A = _LX;												} /* LD   A,LX		  */
-OP(dd,7e) { EAX; _A = RM(EA);										} /* LD   A,(IX+o)	  */
-OP(dd,7f) { illegal_1();											} /* DB   DD		  */
-
-OP(dd,80) { illegal_1();											} /* DB   DD		  */
-OP(dd,81) { illegal_1();											} /* DB   DD		  */
-OP(dd,82) { illegal_1();											} /* DB   DD		  */
-OP(dd,83) { illegal_1();											} /* DB   DD		  */
-OP(dd,84) { ADD(_HX);												} /* ADD  A,HX		  */
-OP(dd,85) { ADD(_LX);												} /* ADD  A,LX		  */
-OP(dd,86) { EAX; ADD(RM(EA));										} /* ADD  A,(IX+o)	  */
-OP(dd,87) { illegal_1();											} /* DB   DD		  */
-
-OP(dd,88) { illegal_1();											} /* DB   DD		  */
-OP(dd,89) { illegal_1();											} /* DB   DD		  */
-OP(dd,8a) { illegal_1();											} /* DB   DD		  */
-OP(dd,8b) { illegal_1();											} /* DB   DD		  */
-OP(dd,8c) { ADC(_HX);												} /* ADC  A,HX		  */
-OP(dd,8d) { ADC(_LX);												} /* ADC  A,LX		  */
-OP(dd,8e) { EAX; ADC(RM(EA));										} /* ADC  A,(IX+o)	  */
-OP(dd,8f) { illegal_1();											} /* DB   DD		  */
-
-OP(dd,90) { illegal_1();											} /* DB   DD		  */
-OP(dd,91) { illegal_1();											} /* DB   DD		  */
-OP(dd,92) { illegal_1();											} /* DB   DD		  */
-OP(dd,93) { illegal_1();											} /* DB   DD		  */
-OP(dd,94) { SUB(_HX);												} /* SUB  HX		  */
-OP(dd,95) { SUB(_LX);												} /* SUB  LX		  */
-OP(dd,96) { EAX; SUB(RM(EA));										} /* SUB  (IX+o)	  */
-OP(dd,97) { illegal_1();											} /* DB   DD		  */
-
-OP(dd,98) { illegal_1();											} /* DB   DD		  */
-OP(dd,99) { illegal_1();											} /* DB   DD		  */
-OP(dd,9a) { illegal_1();											} /* DB   DD		  */
-OP(dd,9b) { illegal_1();											} /* DB   DD		  */
-OP(dd,9c) { SBC(_HX);												} /* SBC  A,HX		  */
-OP(dd,9d) { SBC(_LX);												} /* SBC  A,LX		  */
-OP(dd,9e) { EAX; SBC(RM(EA));										} /* SBC  A,(IX+o)	  */
-OP(dd,9f) { illegal_1();											} /* DB   DD		  */
-
-OP(dd,a0) { illegal_1();											} /* DB   DD		  */
-OP(dd,a1) { illegal_1();											} /* DB   DD		  */
-OP(dd,a2) { illegal_1();											} /* DB   DD		  */
-OP(dd,a3) { illegal_1();											} /* DB   DD		  */
-OP(dd,a4) { AND(_HX);												} /* AND  HX		  */
-OP(dd,a5) { AND(_LX);												} /* AND  LX		  */
-OP(dd,a6) { EAX; AND(RM(EA));										} /* AND  (IX+o)	  */
-OP(dd,a7) { illegal_1();											} /* DB   DD		  */
-
-OP(dd,a8) { illegal_1();											} /* DB   DD		  */
-OP(dd,a9) { illegal_1();											} /* DB   DD		  */
-OP(dd,aa) { illegal_1();											} /* DB   DD		  */
-OP(dd,ab) { illegal_1();											} /* DB   DD		  */
-OP(dd,ac) { XOR(_HX);												} /* XOR  HX		  */
-OP(dd,ad) { XOR(_LX);												} /* XOR  LX		  */
-OP(dd,ae) { EAX; XOR(RM(EA));										} /* XOR  (IX+o)	  */
-OP(dd,af) { illegal_1();											} /* DB   DD		  */
-
-OP(dd,b0) { illegal_1();											} /* DB   DD		  */
-OP(dd,b1) { illegal_1();											} /* DB   DD		  */
-OP(dd,b2) { illegal_1();											} /* DB   DD		  */
-OP(dd,b3) { illegal_1();											} /* DB   DD		  */
-OP(dd,b4) { OR(_HX);												} /* OR   HX		  */
-OP(dd,b5) { OR(_LX);												} /* OR   LX		  */
-OP(dd,b6) { EAX; OR(RM(EA));										} /* OR   (IX+o)	  */
-OP(dd,b7) { illegal_1();											} /* DB   DD		  */
-
-OP(dd,b8) { illegal_1();											} /* DB   DD		  */
-OP(dd,b9) { illegal_1();											} /* DB   DD		  */
-OP(dd,ba) { illegal_1();											} /* DB   DD		  */
-OP(dd,bb) { illegal_1();											} /* DB   DD		  */
-OP(dd,bc) { CP(_HX);												} /* CP   HX		  */
-OP(dd,bd) { CP(_LX);												} /* CP   LX		  */
-OP(dd,be) { EAX; CP(RM(EA));										} /* CP   (IX+o)	  */
-OP(dd,bf) { illegal_1();											} /* DB   DD		  */
-
-OP(dd,c0) { illegal_1();											} /* DB   DD		  */
-OP(dd,c1) { illegal_1();											} /* DB   DD		  */
-OP(dd,c2) { illegal_1();											} /* DB   DD		  */
-OP(dd,c3) { illegal_1();											} /* DB   DD		  */
-OP(dd,c4) { illegal_1();											} /* DB   DD		  */
-OP(dd,c5) { illegal_1();											} /* DB   DD		  */
-OP(dd,c6) { illegal_1();											} /* DB   DD		  */
-OP(dd,c7) { illegal_1();											}		  /* DB   DD		  */
-
-OP(dd,c8) { illegal_1();											} /* DB   DD		  */
-OP(dd,c9) { illegal_1();											} /* DB   DD		  */
-OP(dd,ca) { illegal_1();											} /* DB   DD		  */
-OP(dd,cb) { EAX; EXEC(xxcb,ARG());									} /* **   DD CB xx	  */
-OP(dd,cc) { illegal_1();											} /* DB   DD		  */
-OP(dd,cd) { illegal_1();											} /* DB   DD		  */
-OP(dd,ce) { illegal_1();											} /* DB   DD		  */
-OP(dd,cf) { illegal_1();											} /* DB   DD		  */
-
-OP(dd,d0) { illegal_1();											} /* DB   DD		  */
-OP(dd,d1) { illegal_1();											} /* DB   DD		  */
-OP(dd,d2) { illegal_1();											} /* DB   DD		  */
-OP(dd,d3) { illegal_1();											} /* DB   DD		  */
-OP(dd,d4) { illegal_1();											} /* DB   DD		  */
-OP(dd,d5) { illegal_1();											} /* DB   DD		  */
-OP(dd,d6) { illegal_1();											} /* DB   DD		  */
-OP(dd,d7) { illegal_1();											} /* DB   DD		  */
-
-OP(dd,d8) { illegal_1();											} /* DB   DD		  */
-OP(dd,d9) { illegal_1();											} /* DB   DD		  */
-OP(dd,da) { illegal_1();											} /* DB   DD		  */
-OP(dd,db) { illegal_1();											} /* DB   DD		  */
-OP(dd,dc) { illegal_1();											} /* DB   DD		  */
-OP(dd,dd) { illegal_1();											} /* DB   DD		  */
-OP(dd,de) { illegal_1();											} /* DB   DD		  */
-OP(dd,df) { illegal_1();											} /* DB   DD		  */
-
-OP(dd,e0) { illegal_1();											} /* DB   DD		  */
-OP(dd,e1) { POP(IX);												} /* POP  IX		  */
-OP(dd,e2) { illegal_1();											} /* DB   DD		  */
-OP(dd,e3) { EXSP(IX);												} /* EX   (SP),IX	  */
-OP(dd,e4) { illegal_1();											} /* DB   DD		  */
-OP(dd,e5) { PUSH( IX ); 											} /* PUSH IX		  */
-OP(dd,e6) { illegal_1();											} /* DB   DD		  */
-OP(dd,e7) { illegal_1();											} /* DB   DD		  */
-
-OP(dd,e8) { illegal_1();											} /* DB   DD		  */
-OP(dd,e9) { _PC = _IX;                                              } /* JP   (IX)        */
-OP(dd,ea) { illegal_1();											} /* DB   DD		  */
-OP(dd,eb) { illegal_1();											} /* DB   DD		  */
-OP(dd,ec) { illegal_1();											} /* DB   DD		  */
-OP(dd,ed) { illegal_1();											} /* DB   DD		  */
-OP(dd,ee) { illegal_1();											} /* DB   DD		  */
-OP(dd,ef) { illegal_1();											} /* DB   DD		  */
-
-OP(dd,f0) { illegal_1();											} /* DB   DD		  */
-OP(dd,f1) { illegal_1();											} /* DB   DD		  */
-OP(dd,f2) { illegal_1();											} /* DB   DD		  */
-OP(dd,f3) { illegal_1();											} /* DB   DD		  */
-OP(dd,f4) { illegal_1();											} /* DB   DD		  */
-OP(dd,f5) { illegal_1();											} /* DB   DD		  */
-OP(dd,f6) { illegal_1();											} /* DB   DD		  */
-OP(dd,f7) { illegal_1();											} /* DB   DD		  */
-
-OP(dd,f8) { illegal_1();											} /* DB   DD		  */
-OP(dd,f9) { _SP = _IX;												} /* LD   SP,IX 	  */
-OP(dd,fa) { illegal_1();											} /* DB   DD		  */
-OP(dd,fb) { illegal_1();											} /* DB   DD		  */
-OP(dd,fc) { illegal_1();											} /* DB   DD		  */
-OP(dd,fd) { illegal_1();											} /* DB   DD		  */
-OP(dd,fe) { illegal_1();											} /* DB   DD		  */
-OP(dd,ff) { illegal_1();											} /* DB   DD		  */
-
-/**********************************************************
- * IY register related opcodes (FD prefix)
- **********************************************************/
-OP(fd,00) { illegal_1();											} /* DB   FD		  */
-OP(fd,01) { illegal_1();											} /* DB   FD		  */
-OP(fd,02) { illegal_1();											} /* DB   FD		  */
-OP(fd,03) { illegal_1();											} /* DB   FD		  */
-OP(fd,04) { illegal_1();											} /* DB   FD		  */
-OP(fd,05) { illegal_1();											} /* DB   FD		  */
-OP(fd,06) { illegal_1();											} /* DB   FD		  */
-OP(fd,07) { illegal_1();											} /* DB   FD		  */
-
-OP(fd,08) { illegal_1();											} /* DB   FD		  */
-OP(fd,09) { ADD16(IY,BC);											} /* ADD  IY,BC 	  */
-OP(fd,0a) { illegal_1();											} /* DB   FD		  */
-OP(fd,0b) { illegal_1();											} /* DB   FD		  */
-OP(fd,0c) { illegal_1();											} /* DB   FD		  */
-OP(fd,0d) { illegal_1();											} /* DB   FD		  */
-OP(fd,0e) { illegal_1();											} /* DB   FD		  */
-OP(fd,0f) { illegal_1();											} /* DB   FD		  */
-
-OP(fd,10) { illegal_1();											} /* DB   FD		  */
-OP(fd,11) { illegal_1();											} /* DB   FD		  */
-OP(fd,12) { illegal_1();											} /* DB   FD		  */
-OP(fd,13) { illegal_1();											} /* DB   FD		  */
-OP(fd,14) { illegal_1();											} /* DB   FD		  */
-OP(fd,15) { illegal_1();											} /* DB   FD		  */
-OP(fd,16) { illegal_1();											} /* DB   FD		  */
-OP(fd,17) { illegal_1();											} /* DB   FD		  */
-
-OP(fd,18) { illegal_1();											} /* DB   FD		  */
-OP(fd,19) { ADD16(IY,DE);											} /* ADD  IY,DE 	  */
-OP(fd,1a) { illegal_1();											} /* DB   FD		  */
-OP(fd,1b) { illegal_1();											} /* DB   FD		  */
-OP(fd,1c) { illegal_1();											} /* DB   FD		  */
-OP(fd,1d) { illegal_1();											} /* DB   FD		  */
-OP(fd,1e) { illegal_1();											} /* DB   FD		  */
-OP(fd,1f) { illegal_1();											} /* DB   FD		  */
-
-OP(fd,20) { illegal_1();											} /* DB   FD		  */
-OP(fd,21) { _IY = ARG16();											} /* LD   IY,w		  */
-OP(fd,22) { EA = ARG16(); WM16( EA, &Z80.IY );						} /* LD   (w),IY	  */
-OP(fd,23) { _IY++;													} /* INC  IY		  */
-OP(fd,24) { _HY = INC(_HY); 										} /* INC  HY		  */
-OP(fd,25) { _HY = DEC(_HY); 										} /* DEC  HY		  */
-OP(fd,26) { _HY = ARG();											} /* LD   HY,n		  */
-OP(fd,27) { illegal_1();											} /* DB   FD		  */
-
-OP(fd,28) { illegal_1();											} /* DB   FD		  */
-OP(fd,29) { ADD16(IY,IY);											} /* ADD  IY,IY 	  */
-OP(fd,2a) { EA = ARG16(); RM16( EA, &Z80.IY );						} /* LD   IY,(w)	  */
-OP(fd,2b) { _IY--;													} /* DEC  IY		  */
-OP(fd,2c) { _LY = INC(_LY); 										} /* INC  LY		  */
-OP(fd,2d) { _LY = DEC(_LY); 										} /* DEC  LY		  */
-OP(fd,2e) { _LY = ARG();											} /* LD   LY,n		  */
-OP(fd,2f) { illegal_1();											} /* DB   FD		  */
-
-OP(fd,30) { illegal_1();											} /* DB   FD		  */
-OP(fd,31) { illegal_1();											} /* DB   FD		  */
-OP(fd,32) { illegal_1();											} /* DB   FD		  */
-OP(fd,33) { illegal_1();											} /* DB   FD		  */
-OP(fd,34) { EAY; WM( EA, INC(RM(EA)) ); 							} /* INC  (IY+o)	  */
-OP(fd,35) { EAY; WM( EA, DEC(RM(EA)) ); 							} /* DEC  (IY+o)	  */
-OP(fd,36) { EAY; WM( EA, ARG() );									} /* LD   (IY+o),n	  */
-OP(fd,37) { illegal_1();											} /* DB   FD		  */
-
-OP(fd,38) { illegal_1();											} /* DB   FD		  */
-OP(fd,39) { ADD16(IY,SP);											} /* ADD  IY,SP 	  */
-OP(fd,3a) { illegal_1();											} /* DB   FD		  */
-OP(fd,3b) { illegal_1();											} /* DB   FD		  */
-OP(fd,3c) { illegal_1();											} /* DB   FD		  */
-OP(fd,3d) { illegal_1();											} /* DB   FD		  */
-OP(fd,3e) { illegal_1();											} /* DB   FD		  */
-OP(fd,3f) { illegal_1();											} /* DB   FD		  */
-
-OP(fd,40) { illegal_1();											} /* DB   FD		  */
-OP(fd,41) { illegal_1();											} /* DB   FD		  */
-OP(fd,42) { illegal_1();											} /* DB   FD		  */
-OP(fd,43) { illegal_1();											} /* DB   FD		  */
-OP(fd,44) { _B = _HY;												} /* LD   B,HY		  */
-OP(fd,45) { _B = _LY;												} /* LD   B,LY		  */
-OP(fd,46) { EAY; _B = RM(EA);										} /* LD   B,(IY+o)	  */
-OP(fd,47) { illegal_1();											} /* DB   FD		  */
-
-OP(fd,48) { illegal_1();											} /* DB   FD		  */
-OP(fd,49) { illegal_1();											} /* DB   FD		  */
-OP(fd,4a) { illegal_1();											} /* DB   FD		  */
-OP(fd,4b) { illegal_1();											} /* DB   FD		  */
-OP(fd,4c) { _C = _HY;												} /* LD   C,HY		  */
-OP(fd,4d) { _C = _LY;												} /* LD   C,LY		  */
-OP(fd,4e) { EAY; _C = RM(EA);										} /* LD   C,(IY+o)	  */
-OP(fd,4f) { illegal_1();											} /* DB   FD		  */
-
-OP(fd,50) { illegal_1();											} /* DB   FD		  */
-OP(fd,51) { illegal_1();											} /* DB   FD		  */
-OP(fd,52) { illegal_1();											} /* DB   FD		  */
-OP(fd,53) { illegal_1();											} /* DB   FD		  */
-OP(fd,54) { _D = _HY;												} /* LD   D,HY		  */
-OP(fd,55) { _D = _LY;												} /* LD   D,LY		  */
-OP(fd,56) { EAY; _D = RM(EA);										} /* LD   D,(IY+o)	  */
-OP(fd,57) { illegal_1();											} /* DB   FD		  */
-
-OP(fd,58) { illegal_1();											} /* DB   FD		  */
-OP(fd,59) { illegal_1();											} /* DB   FD		  */
-OP(fd,5a) { illegal_1();											} /* DB   FD		  */
-OP(fd,5b) { illegal_1();											} /* DB   FD		  */
-OP(fd,5c) { _E = _HY;												} /* LD   E,HY		  */
-OP(fd,5d) { _E = _LY;												} /* LD   E,LY		  */
-OP(fd,5e) { EAY; _E = RM(EA);										} /* LD   E,(IY+o)	  */
-OP(fd,5f) { illegal_1();											} /* DB   FD		  */
-
-OP(fd,60) { _HY = _B;												} /* LD   HY,B		  */
-OP(fd,61) { _HY = _C;												} /* LD   HY,C		  */
-OP(fd,62) { _HY = _D;												} /* LD   HY,D		  */
-OP(fd,63) { _HY = _E;												} /* LD   HY,E		  */
-OP(fd,64) { 														} /* LD   HY,HY 	  */
-OP(fd,65) { _HY = _LY;												} /* LD   HY,LY 	  */
-OP(fd,66) { EAY; _H = RM(EA);										} /* LD   H,(IY+o)	  */
-OP(fd,67) { _HY = _A;												} /* LD   HY,A		  */
-
-OP(fd,68) { _LY = _B;												} /* LD   LY,B		  */
-OP(fd,69) { _LY = _C;												} /* LD   LY,C		  */
-OP(fd,6a) { _LY = _D;												} /* LD   LY,D		  */
-OP(fd,6b) { _LY = _E;												} /* LD   LY,E		  */
-OP(fd,6c) { _LY = _HY;												} /* LD   LY,HY 	  */
-OP(fd,6d) { 														} /* LD   LY,LY 	  */
-OP(fd,6e) { EAY; _L = RM(EA);										} /* LD   L,(IY+o)	  */
-OP(fd,6f) { _LY = _A;												} /* LD   LY,A		  */
-
-OP(fd,70) { EAY; WM( EA, _B );										} /* LD   (IY+o),B	  */
-OP(fd,71) { EAY; WM( EA, _C );										} /* LD   (IY+o),C	  */
-OP(fd,72) { EAY; WM( EA, _D );										} /* LD   (IY+o),D	  */
-OP(fd,73) { EAY; WM( EA, _E );										} /* LD   (IY+o),E	  */
-OP(fd,74) { EAY; WM( EA, _H );										} /* LD   (IY+o),H	  */
-OP(fd,75) { EAY; WM( EA, _L );										} /* LD   (IY+o),L	  */
-OP(fd,76) { illegal_1();											}		  /* DB   FD		  */
-OP(fd,77) { EAY; WM( EA, _A );										} /* LD   (IY+o),A	  */
-
-OP(fd,78) { illegal_1();											} /* DB   FD		  */
-OP(fd,79) { illegal_1();											} /* DB   FD		  */
-OP(fd,7a) { illegal_1();											} /* DB   FD		  */
-OP(fd,7b) { illegal_1();											} /* DB   FD		  */
-OP(fd,7c) { _A = _HY;												} /* LD   A,HY		  */
-OP(fd,7d) { _A = _LY;												} /* LD   A,LY		  */
-OP(fd,7e) { EAY; _A = RM(EA);										} /* LD   A,(IY+o)	  */
-OP(fd,7f) { illegal_1();											} /* DB   FD		  */
-
-OP(fd,80) { illegal_1();											} /* DB   FD		  */
-OP(fd,81) { illegal_1();											} /* DB   FD		  */
-OP(fd,82) { illegal_1();											} /* DB   FD		  */
-OP(fd,83) { illegal_1();											} /* DB   FD		  */
-OP(fd,84) { ADD(_HY);												} /* ADD  A,HY		  */
-OP(fd,85) { ADD(_LY);												} /* ADD  A,LY		  */
-OP(fd,86) { EAY; ADD(RM(EA));										} /* ADD  A,(IY+o)	  */
-OP(fd,87) { illegal_1();											} /* DB   FD		  */
-
-OP(fd,88) { illegal_1();											} /* DB   FD		  */
-OP(fd,89) { illegal_1();											} /* DB   FD		  */
-OP(fd,8a) { illegal_1();											} /* DB   FD		  */
-OP(fd,8b) { illegal_1();											} /* DB   FD		  */
-OP(fd,8c) { ADC(_HY);												} /* ADC  A,HY		  */
-OP(fd,8d) { ADC(_LY);												} /* ADC  A,LY		  */
-OP(fd,8e) { EAY; ADC(RM(EA));										} /* ADC  A,(IY+o)	  */
-OP(fd,8f) { illegal_1();											} /* DB   FD		  */
-
-OP(fd,90) { illegal_1();											} /* DB   FD		  */
-OP(fd,91) { illegal_1();											} /* DB   FD		  */
-OP(fd,92) { illegal_1();											} /* DB   FD		  */
-OP(fd,93) { illegal_1();											} /* DB   FD		  */
-OP(fd,94) { SUB(_HY);												} /* SUB  HY		  */
-OP(fd,95) { SUB(_LY);												} /* SUB  LY		  */
-OP(fd,96) { EAY; SUB(RM(EA));										} /* SUB  (IY+o)	  */
-OP(fd,97) { illegal_1();											} /* DB   FD		  */
-
-OP(fd,98) { illegal_1();											} /* DB   FD		  */
-OP(fd,99) { illegal_1();											} /* DB   FD		  */
-OP(fd,9a) { illegal_1();											} /* DB   FD		  */
-OP(fd,9b) { illegal_1();											} /* DB   FD		  */
-OP(fd,9c) { SBC(_HY);												} /* SBC  A,HY		  */
-OP(fd,9d) { SBC(_LY);												} /* SBC  A,LY		  */
-OP(fd,9e) { EAY; SBC(RM(EA));										} /* SBC  A,(IY+o)	  */
-OP(fd,9f) { illegal_1();											} /* DB   FD		  */
-
-OP(fd,a0) { illegal_1();											} /* DB   FD		  */
-OP(fd,a1) { illegal_1();											} /* DB   FD		  */
-OP(fd,a2) { illegal_1();											} /* DB   FD		  */
-OP(fd,a3) { illegal_1();											} /* DB   FD		  */
-OP(fd,a4) { AND(_HY);												} /* AND  HY		  */
-OP(fd,a5) { AND(_LY);												} /* AND  LY		  */
-OP(fd,a6) { EAY; AND(RM(EA));										} /* AND  (IY+o)	  */
-OP(fd,a7) { illegal_1();											} /* DB   FD		  */
-
-OP(fd,a8) { illegal_1();											} /* DB   FD		  */
-OP(fd,a9) { illegal_1();											} /* DB   FD		  */
-OP(fd,aa) { illegal_1();											} /* DB   FD		  */
-OP(fd,ab) { illegal_1();											} /* DB   FD		  */
-OP(fd,ac) { XOR(_HY);												} /* XOR  HY		  */
-OP(fd,ad) { XOR(_LY);												} /* XOR  LY		  */
-OP(fd,ae) { EAY; XOR(RM(EA));										} /* XOR  (IY+o)	  */
-OP(fd,af) { illegal_1();											} /* DB   FD		  */
-
-OP(fd,b0) { illegal_1();											} /* DB   FD		  */
-OP(fd,b1) { illegal_1();											} /* DB   FD		  */
-OP(fd,b2) { illegal_1();											} /* DB   FD		  */
-OP(fd,b3) { illegal_1();											} /* DB   FD		  */
-OP(fd,b4) { OR(_HY);												} /* OR   HY		  */
-OP(fd,b5) { OR(_LY);												} /* OR   LY		  */
-OP(fd,b6) { EAY; OR(RM(EA));										} /* OR   (IY+o)	  */
-OP(fd,b7) { illegal_1();											} /* DB   FD		  */
-
-OP(fd,b8) { illegal_1();											} /* DB   FD		  */
-OP(fd,b9) { illegal_1();											} /* DB   FD		  */
-OP(fd,ba) { illegal_1();											} /* DB   FD		  */
-OP(fd,bb) { illegal_1();											} /* DB   FD		  */
-OP(fd,bc) { CP(_HY);												} /* CP   HY		  */
-OP(fd,bd) { CP(_LY);												} /* CP   LY		  */
-OP(fd,be) { EAY; CP(RM(EA));										} /* CP   (IY+o)	  */
-OP(fd,bf) { illegal_1();											} /* DB   FD		  */
-
-OP(fd,c0) { illegal_1();											} /* DB   FD		  */
-OP(fd,c1) { illegal_1();											} /* DB   FD		  */
-OP(fd,c2) { illegal_1();											} /* DB   FD		  */
-OP(fd,c3) { illegal_1();											} /* DB   FD		  */
-OP(fd,c4) { illegal_1();											} /* DB   FD		  */
-OP(fd,c5) { illegal_1();											} /* DB   FD		  */
-OP(fd,c6) { illegal_1();											} /* DB   FD		  */
-OP(fd,c7) { illegal_1();											} /* DB   FD		  */
-
-OP(fd,c8) { illegal_1();											} /* DB   FD		  */
-OP(fd,c9) { illegal_1();											} /* DB   FD		  */
-OP(fd,ca) { illegal_1();											} /* DB   FD		  */
-OP(fd,cb) { EAY; EXEC(xxcb,ARG());									} /* **   FD CB xx	  */
-OP(fd,cc) { illegal_1();											} /* DB   FD		  */
-OP(fd,cd) { illegal_1();											} /* DB   FD		  */
-OP(fd,ce) { illegal_1();											} /* DB   FD		  */
-OP(fd,cf) { illegal_1();											} /* DB   FD		  */
-
-OP(fd,d0) { illegal_1();											} /* DB   FD		  */
-OP(fd,d1) { illegal_1();											} /* DB   FD		  */
-OP(fd,d2) { illegal_1();											} /* DB   FD		  */
-OP(fd,d3) { illegal_1();											} /* DB   FD		  */
-OP(fd,d4) { illegal_1();											} /* DB   FD		  */
-OP(fd,d5) { illegal_1();											} /* DB   FD		  */
-OP(fd,d6) { illegal_1();											} /* DB   FD		  */
-OP(fd,d7) { illegal_1();											} /* DB   FD		  */
-
-OP(fd,d8) { illegal_1();											} /* DB   FD		  */
-OP(fd,d9) { illegal_1();											} /* DB   FD		  */
-OP(fd,da) { illegal_1();											} /* DB   FD		  */
-OP(fd,db) { illegal_1();											} /* DB   FD		  */
-OP(fd,dc) { illegal_1();											} /* DB   FD		  */
-OP(fd,dd) { illegal_1();											} /* DB   FD		  */
-OP(fd,de) { illegal_1();											} /* DB   FD		  */
-OP(fd,df) { illegal_1();											} /* DB   FD		  */
-
-OP(fd,e0) { illegal_1();											} /* DB   FD		  */
-OP(fd,e1) { POP(IY);												} /* POP  IY		  */
-OP(fd,e2) { illegal_1();											} /* DB   FD		  */
-OP(fd,e3) { EXSP(IY);												} /* EX   (SP),IY	  */
-OP(fd,e4) { illegal_1();											} /* DB   FD		  */
-OP(fd,e5) { PUSH( IY ); 											} /* PUSH IY		  */
-OP(fd,e6) { illegal_1();											} /* DB   FD		  */
-OP(fd,e7) { illegal_1();											} /* DB   FD		  */
-
-OP(fd,e8) { illegal_1();											} /* DB   FD		  */
-OP(fd,e9) { _PC = _IY;                                              } /* JP   (IY)        */
-OP(fd,ea) { illegal_1();											} /* DB   FD		  */
-OP(fd,eb) { illegal_1();											} /* DB   FD		  */
-OP(fd,ec) { illegal_1();											} /* DB   FD		  */
-OP(fd,ed) { illegal_1();											} /* DB   FD		  */
-OP(fd,ee) { illegal_1();											} /* DB   FD		  */
-OP(fd,ef) { illegal_1();											} /* DB   FD		  */
-
-OP(fd,f0) { illegal_1();											} /* DB   FD		  */
-OP(fd,f1) { illegal_1();											} /* DB   FD		  */
-OP(fd,f2) { illegal_1();											} /* DB   FD		  */
-OP(fd,f3) { illegal_1();											} /* DB   FD		  */
-OP(fd,f4) { illegal_1();											} /* DB   FD		  */
-OP(fd,f5) { illegal_1();											} /* DB   FD		  */
-OP(fd,f6) { illegal_1();											} /* DB   FD		  */
-OP(fd,f7) { illegal_1();											} /* DB   FD		  */
-
-OP(fd,f8) { illegal_1();											} /* DB   FD		  */
-OP(fd,f9) { _SP = _IY;												} /* LD   SP,IY 	  */
-OP(fd,fa) { illegal_1();											} /* DB   FD		  */
-OP(fd,fb) { illegal_1();											} /* DB   FD		  */
-OP(fd,fc) { illegal_1();											} /* DB   FD		  */
-OP(fd,fd) { illegal_1();											} /* DB   FD		  */
-OP(fd,fe) { illegal_1();											} /* DB   FD		  */
-OP(fd,ff) { illegal_1();											} /* DB   FD		  */
-
-OP(illegal,2)
-{
-}
-
-/**********************************************************
- * special opcodes (ED prefix)
- **********************************************************/
-OP(ed,00) { illegal_2();											} /* DB   ED		  */
-OP(ed,01) { illegal_2();											} /* DB   ED		  */
-OP(ed,02) { illegal_2();											} /* DB   ED		  */
-OP(ed,03) { illegal_2();											} /* DB   ED		  */
-OP(ed,04) { illegal_2();											} /* DB   ED		  */
-OP(ed,05) { illegal_2();											} /* DB   ED		  */
-OP(ed,06) { illegal_2();											} /* DB   ED		  */
-OP(ed,07) { illegal_2();											} /* DB   ED		  */
-
-OP(ed,08) { illegal_2();											} /* DB   ED		  */
-OP(ed,09) { illegal_2();											} /* DB   ED		  */
-OP(ed,0a) { illegal_2();											} /* DB   ED		  */
-OP(ed,0b) { illegal_2();											} /* DB   ED		  */
-OP(ed,0c) { illegal_2();											} /* DB   ED		  */
-OP(ed,0d) { illegal_2();											} /* DB   ED		  */
-OP(ed,0e) { illegal_2();											} /* DB   ED		  */
-OP(ed,0f) { illegal_2();											} /* DB   ED		  */
-
-OP(ed,10) { illegal_2();											} /* DB   ED		  */
-OP(ed,11) { illegal_2();											} /* DB   ED		  */
-OP(ed,12) { illegal_2();											} /* DB   ED		  */
-OP(ed,13) { illegal_2();											} /* DB   ED		  */
-OP(ed,14) { illegal_2();											} /* DB   ED		  */
-OP(ed,15) { illegal_2();											} /* DB   ED		  */
-OP(ed,16) { illegal_2();											} /* DB   ED		  */
-OP(ed,17) { illegal_2();											} /* DB   ED		  */
-
-OP(ed,18) { illegal_2();											} /* DB   ED		  */
-OP(ed,19) { illegal_2();											} /* DB   ED		  */
-OP(ed,1a) { illegal_2();											} /* DB   ED		  */
-OP(ed,1b) { illegal_2();											} /* DB   ED		  */
-OP(ed,1c) { illegal_2();											} /* DB   ED		  */
-OP(ed,1d) { illegal_2();											} /* DB   ED		  */
-OP(ed,1e) { illegal_2();											} /* DB   ED		  */
-OP(ed,1f) { illegal_2();											} /* DB   ED		  */
-
-OP(ed,20) { illegal_2();											} /* DB   ED		  */
-OP(ed,21) { illegal_2();											} /* DB   ED		  */
-OP(ed,22) { illegal_2();											} /* DB   ED		  */
-OP(ed,23) { illegal_2();											} /* DB   ED		  */
-OP(ed,24) { illegal_2();											} /* DB   ED		  */
-OP(ed,25) { illegal_2();											} /* DB   ED		  */
-OP(ed,26) { illegal_2();											} /* DB   ED		  */
-OP(ed,27) { illegal_2();											} /* DB   ED		  */
-
-OP(ed,28) { illegal_2();											} /* DB   ED		  */
-OP(ed,29) { illegal_2();											} /* DB   ED		  */
-OP(ed,2a) { illegal_2();											} /* DB   ED		  */
-OP(ed,2b) { illegal_2();											} /* DB   ED		  */
-OP(ed,2c) { illegal_2();											} /* DB   ED		  */
-OP(ed,2d) { illegal_2();											} /* DB   ED		  */
-OP(ed,2e) { illegal_2();											} /* DB   ED		  */
-OP(ed,2f) { illegal_2();											} /* DB   ED		  */
-
-OP(ed,30) { illegal_2();											} /* DB   ED		  */
-OP(ed,31) { illegal_2();											} /* DB   ED		  */
-OP(ed,32) { illegal_2();											} /* DB   ED		  */
-OP(ed,33) { illegal_2();											} /* DB   ED		  */
-OP(ed,34) { illegal_2();											} /* DB   ED		  */
-OP(ed,35) { illegal_2();											} /* DB   ED		  */
-OP(ed,36) { illegal_2();											} /* DB   ED		  */
-OP(ed,37) { illegal_2();											} /* DB   ED		  */
-
-OP(ed,38) { illegal_2();											} /* DB   ED		  */
-OP(ed,39) { illegal_2();											} /* DB   ED		  */
-OP(ed,3a) { illegal_2();											} /* DB   ED		  */
-OP(ed,3b) { illegal_2();											} /* DB   ED		  */
-OP(ed,3c) { illegal_2();											} /* DB   ED		  */
-OP(ed,3d) { illegal_2();											} /* DB   ED		  */
-OP(ed,3e) { illegal_2();											} /* DB   ED		  */
-OP(ed,3f) { illegal_2();											} /* DB   ED		  */
-
-OP(ed,40) { _B = IN(_BC); _F = (_F & CF) | SZP[_B]; 				} /* IN   B,(C) 	  */
-OP(ed,41) { OUT(_BC,_B);											} /* OUT  (C),B 	  */
-OP(ed,42) { SBC16( BC );											} /* SBC  HL,BC 	  */
-OP(ed,43) { EA = ARG16(); WM16( EA, &Z80.BC );						} /* LD   (w),BC	  */
-OP(ed,44) { NEG;													} /* NEG			  */
-OP(ed,45) { RETN;													} /* RETN;			  */
-OP(ed,46) { _IM = 0;												} /* IM   0 		  */
-OP(ed,47) { LD_I_A; 												} /* LD   I,A		  */
-
-OP(ed,48) { _C = IN(_BC); _F = (_F & CF) | SZP[_C]; 				} /* IN   C,(C) 	  */
-OP(ed,49) { OUT(_BC,_C);											} /* OUT  (C),C 	  */
-OP(ed,4a) { ADC16( BC );											} /* ADC  HL,BC 	  */
-OP(ed,4b) { EA = ARG16(); RM16( EA, &Z80.BC );						} /* LD   BC,(w)	  */
-OP(ed,4c) { NEG;													} /* NEG			  */
-OP(ed,4d) { RETI;													} /* RETI			  */
-OP(ed,4e) { _IM = 0;												} /* IM   0 		  */
-OP(ed,4f) { LD_R_A; 												} /* LD   R,A		  */
-
-OP(ed,50) { _D = IN(_BC); _F = (_F & CF) | SZP[_D]; 				} /* IN   D,(C) 	  */
-OP(ed,51) { OUT(_BC,_D);											} /* OUT  (C),D 	  */
-OP(ed,52) { SBC16( DE );											} /* SBC  HL,DE 	  */
-OP(ed,53) { EA = ARG16(); WM16( EA, &Z80.DE );						} /* LD   (w),DE	  */
-OP(ed,54) { NEG;													} /* NEG			  */
-OP(ed,55) { RETN;													} /* RETN;			  */
-OP(ed,56) { _IM = 1;												} /* IM   1 		  */
-OP(ed,57) { LD_A_I; 												} /* LD   A,I		  */
-
-OP(ed,58) { _E = IN(_BC); _F = (_F & CF) | SZP[_E]; 				} /* IN   E,(C) 	  */
-OP(ed,59) { OUT(_BC,_E);											} /* OUT  (C),E 	  */
-OP(ed,5a) { ADC16( DE );											} /* ADC  HL,DE 	  */
-OP(ed,5b) { EA = ARG16(); RM16( EA, &Z80.DE );						} /* LD   DE,(w)	  */
-OP(ed,5c) { NEG;													} /* NEG			  */
-OP(ed,5d) { RETI;													} /* RETI			  */
-OP(ed,5e) { _IM = 2;												} /* IM   2 		  */
-OP(ed,5f) { LD_A_R; 												} /* LD   A,R		  */
-
-OP(ed,60) { _H = IN(_BC); _F = (_F & CF) | SZP[_H]; 				} /* IN   H,(C) 	  */
-OP(ed,61) { OUT(_BC,_H);											} /* OUT  (C),H 	  */
-OP(ed,62) { SBC16( HL );											} /* SBC  HL,HL 	  */
-OP(ed,63) { EA = ARG16(); WM16( EA, &Z80.HL );						} /* LD   (w),HL	  */
-OP(ed,64) { NEG;													} /* NEG			  */
-OP(ed,65) { RETN;													} /* RETN;			  */
-OP(ed,66) { _IM = 0;												} /* IM   0 		  */
-OP(ed,67) { RRD;													} /* RRD  (HL)		  */
-
-OP(ed,68) { _L = IN(_BC); _F = (_F & CF) | SZP[_L]; 				} /* IN   L,(C) 	  */
-OP(ed,69) { OUT(_BC,_L);											} /* OUT  (C),L 	  */
-OP(ed,6a) { ADC16( HL );											} /* ADC  HL,HL 	  */
-OP(ed,6b) { EA = ARG16(); RM16( EA, &Z80.HL );						} /* LD   HL,(w)	  */
-OP(ed,6c) { NEG;													} /* NEG			  */
-OP(ed,6d) { RETI;													} /* RETI			  */
-OP(ed,6e) { _IM = 0;												} /* IM   0 		  */
-OP(ed,6f) { RLD;													} /* RLD  (HL)		  */
-
-OP(ed,70) { UINT8 res = IN(_BC); _F = (_F & CF) | SZP[res]; 		} /* IN   0,(C) 	  */
-OP(ed,71) { OUT(_BC,0); 											} /* OUT  (C),0 	  */
-OP(ed,72) { SBC16( SP );											} /* SBC  HL,SP 	  */
-OP(ed,73) { EA = ARG16(); WM16( EA, &Z80.SP );						} /* LD   (w),SP	  */
-OP(ed,74) { NEG;													} /* NEG			  */
-OP(ed,75) { RETN;													} /* RETN;			  */
-OP(ed,76) { _IM = 1;												} /* IM   1 		  */
-OP(ed,77) { illegal_2();											} /* DB   ED,77 	  */
-
-OP(ed,78) { _A = IN(_BC); _F = (_F & CF) | SZP[_A]; 				} /* IN   E,(C) 	  */
-OP(ed,79) { OUT(_BC,_A);											} /* OUT  (C),E 	  */
-OP(ed,7a) { ADC16( SP );											} /* ADC  HL,SP 	  */
-OP(ed,7b) { EA = ARG16(); RM16( EA, &Z80.SP );						} /* LD   SP,(w)	  */
-OP(ed,7c) { NEG;													} /* NEG			  */
-OP(ed,7d) { RETI;													} /* RETI			  */
-OP(ed,7e) { _IM = 2;												} /* IM   2 		  */
-OP(ed,7f) { illegal_2();											} /* DB   ED,7F 	  */
-
-OP(ed,80) { illegal_2();											} /* DB   ED		  */
-OP(ed,81) { illegal_2();											} /* DB   ED		  */
-OP(ed,82) { illegal_2();											} /* DB   ED		  */
-OP(ed,83) { illegal_2();											} /* DB   ED		  */
-OP(ed,84) { illegal_2();											} /* DB   ED		  */
-OP(ed,85) { illegal_2();											} /* DB   ED		  */
-OP(ed,86) { illegal_2();											} /* DB   ED		  */
-OP(ed,87) { illegal_2();											} /* DB   ED		  */
-
-OP(ed,88) { illegal_2();											} /* DB   ED		  */
-OP(ed,89) { illegal_2();											} /* DB   ED		  */
-OP(ed,8a) { illegal_2();											} /* DB   ED		  */
-OP(ed,8b) { illegal_2();											} /* DB   ED		  */
-OP(ed,8c) { illegal_2();											} /* DB   ED		  */
-OP(ed,8d) { illegal_2();											} /* DB   ED		  */
-OP(ed,8e) { illegal_2();											} /* DB   ED		  */
-OP(ed,8f) { illegal_2();											} /* DB   ED		  */
-
-OP(ed,90) { illegal_2();											} /* DB   ED		  */
-OP(ed,91) { illegal_2();											} /* DB   ED		  */
-OP(ed,92) { illegal_2();											} /* DB   ED		  */
-OP(ed,93) { illegal_2();											} /* DB   ED		  */
-OP(ed,94) { illegal_2();											} /* DB   ED		  */
-OP(ed,95) { illegal_2();											} /* DB   ED		  */
-OP(ed,96) { illegal_2();											} /* DB   ED		  */
-OP(ed,97) { illegal_2();											} /* DB   ED		  */
-
-OP(ed,98) { illegal_2();											} /* DB   ED		  */
-OP(ed,99) { illegal_2();											} /* DB   ED		  */
-OP(ed,9a) { illegal_2();											} /* DB   ED		  */
-OP(ed,9b) { illegal_2();											} /* DB   ED		  */
-OP(ed,9c) { illegal_2();											} /* DB   ED		  */
-OP(ed,9d) { illegal_2();											} /* DB   ED		  */
-OP(ed,9e) { illegal_2();											} /* DB   ED		  */
-OP(ed,9f) { illegal_2();											} /* DB   ED		  */
-
-OP(ed,a0) { LDI;													} /* LDI			  */
-OP(ed,a1) { CPI;													} /* CPI			  */
-OP(ed,a2) { INI;													} /* INI			  */
-OP(ed,a3) { OUTI;													} /* OUTI			  */
-OP(ed,a4) { illegal_2();											} /* DB   ED		  */
-OP(ed,a5) { illegal_2();											} /* DB   ED		  */
-OP(ed,a6) { illegal_2();											} /* DB   ED		  */
-OP(ed,a7) { illegal_2();											} /* DB   ED		  */
-
-OP(ed,a8) { LDD;													} /* LDD			  */
-OP(ed,a9) { CPD;													} /* CPD			  */
-OP(ed,aa) { IND;													} /* IND			  */
-OP(ed,ab) { OUTD;													} /* OUTD			  */
-OP(ed,ac) { illegal_2();											} /* DB   ED		  */
-OP(ed,ad) { illegal_2();											} /* DB   ED		  */
-OP(ed,ae) { illegal_2();											} /* DB   ED		  */
-OP(ed,af) { illegal_2();											} /* DB   ED		  */
-
-OP(ed,b0) { LDIR;													} /* LDIR			  */
-OP(ed,b1) { CPIR;													} /* CPIR			  */
-OP(ed,b2) { INIR;													} /* INIR			  */
-OP(ed,b3) { OTIR;													} /* OTIR			  */
-OP(ed,b4) { illegal_2();											} /* DB   ED		  */
-OP(ed,b5) { illegal_2();											} /* DB   ED		  */
-OP(ed,b6) { illegal_2();											} /* DB   ED		  */
-OP(ed,b7) { illegal_2();											} /* DB   ED		  */
-
-OP(ed,b8) { LDDR;													} /* LDDR			  */
-OP(ed,b9) { CPDR;													} /* CPDR			  */
-OP(ed,ba) { INDR;													} /* INDR			  */
-OP(ed,bb) { OTDR;													} /* OTDR			  */
-OP(ed,bc) { illegal_2();											} /* DB   ED		  */
-OP(ed,bd) { illegal_2();											} /* DB   ED		  */
-OP(ed,be) { illegal_2();											} /* DB   ED		  */
-OP(ed,bf) { illegal_2();											} /* DB   ED		  */
-
-OP(ed,c0) { illegal_2();											} /* DB   ED		  */
-OP(ed,c1) { illegal_2();											} /* DB   ED		  */
-OP(ed,c2) { illegal_2();											} /* DB   ED		  */
-OP(ed,c3) { illegal_2();											} /* DB   ED		  */
-OP(ed,c4) { illegal_2();											} /* DB   ED		  */
-OP(ed,c5) { illegal_2();											} /* DB   ED		  */
-OP(ed,c6) { illegal_2();											} /* DB   ED		  */
-OP(ed,c7) { illegal_2();											} /* DB   ED		  */
-
-OP(ed,c8) { illegal_2();											} /* DB   ED		  */
-OP(ed,c9) { illegal_2();											} /* DB   ED		  */
-OP(ed,ca) { illegal_2();											} /* DB   ED		  */
-OP(ed,cb) { illegal_2();											} /* DB   ED		  */
-OP(ed,cc) { illegal_2();											} /* DB   ED		  */
-OP(ed,cd) { illegal_2();											} /* DB   ED		  */
-OP(ed,ce) { illegal_2();											} /* DB   ED		  */
-OP(ed,cf) { illegal_2();											} /* DB   ED		  */
-
-OP(ed,d0) { illegal_2();											} /* DB   ED		  */
-OP(ed,d1) { illegal_2();											} /* DB   ED		  */
-OP(ed,d2) { illegal_2();											} /* DB   ED		  */
-OP(ed,d3) { illegal_2();											} /* DB   ED		  */
-OP(ed,d4) { illegal_2();											} /* DB   ED		  */
-OP(ed,d5) { illegal_2();											} /* DB   ED		  */
-OP(ed,d6) { illegal_2();											} /* DB   ED		  */
-OP(ed,d7) { illegal_2();											} /* DB   ED		  */
-
-OP(ed,d8) { illegal_2();											} /* DB   ED		  */
-OP(ed,d9) { illegal_2();											} /* DB   ED		  */
-OP(ed,da) { illegal_2();											} /* DB   ED		  */
-OP(ed,db) { illegal_2();											} /* DB   ED		  */
-OP(ed,dc) { illegal_2();											} /* DB   ED		  */
-OP(ed,dd) { illegal_2();											} /* DB   ED		  */
-OP(ed,de) { illegal_2();											} /* DB   ED		  */
-OP(ed,df) { illegal_2();											} /* DB   ED		  */
-
-OP(ed,e0) { illegal_2();											} /* DB   ED		  */
-OP(ed,e1) { illegal_2();											} /* DB   ED		  */
-OP(ed,e2) { illegal_2();											} /* DB   ED		  */
-OP(ed,e3) { illegal_2();											} /* DB   ED		  */
-OP(ed,e4) { illegal_2();											} /* DB   ED		  */
-OP(ed,e5) { illegal_2();											} /* DB   ED		  */
-OP(ed,e6) { illegal_2();											} /* DB   ED		  */
-OP(ed,e7) { illegal_2();											} /* DB   ED		  */
-
-OP(ed,e8) { illegal_2();											} /* DB   ED		  */
-OP(ed,e9) { illegal_2();											} /* DB   ED		  */
-OP(ed,ea) { illegal_2();											} /* DB   ED		  */
-OP(ed,eb) { illegal_2();											} /* DB   ED		  */
-OP(ed,ec) { illegal_2();											} /* DB   ED		  */
-OP(ed,ed) { illegal_2();											} /* DB   ED		  */
-OP(ed,ee) { illegal_2();											} /* DB   ED		  */
-OP(ed,ef) { illegal_2();											} /* DB   ED		  */
-
-OP(ed,f0) { illegal_2();											} /* DB   ED		  */
-OP(ed,f1) { illegal_2();											} /* DB   ED		  */
-OP(ed,f2) { illegal_2();											} /* DB   ED		  */
-OP(ed,f3) { illegal_2();											} /* DB   ED		  */
-OP(ed,f4) { illegal_2();											} /* DB   ED		  */
-OP(ed,f5) { illegal_2();											} /* DB   ED		  */
-OP(ed,f6) { illegal_2();											} /* DB   ED		  */
-OP(ed,f7) { illegal_2();											} /* DB   ED		  */
-
-OP(ed,f8) { illegal_2();											} /* DB   ED		  */
-OP(ed,f9) { illegal_2();											} /* DB   ED		  */
-OP(ed,fa) { illegal_2();											} /* DB   ED		  */
-OP(ed,fb) { illegal_2();											} /* DB   ED		  */
-OP(ed,fc) { illegal_2();											} /* DB   ED		  */
-OP(ed,fd) { illegal_2();											} /* DB   ED		  */
-OP(ed,fe) { illegal_2();											} /* DB   ED		  */
-OP(ed,ff) { illegal_2();											} /* DB   ED		  */
-
 #if TIME_LOOP_HACKS
 
 #define CHECK_BC_LOOP                                               \
@@ -3648,297 +2194,7 @@ if( _HL > 1 && _PCD < 0xfffc ) {                                    \
 
 #endif
 
-/**********************************************************
- * main opcodes
- **********************************************************/
-OP(op,00) { 														} /* NOP			  */
-OP(op,01) { _BC = ARG16();											} /* LD   BC,w		  */
-OP(op,02) { WM( _BC, _A );											} /* LD   (BC),A	  */
-OP(op,03) { _BC++;													} /* INC  BC		  */
-OP(op,04) { _B = INC(_B);											} /* INC  B 		  */
-OP(op,05) { _B = DEC(_B);											} /* DEC  B 		  */
-OP(op,06) { _B = ARG(); 											} /* LD   B,n		  */
-OP(op,07) { RLCA;													} /* RLCA			  */
-
-OP(op,08) { EX_AF;													} /* EX   AF,AF'      */
-OP(op,09) { ADD16(HL,BC);											} /* ADD  HL,BC 	  */
-OP(op,0a) { _A = RM(_BC);											} /* LD   A,(BC)	  */
-OP(op,0b) { _BC--; CHECK_BC_LOOP;									} /* DEC  BC		  */
-OP(op,0c) { _C = INC(_C);											} /* INC  C 		  */
-OP(op,0d) { _C = DEC(_C);											} /* DEC  C 		  */
-OP(op,0e) { _C = ARG(); 											} /* LD   C,n		  */
-OP(op,0f) { RRCA;													} /* RRCA			  */
-
-OP(op,10) { _B--; JR_COND(_B);										} /* DJNZ o 		  */
-OP(op,11) { _DE = ARG16();											} /* LD   DE,w		  */
-OP(op,12) { WM( _DE, _A );											} /* LD   (DE),A	  */
-OP(op,13) { _DE++;													} /* INC  DE		  */
-OP(op,14) { _D = INC(_D);											} /* INC  D 		  */
-OP(op,15) { _D = DEC(_D);											} /* DEC  D 		  */
-OP(op,16) { _D = ARG(); 											} /* LD   D,n		  */
-OP(op,17) { RLA;													} /* RLA			  */
-
-OP(op,18) { JR();													} /* JR   o 		  */
-OP(op,19) { ADD16(HL,DE);											} /* ADD  HL,DE 	  */
-OP(op,1a) { _A = RM(_DE);											} /* LD   A,(DE)	  */
-OP(op,1b) { _DE--; CHECK_DE_LOOP;									} /* DEC  DE		  */
-OP(op,1c) { _E = INC(_E);											} /* INC  E 		  */
-OP(op,1d) { _E = DEC(_E);											} /* DEC  E 		  */
-OP(op,1e) { _E = ARG(); 											} /* LD   E,n		  */
-OP(op,1f) { RRA;													} /* RRA			  */
-
-OP(op,20) { JR_COND( !(_F & ZF) );									} /* JR   NZ,o		  */
-OP(op,21) { _HL = ARG16();											} /* LD   HL,w		  */
-OP(op,22) { EA = ARG16(); WM16( EA, &Z80.HL );						} /* LD   (w),HL	  */
-OP(op,23) { _HL++;													} /* INC  HL		  */
-OP(op,24) { _H = INC(_H);											} /* INC  H 		  */
-OP(op,25) { _H = DEC(_H);											} /* DEC  H 		  */
-OP(op,26) { _H = ARG(); 											} /* LD   H,n		  */
-OP(op,27) { DAA;													} /* DAA			  */
-
-OP(op,28) { JR_COND( _F & ZF ); 									} /* JR   Z,o		  */
-OP(op,29) { ADD16(HL,HL);											} /* ADD  HL,HL 	  */
-OP(op,2a) { EA = ARG16(); RM16( EA, &Z80.HL );						} /* LD   HL,(w)	  */
-OP(op,2b) { _HL--; CHECK_HL_LOOP;									} /* DEC  HL		  */
-OP(op,2c) { _L = INC(_L);											} /* INC  L 		  */
-OP(op,2d) { _L = DEC(_L);											} /* DEC  L 		  */
-OP(op,2e) { _L = ARG(); 											} /* LD   L,n		  */
-OP(op,2f) { _A ^= 0xff; _F = (_F&(SF|ZF|PF|CF))|HF|NF|(_A&(YF|XF)); } /* CPL			  */
-
-OP(op,30) { JR_COND( !(_F & CF) );									} /* JR   NC,o		  */
-OP(op,31) { _SP = ARG16();											} /* LD   SP,w		  */
-OP(op,32) { EA = ARG16(); WM( EA, _A ); 							} /* LD   (w),A 	  */
-OP(op,33) { _SP++;													} /* INC  SP		  */
-OP(op,34) { WM( _HL, INC(RM(_HL)) );								} /* INC  (HL)		  */
-OP(op,35) { WM( _HL, DEC(RM(_HL)) );								} /* DEC  (HL)		  */
-OP(op,36) { WM( _HL, ARG() );										} /* LD   (HL),n	  */
-OP(op,37) { _F = (_F & (SF|ZF|PF)) | CF | (_A & (YF|XF));			} /* SCF			  */
-
-OP(op,38) { JR_COND( _F & CF ); 									} /* JR   C,o		  */
-OP(op,39) { ADD16(HL,SP);											} /* ADD  HL,SP 	  */
-OP(op,3a) { EA = ARG16(); _A = RM( EA );							} /* LD   A,(w) 	  */
-OP(op,3b) { _SP--;													} /* DEC  SP		  */
-OP(op,3c) { _A = INC(_A);											} /* INC  A 		  */
-OP(op,3d) { _A = DEC(_A);											} /* DEC  A 		  */
-OP(op,3e) { _A = ARG(); 											} /* LD   A,n		  */
-OP(op,3f) { _F = ((_F&(SF|ZF|PF|CF))|((_F&CF)<<4)|(_A&(YF|XF)))^CF; } /* CCF			  */
-//OP(op,3f) { _F = ((_F & ~(HF|NF)) | ((_F & CF)<<4)) ^ CF; 		  } /* CCF				*/
-
-OP(op,40) { 														} /* LD   B,B		  */
-OP(op,41) { _B = _C;												} /* LD   B,C		  */
-OP(op,42) { _B = _D;												} /* LD   B,D		  */
-OP(op,43) { _B = _E;												} /* LD   B,E		  */
-OP(op,44) { _B = _H;												} /* LD   B,H		  */
-OP(op,45) { _B = _L;												} /* LD   B,L		  */
-OP(op,46) { _B = RM(_HL);											} /* LD   B,(HL)	  */
-OP(op,47) { _B = _A;												} /* LD   B,A		  */
-
-OP(op,48) { _C = _B;												} /* LD   C,B		  */
-OP(op,49) { 														} /* LD   C,C		  */
-OP(op,4a) { _C = _D;												} /* LD   C,D		  */
-OP(op,4b) { _C = _E;												} /* LD   C,E		  */
-OP(op,4c) { _C = _H;												} /* LD   C,H		  */
-OP(op,4d) { _C = _L;												} /* LD   C,L		  */
-OP(op,4e) { _C = RM(_HL);											} /* LD   C,(HL)	  */
-OP(op,4f) { _C = _A;												} /* LD   C,A		  */
-
-OP(op,50) { _D = _B;												} /* LD   D,B		  */
-OP(op,51) { _D = _C;												} /* LD   D,C		  */
-OP(op,52) { 														} /* LD   D,D		  */
-OP(op,53) { _D = _E;												} /* LD   D,E		  */
-OP(op,54) { _D = _H;												} /* LD   D,H		  */
-OP(op,55) { _D = _L;												} /* LD   D,L		  */
-OP(op,56) { _D = RM(_HL);											} /* LD   D,(HL)	  */
-OP(op,57) { _D = _A;												} /* LD   D,A		  */
-
-OP(op,58) { _E = _B;												} /* LD   E,B		  */
-OP(op,59) { _E = _C;												} /* LD   E,C		  */
-OP(op,5a) { _E = _D;												} /* LD   E,D		  */
-OP(op,5b) { 														} /* LD   E,E		  */
-OP(op,5c) { _E = _H;												} /* LD   E,H		  */
-OP(op,5d) { _E = _L;												} /* LD   E,L		  */
-OP(op,5e) { _E = RM(_HL);											} /* LD   E,(HL)	  */
-OP(op,5f) { _E = _A;												} /* LD   E,A		  */
-
-OP(op,60) { _H = _B;												} /* LD   H,B		  */
-OP(op,61) { _H = _C;												} /* LD   H,C		  */
-OP(op,62) { _H = _D;												} /* LD   H,D		  */
-OP(op,63) { _H = _E;												} /* LD   H,E		  */
-OP(op,64) { 														} /* LD   H,H		  */
-OP(op,65) { _H = _L;												} /* LD   H,L		  */
-OP(op,66) { _H = RM(_HL);											} /* LD   H,(HL)	  */
-OP(op,67) { _H = _A;												} /* LD   H,A		  */
-
-OP(op,68) { _L = _B;												} /* LD   L,B		  */
-OP(op,69) { _L = _C;												} /* LD   L,C		  */
-OP(op,6a) { _L = _D;												} /* LD   L,D		  */
-OP(op,6b) { _L = _E;												} /* LD   L,E		  */
-OP(op,6c) { _L = _H;												} /* LD   L,H		  */
-OP(op,6d) { 														} /* LD   L,L		  */
-OP(op,6e) { _L = RM(_HL);											} /* LD   L,(HL)	  */
-OP(op,6f) { _L = _A;												} /* LD   L,A		  */
-
-OP(op,70) { WM( _HL, _B );											} /* LD   (HL),B	  */
-OP(op,71) { WM( _HL, _C );											} /* LD   (HL),C	  */
-OP(op,72) { WM( _HL, _D );											} /* LD   (HL),D	  */
-OP(op,73) { WM( _HL, _E );											} /* LD   (HL),E	  */
-OP(op,74) { WM( _HL, _H );											} /* LD   (HL),H	  */
-OP(op,75) { WM( _HL, _L );											} /* LD   (HL),L	  */
-OP(op,76) { ENTER_HALT; 											} /* HALT			  */
-OP(op,77) { WM( _HL, _A );											} /* LD   (HL),A	  */
-
-OP(op,78) { _A = _B;												} /* LD   A,B		  */
-OP(op,79) { _A = _C;												} /* LD   A,C		  */
-OP(op,7a) { _A = _D;												} /* LD   A,D		  */
-OP(op,7b) { _A = _E;												} /* LD   A,E		  */
-OP(op,7c) { _A = _H;												} /* LD   A,H		  */
-OP(op,7d) { _A = _L;												} /* LD   A,L		  */
-OP(op,7e) { _A = RM(_HL);											} /* LD   A,(HL)	  */
-OP(op,7f) { 														} /* LD   A,A		  */
-
-OP(op,80) { ADD(_B);												} /* ADD  A,B		  */
-OP(op,81) { ADD(_C);												} /* ADD  A,C		  */
-OP(op,82) { ADD(_D);												} /* ADD  A,D		  */
-OP(op,83) { ADD(_E);												} /* ADD  A,E		  */
-OP(op,84) { ADD(_H);												} /* ADD  A,H		  */
-OP(op,85) { ADD(_L);												} /* ADD  A,L		  */
-OP(op,86) { ADD(RM(_HL));											} /* ADD  A,(HL)	  */
-OP(op,87) { ADD(_A);												} /* ADD  A,A		  */
-
-OP(op,88) { ADC(_B);												} /* ADC  A,B		  */
-OP(op,89) { ADC(_C);												} /* ADC  A,C		  */
-OP(op,8a) { ADC(_D);												} /* ADC  A,D		  */
-OP(op,8b) { ADC(_E);												} /* ADC  A,E		  */
-OP(op,8c) { ADC(_H);												} /* ADC  A,H		  */
-OP(op,8d) { ADC(_L);												} /* ADC  A,L		  */
-OP(op,8e) { ADC(RM(_HL));											} /* ADC  A,(HL)	  */
-OP(op,8f) { ADC(_A);												} /* ADC  A,A		  */
-
-OP(op,90) { SUB(_B);												} /* SUB  B 		  */
-OP(op,91) { SUB(_C);												} /* SUB  C 		  */
-OP(op,92) { SUB(_D);												} /* SUB  D 		  */
-OP(op,93) { SUB(_E);												} /* SUB  E 		  */
-OP(op,94) { SUB(_H);												} /* SUB  H 		  */
-OP(op,95) { SUB(_L);												} /* SUB  L 		  */
-OP(op,96) { SUB(RM(_HL));											} /* SUB  (HL)		  */
-OP(op,97) { SUB(_A);												} /* SUB  A 		  */
-
-OP(op,98) { SBC(_B);												} /* SBC  A,B		  */
-OP(op,99) { SBC(_C);												} /* SBC  A,C		  */
-OP(op,9a) { SBC(_D);												} /* SBC  A,D		  */
-OP(op,9b) { SBC(_E);												} /* SBC  A,E		  */
-OP(op,9c) { SBC(_H);												} /* SBC  A,H		  */
-OP(op,9d) { SBC(_L);												} /* SBC  A,L		  */
-OP(op,9e) { SBC(RM(_HL));											} /* SBC  A,(HL)	  */
-OP(op,9f) { SBC(_A);												} /* SBC  A,A		  */
-
-OP(op,a0) { AND(_B);												} /* AND  B 		  */
-OP(op,a1) { AND(_C);												} /* AND  C 		  */
-OP(op,a2) { AND(_D);												} /* AND  D 		  */
-OP(op,a3) { AND(_E);												} /* AND  E 		  */
-OP(op,a4) { AND(_H);												} /* AND  H 		  */
-OP(op,a5) { AND(_L);												} /* AND  L 		  */
-OP(op,a6) { AND(RM(_HL));											} /* AND  (HL)		  */
-OP(op,a7) { AND(_A);												} /* AND  A 		  */
-
-OP(op,a8) { XOR(_B);												} /* XOR  B 		  */
-OP(op,a9) { XOR(_C);												} /* XOR  C 		  */
-OP(op,aa) { XOR(_D);												} /* XOR  D 		  */
-OP(op,ab) { XOR(_E);												} /* XOR  E 		  */
-OP(op,ac) { XOR(_H);												} /* XOR  H 		  */
-OP(op,ad) { XOR(_L);												} /* XOR  L 		  */
-OP(op,ae) { XOR(RM(_HL));											} /* XOR  (HL)		  */
-OP(op,af) { XOR(_A);												} /* XOR  A 		  */
-
-OP(op,b0) { OR(_B); 												} /* OR   B 		  */
-OP(op,b1) { OR(_C); 												} /* OR   C 		  */
-OP(op,b2) { OR(_D); 												} /* OR   D 		  */
-OP(op,b3) { OR(_E); 												} /* OR   E 		  */
-OP(op,b4) { OR(_H); 												} /* OR   H 		  */
-OP(op,b5) { OR(_L); 												} /* OR   L 		  */
-OP(op,b6) { OR(RM(_HL));											} /* OR   (HL)		  */
-OP(op,b7) { OR(_A); 												} /* OR   A 		  */
-
-OP(op,b8) { CP(_B); 												} /* CP   B 		  */
-OP(op,b9) { CP(_C); 												} /* CP   C 		  */
-OP(op,ba) { CP(_D); 												} /* CP   D 		  */
-OP(op,bb) { CP(_E); 												} /* CP   E 		  */
-OP(op,bc) { CP(_H); 												} /* CP   H 		  */
-OP(op,bd) { CP(_L); 												} /* CP   L 		  */
-OP(op,be) { CP(RM(_HL));											} /* CP   (HL)		  */
-OP(op,bf) { CP(_A); 												} /* CP   A 		  */
-
-OP(op,c0) { RET( !(_F & ZF) );										} /* RET  NZ		  */
-OP(op,c1) { POP(BC);												} /* POP  BC		  */
-OP(op,c2) { JP_COND( !(_F & ZF) );									} /* JP   NZ,a		  */
-OP(op,c3) { JP; 													} /* JP   a 		  */
-OP(op,c4) { CALL( !(_F & ZF) ); 									} /* CALL NZ,a		  */
-OP(op,c5) { PUSH( BC ); 											} /* PUSH BC		  */
-OP(op,c6) { ADD(ARG()); 											} /* ADD  A,n		  */
-OP(op,c7) { RST(0x00);												} /* RST  0 		  */
-
-OP(op,c8) { RET( _F & ZF ); 										} /* RET  Z 		  */
-OP(op,c9) { RET(1); 												} /* RET			  */
-OP(op,ca) { JP_COND( _F & ZF ); 									} /* JP   Z,a		  */
-OP(op,cb) { _R++; EXEC(cb,ROP());									} /* **** CB xx 	  */
-OP(op,cc) { CALL( _F & ZF );										} /* CALL Z,a		  */
-OP(op,cd) { CALL(1);												} /* CALL a 		  */
-OP(op,ce) { ADC(ARG()); 											} /* ADC  A,n		  */
-OP(op,cf) { RST(0x08);												} /* RST  1 		  */
-
-OP(op,d0) { RET( !(_F & CF) );										} /* RET  NC		  */
-OP(op,d1) { POP(DE);												} /* POP  DE		  */
-OP(op,d2) { JP_COND( !(_F & CF) );									} /* JP   NC,a		  */
-OP(op,d3) { unsigned n = ARG() | (_A << 8); OUT( n, _A );			} /* OUT  (n),A 	  */
-OP(op,d4) { CALL( !(_F & CF) ); 									} /* CALL NC,a		  */
-OP(op,d5) { PUSH( DE ); 											} /* PUSH DE		  */
-OP(op,d6) { SUB(ARG()); 											} /* SUB  n 		  */
-OP(op,d7) { RST(0x10);												} /* RST  2 		  */
-
-OP(op,d8) { RET( _F & CF ); 										} /* RET  C 		  */
-OP(op,d9) { EXX;													} /* EXX			  */
-OP(op,da) { JP_COND( _F & CF ); 									} /* JP   C,a		  */
-OP(op,db) { unsigned n = ARG() | (_A << 8); _A = IN( n );			} /* IN   A,(n) 	  */
-OP(op,dc) { CALL( _F & CF );										} /* CALL C,a		  */
-OP(op,dd) { _R++; EXEC(dd,ROP());									} /* **** DD xx 	  */
-OP(op,de) { SBC(ARG()); 											} /* SBC  A,n		  */
-OP(op,df) { RST(0x18);												} /* RST  3 		  */
-
-OP(op,e0) { RET( !(_F & PF) );										} /* RET  PO		  */
-OP(op,e1) { POP(HL);												} /* POP  HL		  */
-OP(op,e2) { JP_COND( !(_F & PF) );									} /* JP   PO,a		  */
-OP(op,e3) { EXSP(HL);												} /* EX   HL,(SP)	  */
-OP(op,e4) { CALL( !(_F & PF) ); 									} /* CALL PO,a		  */
-OP(op,e5) { PUSH( HL ); 											} /* PUSH HL		  */
-OP(op,e6) { AND(ARG()); 											} /* AND  n 		  */
-OP(op,e7) { RST(0x20);												} /* RST  4 		  */
-
-OP(op,e8) { RET( _F & PF ); 										} /* RET  PE		  */
-OP(op,e9) { _PC = _HL;                                              } /* JP   (HL)        */
-OP(op,ea) { JP_COND( _F & PF ); 									} /* JP   PE,a		  */
-OP(op,eb) { EX_DE_HL;												} /* EX   DE,HL 	  */
-OP(op,ec) { CALL( _F & PF );										} /* CALL PE,a		  */
-OP(op,ed) { _R++; EXEC(ed,ROP());									} /* **** ED xx 	  */
-OP(op,ee) { XOR(ARG()); 											} /* XOR  n 		  */
-OP(op,ef) { RST(0x28);												} /* RST  5 		  */
-
-OP(op,f0) { RET( !(_F & SF) );										} /* RET  P 		  */
-OP(op,f1) { POP(AF);												} /* POP  AF		  */
-OP(op,f2) { JP_COND( !(_F & SF) );									} /* JP   P,a		  */
-OP(op,f3) { _IFF1 = _IFF2 = 0;										} /* DI 			  */
-OP(op,f4) { CALL( !(_F & SF) ); 									} /* CALL P,a		  */
-OP(op,f5) { PUSH( AF ); 											} /* PUSH AF		  */
-OP(op,f6) { OR(ARG());												} /* OR   n 		  */
-OP(op,f7) { RST(0x30);												} /* RST  6 		  */
-
-OP(op,f8) { RET(_F & SF);											} /* RET  M 		  */
-OP(op,f9) { _SP = _HL;												} /* LD   SP,HL 	  */
-OP(op,fa) { JP_COND(_F & SF);										} /* JP   M,a		  */
-OP(op,fb) { EI; 													} /* EI 			  */
-OP(op,fc) { CALL(_F & SF);											} /* CALL M,a		  */
-OP(op,fd) { _R++; EXEC(fd,ROP());									} /* **** FD xx 	  */
-OP(op,fe) { CP(ARG());												} /* CP   n 		  */
-OP(op,ff) { RST(0x38);												} /* RST  7 		  */
+#include "z80ops.h"
 
 
 static void take_interrupt(void)
@@ -4146,6 +2402,7 @@ void z80_exit(void)
 #endif
 }
 
+#if !Z80_JUMPTABLE
 /****************************************************************************
  * Execute 'cycles' T-states. Return number of T-states really executed
  ****************************************************************************/
@@ -4166,6 +2423,7 @@ int z80_execute(int cycles)
 
     return cycles - z80_ICount;
 }
+#endif /* !Z80_JUMPTABLE */
 
 /****************************************************************************
  * Burn 'cycles' T-states. Adjust R register for the lost time
@@ -4390,3 +2648,300 @@ void z80_set_irq_callback(int (*callback)(int))
 {
     Z80.irq_callback = callback;
 }
+
+#if Z80_JUMPTABLE
+/****************************************************************************
+ * Threaded core. The opcode bodies from z80ops.h are included a second
+ * time as labels inside z80_execute, and every opcode jumps straight to
+ * the next through a table of label addresses. PC, SP, AF, BC, DE, HL, R
+ * and the T-state count live in locals for the whole timeslice; they are
+ * written back to Z80 and z80_ICount on exit and around the calls that
+ * can see them: I/O ports (the VDP reads and trims z80_ICount), RETI
+ * callbacks, taking an interrupt and the EI look-ahead.
+ ****************************************************************************/
+static int * const jt_icount = &z80_ICount;
+
+#undef	_PPC
+#undef	_PCD
+#undef	_PC
+#undef	_SPD
+#undef	_SP
+#undef	_AFD
+#undef	_AF
+#undef	_A
+#undef	_F
+#undef	_BCD
+#undef	_BC
+#undef	_B
+#undef	_C
+#undef	_DED
+#undef	_DE
+#undef	_D
+#undef	_E
+#undef	_HLD
+#undef	_HL
+#undef	_H
+#undef	_L
+#undef	_R
+#undef	REG16
+
+#define _PPC	jt_PPC
+#define _PCD	jt_PC.d
+#define _PC 	jt_PC.w.l
+#define _SPD	jt_SP.d
+#define _SP 	jt_SP.w.l
+#define _AFD	jt_AF.d
+#define _AF 	jt_AF.w.l
+#define _A		jt_AF.b.h
+#define _F		jt_AF.b.l
+#define _BCD	jt_BC.d
+#define _BC 	jt_BC.w.l
+#define _B		jt_BC.b.h
+#define _C		jt_BC.b.l
+#define _DED	jt_DE.d
+#define _DE 	jt_DE.w.l
+#define _D		jt_DE.b.h
+#define _E		jt_DE.b.l
+#define _HLD	jt_HL.d
+#define _HL 	jt_HL.w.l
+#define _H		jt_HL.b.h
+#define _L		jt_HL.b.l
+#define _R		jt_R
+#define REG16(r)	jt_##r
+#define jt_IX	Z80.IX			/* index registers stay in the context */
+#define jt_IY	Z80.IY
+#define z80_ICount	jt_ICount
+
+/* copy the locals back to the context and the context to the locals */
+#define JT_SAVE {												\
+	Z80.PREPC.d = jt_PPC;										\
+	Z80.PC = jt_PC; Z80.SP = jt_SP;								\
+	Z80.AF = jt_AF; Z80.BC = jt_BC; Z80.DE = jt_DE; Z80.HL = jt_HL; \
+	Z80.R = jt_R;												\
+	*jt_icount = jt_ICount; 									\
+}
+#define JT_LOAD {												\
+	jt_PPC = Z80.PREPC.d;										\
+	jt_PC = Z80.PC; jt_SP = Z80.SP; 							\
+	jt_AF = Z80.AF; jt_BC = Z80.BC; jt_DE = Z80.DE; jt_HL = Z80.HL; \
+	jt_R = Z80.R;												\
+	jt_ICount = *jt_icount; 									\
+}
+
+/* the inline helpers above work on the context, redo them on the locals */
+#undef	ROP
+#undef	ARG
+#undef	ARG16
+#define ROP()	({ unsigned pc_ = _PCD; _PC++; (UINT8)cpu_readop(pc_); })
+#define ARG()	({ unsigned pc_ = _PCD; _PC++; (UINT8)cpu_readop_arg(pc_); })
+#define ARG16() ({ unsigned pc_ = _PCD; _PC += 2;					\
+	(UINT32)(cpu_readop_arg(pc_) | (cpu_readop_arg((pc_+1)&0xffff) << 8)); })
+
+#define INC(value) ({ UINT8 res_ = (UINT8)(value) + 1;				\
+	_F = (_F & CF) | SZHV_inc[res_]; res_; })
+#define DEC(value) ({ UINT8 res_ = (UINT8)(value) - 1;				\
+	_F = (_F & CF) | SZHV_dec[res_]; res_; })
+
+#define JT_SHIFT(value,carry,result) ({ 							\
+	unsigned res_ = (UINT8)(value); 							\
+	unsigned c_ = carry;										\
+	res_ = (result) & 0xff; 									\
+	_F = SZP[res_] | c_;										\
+	(UINT8)res_; })
+#define RLC(value)	JT_SHIFT(value, (res_ & 0x80) ? CF : 0, (res_ << 1) | (res_ >> 7))
+#define RRC(value)	JT_SHIFT(value, (res_ & 0x01) ? CF : 0, (res_ >> 1) | (res_ << 7))
+#define RL(value)	JT_SHIFT(value, (res_ & 0x80) ? CF : 0, (res_ << 1) | (_F & CF))
+#define RR(value)	JT_SHIFT(value, (res_ & 0x01) ? CF : 0, (res_ >> 1) | (_F << 7))
+#define SLA(value)	JT_SHIFT(value, (res_ & 0x80) ? CF : 0, res_ << 1)
+#define SRA(value)	JT_SHIFT(value, (res_ & 0x01) ? CF : 0, (res_ >> 1) | (res_ & 0x80))
+#define SLL(value)	JT_SHIFT(value, (res_ & 0x80) ? CF : 0, (res_ << 1) | 0x01)
+#define SRL(value)	JT_SHIFT(value, (res_ & 0x01) ? CF : 0, res_ >> 1)
+
+#define BURNODD(cycles,opcodes,cyclesum) {							\
+	int c_ = cycles;											\
+	if( c_ > 0 )												\
+	{															\
+		_R += (c_ / (cyclesum)) * (opcodes);					\
+		z80_ICount -= (c_ / (cyclesum)) * (cyclesum);			\
+	}															\
+}
+#define z80_burn(cycles) {										\
+	int c_ = cycles;											\
+	if( c_ > 0 )												\
+	{															\
+		int n_ = (c_ + 3) / 4;									\
+		_R += n_;												\
+		z80_ICount -= 4 * n_;									\
+	}															\
+}
+#define illegal_1() _PC--
+#define illegal_2()
+
+/* calls out of the core see and may change the context */
+#undef	IN
+#undef	OUT
+#define IN(port) ({ unsigned port_ = (port); UINT8 io_; 			\
+	JT_SAVE; io_ = (UINT8)cpu_readport(port_); JT_LOAD; io_; })
+#define OUT(port,value) {											\
+	unsigned port_ = (port), value_ = (value);					\
+	JT_SAVE; cpu_writeport(port_,value_); JT_LOAD;				\
+}
+#define take_interrupt() { JT_SAVE; take_interrupt(); JT_LOAD; }
+
+#undef	RETI
+#define RETI	{												\
+	int device = Z80.service_irq;								\
+    RET(1);                                                     \
+	if( device >= 0 )											\
+	{															\
+		JT_SAVE;												\
+		Z80.irq[device].interrupt_reti(Z80.irq[device].irq_param); \
+		JT_LOAD;												\
+	}															\
+}
+
+/* with an interrupt pending the stock EI runs one more opcode and takes it */
+#undef	EI
+#define EI {													\
+	if( _IFF1 == 0 )											\
+	{															\
+		if( Z80.irq_state != CLEAR_LINE ||						\
+			Z80.request_irq >= 0 )								\
+		{														\
+			JT_SAVE;											\
+			op_fb();											\
+			JT_LOAD;											\
+		}														\
+		else													\
+		{														\
+			_IFF1 = _IFF2 = 1;									\
+			_PPC = _PCD;										\
+			_R++;												\
+			EXEC(op,ROP()); 									\
+		}														\
+	} else _IFF2 = 1;											\
+}
+
+/* opcodes end by jumping to the next one, not by returning */
+#undef	EXEC
+#define EXEC(prefix,opcode) {										\
+	unsigned op_ = opcode;										\
+	CY(cc_##prefix[op_]);										\
+	goto *jt_##prefix[op_]; 									\
+}
+#define JT_NEXT 												\
+	if( z80_ICount <= 0 ) goto jt_out;							\
+	_PPC = _PCD;												\
+	_R++;														\
+	EXEC(op,ROP());
+#undef	OP
+#define OP(prefix,opcode) JT_NEXT prefix##_##opcode:
+
+#define JT_TABLE(prefix) {								\
+	&&prefix##_00, &&prefix##_01, &&prefix##_02, &&prefix##_03, \
+	&&prefix##_04, &&prefix##_05, &&prefix##_06, &&prefix##_07, \
+	&&prefix##_08, &&prefix##_09, &&prefix##_0a, &&prefix##_0b, \
+	&&prefix##_0c, &&prefix##_0d, &&prefix##_0e, &&prefix##_0f, \
+	&&prefix##_10, &&prefix##_11, &&prefix##_12, &&prefix##_13, \
+	&&prefix##_14, &&prefix##_15, &&prefix##_16, &&prefix##_17, \
+	&&prefix##_18, &&prefix##_19, &&prefix##_1a, &&prefix##_1b, \
+	&&prefix##_1c, &&prefix##_1d, &&prefix##_1e, &&prefix##_1f, \
+	&&prefix##_20, &&prefix##_21, &&prefix##_22, &&prefix##_23, \
+	&&prefix##_24, &&prefix##_25, &&prefix##_26, &&prefix##_27, \
+	&&prefix##_28, &&prefix##_29, &&prefix##_2a, &&prefix##_2b, \
+	&&prefix##_2c, &&prefix##_2d, &&prefix##_2e, &&prefix##_2f, \
+	&&prefix##_30, &&prefix##_31, &&prefix##_32, &&prefix##_33, \
+	&&prefix##_34, &&prefix##_35, &&prefix##_36, &&prefix##_37, \
+	&&prefix##_38, &&prefix##_39, &&prefix##_3a, &&prefix##_3b, \
+	&&prefix##_3c, &&prefix##_3d, &&prefix##_3e, &&prefix##_3f, \
+	&&prefix##_40, &&prefix##_41, &&prefix##_42, &&prefix##_43, \
+	&&prefix##_44, &&prefix##_45, &&prefix##_46, &&prefix##_47, \
+	&&prefix##_48, &&prefix##_49, &&prefix##_4a, &&prefix##_4b, \
+	&&prefix##_4c, &&prefix##_4d, &&prefix##_4e, &&prefix##_4f, \
+	&&prefix##_50, &&prefix##_51, &&prefix##_52, &&prefix##_53, \
+	&&prefix##_54, &&prefix##_55, &&prefix##_56, &&prefix##_57, \
+	&&prefix##_58, &&prefix##_59, &&prefix##_5a, &&prefix##_5b, \
+	&&prefix##_5c, &&prefix##_5d, &&prefix##_5e, &&prefix##_5f, \
+	&&prefix##_60, &&prefix##_61, &&prefix##_62, &&prefix##_63, \
+	&&prefix##_64, &&prefix##_65, &&prefix##_66, &&prefix##_67, \
+	&&prefix##_68, &&prefix##_69, &&prefix##_6a, &&prefix##_6b, \
+	&&prefix##_6c, &&prefix##_6d, &&prefix##_6e, &&prefix##_6f, \
+	&&prefix##_70, &&prefix##_71, &&prefix##_72, &&prefix##_73, \
+	&&prefix##_74, &&prefix##_75, &&prefix##_76, &&prefix##_77, \
+	&&prefix##_78, &&prefix##_79, &&prefix##_7a, &&prefix##_7b, \
+	&&prefix##_7c, &&prefix##_7d, &&prefix##_7e, &&prefix##_7f, \
+	&&prefix##_80, &&prefix##_81, &&prefix##_82, &&prefix##_83, \
+	&&prefix##_84, &&prefix##_85, &&prefix##_86, &&prefix##_87, \
+	&&prefix##_88, &&prefix##_89, &&prefix##_8a, &&prefix##_8b, \
+	&&prefix##_8c, &&prefix##_8d, &&prefix##_8e, &&prefix##_8f, \
+	&&prefix##_90, &&prefix##_91, &&prefix##_92, &&prefix##_93, \
+	&&prefix##_94, &&prefix##_95, &&prefix##_96, &&prefix##_97, \
+	&&prefix##_98, &&prefix##_99, &&prefix##_9a, &&prefix##_9b, \
+	&&prefix##_9c, &&prefix##_9d, &&prefix##_9e, &&prefix##_9f, \
+	&&prefix##_a0, &&prefix##_a1, &&prefix##_a2, &&prefix##_a3, \
+	&&prefix##_a4, &&prefix##_a5, &&prefix##_a6, &&prefix##_a7, \
+	&&prefix##_a8, &&prefix##_a9, &&prefix##_aa, &&prefix##_ab, \
+	&&prefix##_ac, &&prefix##_ad, &&prefix##_ae, &&prefix##_af, \
+	&&prefix##_b0, &&prefix##_b1, &&prefix##_b2, &&prefix##_b3, \
+	&&prefix##_b4, &&prefix##_b5, &&prefix##_b6, &&prefix##_b7, \
+	&&prefix##_b8, &&prefix##_b9, &&prefix##_ba, &&prefix##_bb, \
+	&&prefix##_bc, &&prefix##_bd, &&prefix##_be, &&prefix##_bf, \
+	&&prefix##_c0, &&prefix##_c1, &&prefix##_c2, &&prefix##_c3, \
+	&&prefix##_c4, &&prefix##_c5, &&prefix##_c6, &&prefix##_c7, \
+	&&prefix##_c8, &&prefix##_c9, &&prefix##_ca, &&prefix##_cb, \
+	&&prefix##_cc, &&prefix##_cd, &&prefix##_ce, &&prefix##_cf, \
+	&&prefix##_d0, &&prefix##_d1, &&prefix##_d2, &&prefix##_d3, \
+	&&prefix##_d4, &&prefix##_d5, &&prefix##_d6, &&prefix##_d7, \
+	&&prefix##_d8, &&prefix##_d9, &&prefix##_da, &&prefix##_db, \
+	&&prefix##_dc, &&prefix##_dd, &&prefix##_de, &&prefix##_df, \
+	&&prefix##_e0, &&prefix##_e1, &&prefix##_e2, &&prefix##_e3, \
+	&&prefix##_e4, &&prefix##_e5, &&prefix##_e6, &&prefix##_e7, \
+	&&prefix##_e8, &&prefix##_e9, &&prefix##_ea, &&prefix##_eb, \
+	&&prefix##_ec, &&prefix##_ed, &&prefix##_ee, &&prefix##_ef, \
+	&&prefix##_f0, &&prefix##_f1, &&prefix##_f2, &&prefix##_f3, \
+	&&prefix##_f4, &&prefix##_f5, &&prefix##_f6, &&prefix##_f7, \
+	&&prefix##_f8, &&prefix##_f9, &&prefix##_fa, &&prefix##_fb, \
+	&&prefix##_fc, &&prefix##_fd, &&prefix##_fe, &&prefix##_ff  \
+}
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-label"
+
+/****************************************************************************
+ * Execute 'cycles' T-states. Return number of T-states really executed
+ ****************************************************************************/
+int z80_execute(int cycles)
+{
+	static const void * const jt_op[0x100] = JT_TABLE(op);
+	static const void * const jt_cb[0x100] = JT_TABLE(cb);
+	static const void * const jt_dd[0x100] = JT_TABLE(dd);
+	static const void * const jt_ed[0x100] = JT_TABLE(ed);
+	static const void * const jt_fd[0x100] = JT_TABLE(fd);
+	static const void * const jt_xxcb[0x100] = JT_TABLE(xxcb);
+	UINT32 jt_PPC;
+	PAIR jt_PC, jt_SP, jt_AF, jt_BC, jt_DE, jt_HL;
+	unsigned jt_R;
+	int jt_ICount;
+
+	*jt_icount = cycles - Z80.extra_cycles;
+	Z80.extra_cycles = 0;
+	JT_LOAD;
+
+	/* always run at least one opcode, like the do-while of the stock core */
+	_PPC = _PCD;
+	_R++;
+	EXEC(op,ROP());
+
+#include "z80ops.h"
+
+	JT_NEXT
+jt_out:
+	z80_ICount -= Z80.extra_cycles;
+	Z80.extra_cycles = 0;
+	JT_SAVE;
+
+	return cycles - z80_ICount;
+}
+
+#pragma GCC diagnostic pop
+#endif /* Z80_JUMPTABLE */
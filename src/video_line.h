@@ -0,0 +1,47 @@
+/* Copyright (c) 2020, Peter Barrett
+**
+** Permission to use, copy, modify, and/or distribute this software for
+** any purpose with or without fee is hereby granted, provided that the
+** above copyright notice and this permission notice appear in all copies.
+**
+** THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+** WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+** WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR
+** BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES
+** OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+** WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+** ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+** SOFTWARE.
+*/
+
+#ifndef video_line_h
+#define video_line_h
+
+// Scanline handoff from the cores to the video ISR, enabled with LINE_QUEUE in config.h
+// Cores call VIDEO_LINE with the display row (0-239) and its pixels once a line is finished,
+// the ISR shows it in the field being scanned out if it gets there after the core did.
+
+// config.h turns on O2 for whoever includes it, leave the cores as they were
+#pragma GCC push_options
+#include "../config.h"
+#pragma GCC pop_options
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void video_line(int y, uint8_t* line);
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef LINE_QUEUE
+#define VIDEO_LINE(_y,_line)    video_line(_y,_line)
+#else
+#define VIDEO_LINE(_y,_line)    ((void)0)
+#endif
+
+#endif /* video_line_h */
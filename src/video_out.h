@@ -233,6 +233,14 @@ void* MALLOC32(int x, const char* label)
     return r;
 }
 
+extern "C"
+void* MALLOC32_TRY(int x, const char* label)
+{
+    void * r = heap_caps_malloc(x,MALLOC_CAP_32BIT);
+    printf("MALLOC32_TRY allocation of %s:%d %08X\n",label,x,r);
+    return r;
+}
+
 #else	//ESP_PLATFORM
 //====================================================================================================
 //  Simulator
@@ -290,20 +298,7 @@ int get_hid_ir(uint8_t* buf)
 #define PAL_FREQUENCY 4433618.75
 #define PAL_LINES 312
 
-#ifdef PERF
-#define BEGIN_TIMING()  uint32_t t = cpu_ticks()
-#define END_TIMING() t = cpu_ticks() - t; _blit_ticks_min = min(_blit_ticks_min,t); _blit_ticks_max = max(_blit_ticks_max,t);
-#define ISR_BEGIN() uint32_t t = cpu_ticks()
-#define ISR_END() t = cpu_ticks() - t;_isr_us += (t+120)/240;
-uint32_t _blit_ticks_min = 0;
-uint32_t _blit_ticks_max = 0;
-uint32_t _isr_us = 0;
-#else
-#define BEGIN_TIMING()
-#define END_TIMING()
-#define ISR_BEGIN()
-#define ISR_END()
-#endif
+#include "profile.h"   // PERF zones, blit and isr time are charged from core 1
 
 uint8_t** _lines; // filled in by emulator
 volatile int _line_counter = 0;
@@ -402,10 +397,219 @@ void IRAM_ATTR test_wave(volatile void* vbuf, int t = 1)
     }
 }*/
 
+//====================================================================================================
+// Front/back frame handoff
+//====================================================================================================
+// The emulator draws into a back buffer and hands it over with video_present. The ISR flips it to
+// the front on the first line of vertical blanking so a frame is never shown half drawn, video_sync
+// blocks the emulator until that flip so it can start on the next frame right away.
+
+uint8_t** volatile _next_lines = 0;     // presented, waiting for vblank
+#ifdef ESP_PLATFORM
+TaskHandle_t _sync_task = 0;
+#endif
+
+void video_present(uint8_t** lines)
+{
+    if (!_lines)
+        _lines = lines;                 // video not running yet
+    else
+        _next_lines = lines;
+}
+
+inline void IRAM_ATTR video_flip()
+{
+    if (!_next_lines)
+        return;                         // emulator is late, show the last frame again
+    _lines = _next_lines;
+    _next_lines = 0;
+#ifdef ESP_PLATFORM
+    if (_sync_task) {
+        BaseType_t woken = pdFALSE;
+        vTaskNotifyGiveFromISR(_sync_task,&woken);
+        if (woken)
+            portYIELD_FROM_ISR();
+    }
+#endif
+}
+
+#ifdef ESP_PLATFORM
+// Wait until the last presented frame is on the front, the buffer it replaced is then free to draw
+void video_sync()
+{
+    _sync_task = xTaskGetCurrentTaskHandle();
+    while (_next_lines)
+        ulTaskNotifyTake(pdTRUE,2);     // timeout in case the isr has stopped
+}
+#endif
+
+//====================================================================================================
+// Scanline handoff
+//====================================================================================================
+// With LINE_QUEUE the cores publish each line as it is finished (see video_line.h). Lines of the
+// frame being emulated are shown as soon as they are ready, lines the core has not reached yet come
+// from the last complete frame. An emulator that stays ahead of the beam is seen in the same field
+// it was drawn in, a frame earlier than with video_present alone.
+
+#ifdef LINE_QUEUE
+uint8_t* volatile _queue[240];
+volatile uint32_t _queue_tag[240];      // emulated frame the line belongs to
+volatile uint32_t _queue_frame = 1;
+bool _queue_on = true;
+
+extern "C"
+void video_line(int y, uint8_t* line)
+{
+    if (!_queue_on || (unsigned)y >= 240)
+        return;
+    _queue[y] = line;
+    _queue_tag[y] = _queue_frame;
+}
+
+// start of an emulated frame, off if something will draw over the lines once the core is done
+void video_queue(bool on)
+{
+    _queue_frame++;
+    _queue_on = on;
+}
+
+inline uint8_t* IRAM_ATTR video_src(int i)
+{
+    return _queue_tag[i] == _queue_frame ? _queue[i] : _lines[i];
+}
+#else
+extern "C"
+void video_line(int y, uint8_t* line)
+{
+}
+
+void video_queue(bool on)
+{
+}
+
+#define video_src(_i) _lines[_i]
+#endif
+
+//====================================================================================================
+// Dirty lines
+//====================================================================================================
+// A core can register an id per line of its frame buffers (0 is unknown). Lines with the same id must hold
+// exactly the same pixels, a hash is not enough: a collision would leave a stale line on screen. The active
+// part of a DMA buffer is only touched by blit, so when the line going out has the same id as the last line
+// blitted into that buffer (solid backgrounds, borders) the blit is skipped.
+// Anything drawing over the frame buffers behind the core's back (the GUI overlay) calls video_dirty.
+
+void blit(uint8_t* src, uint16_t* dst);
+
+uint8_t** _hash_lines[2];
+uint32_t* _hash_table[2];
+void* _dma_key[2];
+uint32_t _dma_hash[2];
+
+void video_hashes(int i, uint8_t** lines, uint32_t* hashes)
+{
+    _hash_lines[i] = lines;
+    _hash_table[i] = hashes;
+    _dma_key[0] = _dma_key[1] = 0;
+}
+
+void video_dirty()
+{
+    for (int i = 0; i < 2; i++)
+        if (_hash_table[i])
+            memset(_hash_table[i],0,240*sizeof(uint32_t));
+}
+
+inline uint32_t IRAM_ATTR line_hash(const uint8_t* src, int i)
+{
+    for (int k = 0; k < 2; k++)
+        if (_hash_lines[k] && _hash_lines[k][i] == src)
+            return _hash_table[k][i];
+    return 0;
+}
+
+// hash of what blit last put in this dma buffer
+inline uint32_t& IRAM_ATTR dma_hash(volatile void* buf)
+{
+    if (_dma_key[0] == buf)
+        return _dma_hash[0];
+    int k = _dma_key[0] ? 1 : 0;
+    if (_dma_key[k] != buf) {
+        _dma_key[k] = (void*)buf;
+        _dma_hash[k] = 0;
+    }
+    return _dma_hash[k];
+}
+
+// blit unless the dma buffer already holds this line
+inline void IRAM_ATTR blit_line(uint8_t* src, int i, uint16_t* buf, uint32_t salt)
+{
+    uint32_t h = line_hash(src,i);
+    if (h)
+        h ^= salt;
+    uint32_t& last = dma_hash(buf);
+    if (!h || h != last) {
+        PROF_BEGIN(tb);
+        blit(src,buf + _active_start);
+        PROF_END(PROF_BLIT,tb);
+    }
+    last = h;
+}
+
 #if VIDEO_STANDARD > 0
 //=====================================================================================
 //NTSC VIDEO
 //=====================================================================================
+
+// NES and SMS put 4 pixels into 3 color clocks, 12 samples or 6 32 bit words of the dma line.
+// Every pixel lands in one whole word and half of the next/previous one, so the halves are
+// precomputed from the palette: 8 lookups and 6 word stores instead of 12 shifted 16 bit stores.
+// 6 tables of 256 (NES indexes are masked when the table is built), 6k
+enum {
+    EX_W01,     // P1 | P0 << 16
+    EX_W23,     // P3 | P2 << 16
+    EX_H0,      // P0 << 16
+    EX_L1,      // P1
+    EX_H2,      // P2 << 16
+    EX_L3,      // P3
+    EX_TABLES
+};
+uint32_t* _expand = 0;
+bool _expand_on = true;         // bench can turn it off to compare
+
+void make_expand_tables()
+{
+    _expand_on = _machine == EMU_NES || _machine == EMU_SMS;
+    if (!_expand_on)
+        return;
+    if (!_expand) {
+#ifdef ESP_PLATFORM
+        // read by the isr every line, keep it out of PSRAM
+        _expand = (uint32_t*)heap_caps_malloc(EX_TABLES*256*sizeof(uint32_t),MALLOC_CAP_INTERNAL|MALLOC_CAP_32BIT);
+#else
+        _expand = new uint32_t[EX_TABLES*256];
+#endif
+        if (!_expand) {
+            _expand_on = false;     // fall back to the per pixel path
+            return;
+        }
+    }
+    uint32_t mask = _machine == EMU_NES ? 0x3F : 0xFF;
+    for (int i = 0; i < 256; i++) {
+        uint32_t color = _palette[i & mask];
+        uint32_t p0 = (uint16_t)P0;
+        uint32_t p1 = (uint16_t)P1;
+        uint32_t p2 = (uint16_t)P2;
+        uint32_t p3 = (uint16_t)P3;
+        _expand[EX_W01*256 + i] = p1 | (p0 << 16);
+        _expand[EX_W23*256 + i] = p3 | (p2 << 16);
+        _expand[EX_H0*256 + i] = p0 << 16;
+        _expand[EX_L1*256 + i] = p1;
+        _expand[EX_H2*256 + i] = p2 << 16;
+        _expand[EX_L3*256 + i] = p3;
+    }
+}
+
 void video_init(int samples_per_cc, int machine, const uint32_t* palette, int ntsc)
 {
     _samples_per_cc = samples_per_cc;
@@ -419,6 +623,7 @@ void video_init(int samples_per_cc, int machine, const uint32_t* palette, int nt
     _active_start = usec(samples_per_cc == 4 ? 10 : 10.5);
     _hsync = usec(4.7);
     _active_lines = 240;
+    make_expand_tables();
     video_init_hw(_line_width,_samples_per_cc);    // init the hardware
 }
 
@@ -431,8 +636,6 @@ void IRAM_ATTR blit(uint8_t* src, uint16_t* dst)
     uint32_t mask = 0xFF;
     int i;
 
-    BEGIN_TIMING();
-
     switch (_machine) {
         case EMU_ATARI:
             // 2 pixels per color clock, 4 samples per cc, used by atari
@@ -482,6 +685,29 @@ void IRAM_ATTR blit(uint8_t* src, uint16_t* dst)
             // AAA ABB BBC CCC
             // 4 pixels, 3 color clocks, 4 samples per cc
             // each pixel gets 3 samples, 192 color clocks wide
+            if (_expand_on) {
+                const uint32_t* w01 = _expand + EX_W01*256;
+                const uint32_t* w23 = _expand + EX_W23*256;
+                const uint32_t* h0 = _expand + EX_H0*256;
+                const uint32_t* l1 = _expand + EX_L1*256;
+                const uint32_t* h2 = _expand + EX_H2*256;
+                const uint32_t* l3 = _expand + EX_L3*256;
+                for (i = 0; i < 256; i += 4) {
+                    c = *((uint32_t*)(src+i));
+                    uint8_t a = c;
+                    uint8_t b = c >> 8;
+                    uint8_t e = c >> 16;
+                    uint8_t f = c >> 24;
+                    d[0] = w01[a];
+                    d[1] = h2[a] | l3[b];
+                    d[2] = w01[b];
+                    d[3] = w23[e];
+                    d[4] = h0[e] | l1[f];
+                    d[5] = w23[f];
+                    d += 6;
+                }
+                break;
+            }
             for (i = 0; i < 256; i += 4) {
                 c = *((uint32_t*)(src+i));
                 color = p[c & mask];
@@ -505,7 +731,6 @@ void IRAM_ATTR blit(uint8_t* src, uint16_t* dst)
             break;
 
     }
-    END_TIMING();
 }
 
 void IRAM_ATTR burst(uint16_t* line)
@@ -560,20 +785,6 @@ void IRAM_ATTR blanking(uint16_t* line, bool vbl)
         burst(line);    // no burst during vbl
 }
 
-// Wait for blanking before starting drawing
-// avoids tearing in our unsynchonized world
-#ifdef ESP_PLATFORM
-void video_sync()
-{
-  if (!_lines)
-    return;
-  int n = 0;
-  if (_line_counter < _active_lines)
-    n = (_active_lines - _line_counter)*1000/15720;
-  vTaskDelay(n+1);
-}
-#endif
-
 // Workhorse ISR handles audio and video updates
 extern "C"
 void IRAM_ATTR video_isr(volatile void* vbuf)
@@ -581,7 +792,7 @@ void IRAM_ATTR video_isr(volatile void* vbuf)
     if (!_lines)
         return;
 
-    ISR_BEGIN();
+    PROF_BEGIN(t);
 
     uint8_t s = _audio_r < _audio_w ? _audio_buffer[_audio_r++ & (sizeof(_audio_buffer)-1)] : 0x20;
     audio_sample(s);
@@ -596,16 +807,21 @@ void IRAM_ATTR video_isr(volatile void* vbuf)
     if (i < _active_lines) {                // active video
         sync(buf,_hsync);
         burst(buf);
-        blit(_lines[i],buf + _active_start);
+        blit_line(video_src(i),i,buf,0);
 
     } else if (i < (_active_lines + 5)) {   // post render/black
+        if (i == _active_lines)
+            video_flip();
         blanking(buf,false);
+        dma_hash(buf) = 0;
 
     } else if (i < (_active_lines + 8)) {   // vsync
         blanking(buf,true);
+        dma_hash(buf) = 0;
 
     } else {                                // pre render/black
         blanking(buf,false);
+        dma_hash(buf) = 0;
     }
 
     if (_line_counter == _line_count) {
@@ -613,7 +829,7 @@ void IRAM_ATTR video_isr(volatile void* vbuf)
         _frame_counter++;
     }
 
-    ISR_END();
+    PROF_END(PROF_ISR,t);
 }
 
 #else
@@ -822,20 +1038,6 @@ void IRAM_ATTR vsync(uint16_t* line, int i)
     vsync2(line+_line_width/2,_line_width/2, t & 1);
 }
 
-// Wait for blanking before starting drawing
-// avoids tearing in our unsynchonized world
-#ifdef ESP_PLATFORM
-void video_sync()
-{
-  if (!_lines)
-    return;
-  int n = 0;
-  if (_line_counter < _active_lines)
-    n = (_active_lines - _line_counter)*1000/15600;
-  vTaskDelay(n+1);
-}
-#endif
-
 // Workhorse ISR handles audio and video updates
 extern "C"
 void IRAM_ATTR video_isr(volatile void* vbuf)
@@ -843,7 +1045,7 @@ void IRAM_ATTR video_isr(volatile void* vbuf)
     if (!_lines)
         return;
 
-    ISR_BEGIN();
+    PROF_BEGIN(t);
 
     uint8_t s = _audio_r < _audio_w ? _audio_buffer[_audio_r++ & (sizeof(_audio_buffer)-1)] : 0x20;
     audio_sample(s);
@@ -857,14 +1059,19 @@ void IRAM_ATTR video_isr(volatile void* vbuf)
     uint16_t* buf = (uint16_t*)vbuf;
     if (i < 32) {
         blanking(buf,false);                // pre render/black 0-32
+        dma_hash(buf) = 0;
     } else if (i < _active_lines + 32) {    // active video 32-272
         sync(buf,_hsync);
         burst(buf);
-        blit(_lines[i-32],buf + _active_start);
+        blit_line(video_src(i-32),i-32,buf,(i & 1) << 1);    // even and odd lines use different palettes
     } else if (i < 304) {                   // post render/black 272-304
+        if (i == _active_lines + 32)
+            video_flip();
         blanking(buf,false);
+        dma_hash(buf) = 0;
     } else {
         vsync(buf,i);                    // 8 lines of sync 304-312
+        dma_hash(buf) = 0;
     }
 
     if (_line_counter == _line_count) {
@@ -872,6 +1079,6 @@ void IRAM_ATTR video_isr(volatile void* vbuf)
         _frame_counter++;
     }
 
-    ISR_END();
+    PROF_END(PROF_ISR,t);
 }
 #endif
\ No newline at end of file